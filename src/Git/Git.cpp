@@ -26,9 +26,13 @@
 #include "gitdll.h"
 #include <fstream>
 #include <iterator>
+#include <queue>
+#include <unordered_map>
 #include "FormatMessageWrapper.h"
 #include "SmartHandle.h"
 #include "MassiveGitTaskBase.h"
+#include "GitCommitIndex.h"
+#include "GitBatchHelper.h"
 #include "git2/sys/filter.h"
 #include "git2/sys/transport.h"
 #include "git2/sys/errors.h"
@@ -225,6 +229,7 @@ static int LogicalCompareBranchesPredicate(const CString &left, const CString &r
 }
 
 #define CALL_OUTPUT_READ_CHUNK_SIZE 1024
+#define COMMITINDEX_MAX_NEW_COMMITS_PER_QUERY 1000
 
 CString CGit::ms_LastMsysGitDir;
 CString CGit::ms_MsysGitRootDir;
@@ -246,6 +251,14 @@ CGit::CGit()
 
 CGit::~CGit()
 {
+	if (m_hCommitIndexThread)
+	{
+		// the build checks the flag for every commit, the commits indexed so far are stored by the thread
+		InterlockedExchange(&m_bCancelCommitIndexBuild, TRUE);
+		WaitForSingleObject(m_hCommitIndexThread, INFINITE);
+	}
+	if (m_commitIndex)
+		m_commitIndex->Save();
 	if(this->m_GitDiff)
 	{
 		git_close_diff(m_GitDiff);
@@ -268,7 +281,7 @@ bool CGit::IsBranchNameValid(const CString& branchname)
 	return valid == 1;
 }
 
-int CGit::RunAsync(CString cmd, PROCESS_INFORMATION& piOut, HANDLE* hReadOut, HANDLE* hErrReadOut, const CString* StdioFile)
+int CGit::RunAsync(CString cmd, PROCESS_INFORMATION& piOut, HANDLE* hReadOut, HANDLE* hErrReadOut, const CString* StdioFile, HANDLE* hWriteInOut)
 {
 	CAutoGeneralHandle hRead, hWrite, hReadErr, hWriteErr, hWriteIn, hReadIn;
 	CAutoFile hStdioFile;
@@ -282,6 +295,9 @@ int CGit::RunAsync(CString cmd, PROCESS_INFORMATION& piOut, HANDLE* hReadOut, HA
 		CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": could not open stdin pipe: %s\n", static_cast<LPCWSTR>(err.Trim()));
 		return TGIT_GIT_ERROR_OPEN_PIP;
 	}
+	// the child must not inherit the write end, otherwise it never sees the end of its input
+	if (hWriteInOut)
+		SetHandleInformation(hWriteIn, HANDLE_FLAG_INHERIT, 0);
 	if (!CreatePipe(hRead.GetPointer(), hWrite.GetPointer(), &sa, 0))
 	{
 		CString err { static_cast<LPCWSTR>(CFormatMessageWrapper()) };
@@ -352,7 +368,10 @@ int CGit::RunAsync(CString cmd, PROCESS_INFORMATION& piOut, HANDLE* hReadOut, HA
 	}
 
 	// Close the pipe handle so the child process stops reading.
-	hWriteIn.CloseHandle();
+	if (hWriteInOut)
+		*hWriteInOut = hWriteIn.Detach();
+	else
+		hWriteIn.CloseHandle();
 
 	m_CurrentGitPi = pi;
 	piOut = pi;
@@ -445,6 +464,7 @@ int CGit::Run(CGitCall& pcall)
 
 	CAutoGeneralHandle piThread(std::move(pi.hThread));
 	CAutoGeneralHandle piProcess(std::move(pi.hProcess));
+	pcall.OnStarted(piProcess);
 
 	ASYNCREADSTDERRTHREADARGS threadArguments;
 	threadArguments.fileHandle = hReadErr;
@@ -655,6 +675,13 @@ CString CGit::GetConfigValue(const CString& name, const CString& def, bool wantB
 	}
 	else
 	{
+		if (auto batchHelper = GetBatchHelper())
+		{
+			CString configValue;
+			if (const int found = batchHelper->GetConfigValue(name, wantBool, configValue); found >= 0)
+				return found ? configValue : def;
+		}
+
 		CString cmd;
 		cmd.Format(L"git.exe config%s %s", wantBool ? L" --bool" : L"", static_cast<LPCWSTR>(name));
 		CString configValue;
@@ -732,7 +759,10 @@ int CGit::SetConfigValue(const CString& key, const CString& value, CONFIG_TYPE t
 		mangledValue.Replace(L"\"", L"\\\"");
 		cmd.Format(L"git.exe config %s %s \"%s\"", static_cast<LPCWSTR>(option), static_cast<LPCWSTR>(key), static_cast<LPCWSTR>(mangledValue));
 		CString out;
-		if (Run(cmd, &out, nullptr, CP_UTF8))
+		const int ret = Run(cmd, &out, nullptr, CP_UTF8);
+		if (auto batchHelper = GetBatchHelper())
+			batchHelper->InvalidateConfig();
+		if (ret)
 			return -1;
 	}
 	return 0;
@@ -780,7 +810,10 @@ int CGit::UnsetConfigValue(const CString& key, CONFIG_TYPE type)
 		}
 		cmd.Format(L"git.exe config %s --unset %s", static_cast<LPCWSTR>(option), static_cast<LPCWSTR>(key));
 		CString out;
-		if (Run(cmd, &out, nullptr, CP_UTF8))
+		const int ret = Run(cmd, &out, nullptr, CP_UTF8);
+		if (auto batchHelper = GetBatchHelper())
+			batchHelper->InvalidateConfig();
+		if (ret)
 			return -1;
 	}
 	return 0;
@@ -1155,6 +1188,87 @@ CAutoRepository CGit::GetGitRepository() const
 	return CAutoRepository(GetGitPathStringA(m_CurrentDir));
 }
 
+bool CGit::QueryCommitIndex(git_repository* repo, const std::vector<CGitHash>& tips, const std::function<bool(const CGitCommitIndex&)>& query)
+{
+	CString adminDir;
+	if (!GitAdminDir::GetAdminDirPath(m_CurrentDir, adminDir))
+		return false;
+
+	CAutoLocker lock(m_critSecCommitIndex);
+	if (!m_commitIndex)
+		m_commitIndex = std::make_unique<CGitCommitIndex>();
+	if (!m_commitIndex->IsEnabled() || m_commitIndex->GetAdminDir() != adminDir)
+	{
+		m_commitIndex->Save();
+		m_commitIndex->Load(adminDir);
+	}
+	if (!m_commitIndex->IsEnabled())
+		return false;
+
+	// a query never costs much more than walking the history for it, if the index lags too far behind
+	// (e.g. on the first use in a large repository) it is built in the background and the caller walks the history itself
+	if (!m_commitIndex->Update(repo, tips, COMMITINDEX_MAX_NEW_COMMITS_PER_QUERY))
+	{
+		StartCommitIndexBuild(adminDir, tips);
+		return false;
+	}
+	const bool ret = query(*m_commitIndex);
+	// appends the new commits only and stores changed bitmaps, other processes need not compute them again
+	m_commitIndex->Save();
+	return ret;
+}
+
+void CGit::StartCommitIndexBuild(const CString& adminDir, const std::vector<CGitHash>& tips)
+{
+	if (m_hCommitIndexThread)
+	{
+		// one build at a time, the tips of later queries are mostly covered by it anyway
+		if (WaitForSingleObject(m_hCommitIndexThread, 0) == WAIT_TIMEOUT)
+			return;
+		m_hCommitIndexThread.CloseHandle();
+	}
+
+	auto args = new COMMITINDEXBUILDARGS{ this, adminDir, m_CurrentDir, tips };
+	m_hCommitIndexThread = CreateThread(nullptr, 0, CommitIndexBuildThread, args, 0, nullptr);
+	if (!m_hCommitIndexThread)
+		delete args;
+}
+
+DWORD WINAPI CGit::CommitIndexBuildThread(LPVOID lpParam)
+{
+	std::unique_ptr<COMMITINDEXBUILDARGS> args(static_cast<COMMITINDEXBUILDARGS*>(lpParam));
+
+	// built on its own index and repository, queries keep using the current index in the meantime
+	auto index = std::make_unique<CGitCommitIndex>();
+	index->Load(args->adminDir);
+	CAutoRepository repo(GetGitPathStringA(args->workingDir));
+	if (!repo)
+		return 1;
+
+	const ULONGLONG starttime = GetTickCount64();
+	const bool ok = index->Update(repo, args->tips, SIZE_MAX, &args->pGit->m_bCancelCommitIndexBuild);
+	index->Save(); // all indexed commits are valid, also if the build was cancelled
+	CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": indexed %zu commits in %I64u msec, %s\n", index->GetCount(), GetTickCount64() - starttime, ok ? L"complete" : L"stopped");
+	if (!ok)
+		return 1;
+
+	CAutoLocker lock(args->pGit->m_critSecCommitIndex);
+	if (args->pGit->m_commitIndex && args->pGit->m_commitIndex->GetAdminDir() == args->adminDir)
+		args->pGit->m_commitIndex = std::move(index);
+	return 0;
+}
+
+CGitBatchHelper* CGit::GetBatchHelper()
+{
+	if (!CGitBatchHelper::IsSupported())
+		return nullptr;
+
+	CAutoLocker lock(m_critSecBatchHelper);
+	if (!m_batchHelper)
+		m_batchHelper = std::make_unique<CGitBatchHelper>(*this);
+	return m_batchHelper.get();
+}
+
 int CGit::GetHash(git_repository * repo, CGitHash &hash, const CString& friendname, bool skipFastCheck /* = false */)
 {
 	ATLASSERT(repo);
@@ -1216,6 +1330,16 @@ int CGit::GetHash(CGitHash &hash, const CString& friendname)
 		CString branch = FixBranchName(friendname);
 		if (friendname == L"FETCH_HEAD" && branch.IsEmpty())
 			branch = friendname;
+		// errors are left to rev-parse, which reports them properly
+		if (auto batchHelper = GetBatchHelper())
+		{
+			CStringA type;
+			if (batchHelper->GetObjectInfo(branch, hash, type) == 1)
+			{
+				gitLastErr.Empty();
+				return 0;
+			}
+		}
 		CString cmd;
 		cmd.Format(L"git.exe rev-parse --verify --end-of-options %s", static_cast<LPCWSTR>(branch));
 		gitLastErr.Empty();
@@ -1311,31 +1435,46 @@ int CGit::GetSubmoduleHash(const CString& pathOfSubmodule, const CGitHash& revis
 	return 0;
 }
 
-int CGit::GetCommitDiffList(const CString &rev1, const CString &rev2, CTGitPathList &outputlist, bool ignoreSpaceAtEol, bool ignoreSpaceChange, bool ignoreAllSpace , bool ignoreBlankLines)
+static CString GetCommitDiffListCmd(const CString& rev1, const CString& rev2, const CString& options)
 {
 	CString cmd;
-	CString ignore;
-	if (ignoreSpaceAtEol)
-		ignore += L" --ignore-space-at-eol";
-	if (ignoreSpaceChange)
-		ignore += L" --ignore-space-change";
-	if (ignoreAllSpace)
-		ignore += L" --ignore-all-space";
-	if (ignoreBlankLines)
-		ignore += L" --ignore-blank-lines";
-
 	if (rev1 == GitRev::GetWorkingCopyRef() || rev2 == GitRev::GetWorkingCopyRef())
 	{
 		if (rev1 == GitRev::GetWorkingCopyRef())
-			cmd.Format(L"git.exe diff -r --raw -C%d%% -M%d%% --numstat -z %s --end-of-options %s --", ms_iSimilarityIndexThreshold, ms_iSimilarityIndexThreshold, static_cast<LPCWSTR>(ignore), static_cast<LPCWSTR>(rev2));
+			cmd.Format(L"git.exe diff -r --raw %s --end-of-options %s --", static_cast<LPCWSTR>(options), static_cast<LPCWSTR>(rev2));
 		else
-			cmd.Format(L"git.exe diff -r -R --raw -C%d%% -M%d%% --numstat -z %s --end-of-options %s --", ms_iSimilarityIndexThreshold, ms_iSimilarityIndexThreshold, static_cast<LPCWSTR>(ignore), static_cast<LPCWSTR>(rev1));
+			cmd.Format(L"git.exe diff -r -R --raw %s --end-of-options %s --", static_cast<LPCWSTR>(options), static_cast<LPCWSTR>(rev1));
 	}
 	else
-		cmd.Format(L"git.exe diff-tree -r --raw -C%d%% -M%d%% --numstat -z %s --end-of-options %s %s --", ms_iSimilarityIndexThreshold, ms_iSimilarityIndexThreshold, static_cast<LPCWSTR>(ignore), static_cast<LPCWSTR>(rev2), static_cast<LPCWSTR>(rev1));
+		cmd.Format(L"git.exe diff-tree -r --raw %s --end-of-options %s %s --", static_cast<LPCWSTR>(options), static_cast<LPCWSTR>(rev2), static_cast<LPCWSTR>(rev1));
+	return cmd;
+}
+
+int CGit::GetCommitDiffList(const CString &rev1, const CString &rev2, CTGitPathList &outputlist, bool ignoreSpaceAtEol, bool ignoreSpaceChange, bool ignoreAllSpace , bool ignoreBlankLines)
+{
+	CString options;
+	options.Format(L"-C%d%% -M%d%% --numstat -z", ms_iSimilarityIndexThreshold, ms_iSimilarityIndexThreshold);
+	if (ignoreSpaceAtEol)
+		options += L" --ignore-space-at-eol";
+	if (ignoreSpaceChange)
+		options += L" --ignore-space-change";
+	if (ignoreAllSpace)
+		options += L" --ignore-all-space";
+	if (ignoreBlankLines)
+		options += L" --ignore-blank-lines";
 
 	BYTE_VECTOR out;
-	if (Run(cmd, &out))
+	if (Run(GetCommitDiffListCmd(rev1, rev2, options), &out))
+		return -1;
+
+	return outputlist.ParserFromLog(out);
+}
+
+int CGit::GetCommitDiffListQuick(const CString& rev1, const CString& rev2, CTGitPathList& outputlist)
+{
+	// "git diff" detects renames by default (diff.renames)
+	BYTE_VECTOR out;
+	if (Run(GetCommitDiffListCmd(rev1, rev2, L"--no-renames -z"), &out))
 		return -1;
 
 	return outputlist.ParserFromLog(out);
@@ -1690,17 +1829,18 @@ int CGit::GetRefsCommitIsOn(STRING_VECTOR& list, const CGitHash& hash, bool incl
 		if (git_reference_iterator_new(it.GetPointer(), repo))
 			return -1;
 
-		auto checkDescendent = [&list, &hash, &repo](const git_oid* oid, const git_reference* ref) {
+		// collect the candidates first, so that they can be checked all at once
+		std::vector<CString> names;
+		std::vector<CGitHash> targets;
+		auto checkDescendent = [&names, &targets](const git_oid* oid, const git_reference* ref) {
 			if (!oid)
 				return;
-			if (git_oid_equal(oid, hash) || git_graph_descendant_of(repo, oid, hash) == 1)
-			{
-				const char* name = git_reference_name(ref);
-				if (!name)
-					return;
+			const char* name = git_reference_name(ref);
+			if (!name)
+				return;
 
-				list.push_back(CUnicodeUtils::GetUnicode(name));
-			}
+			names.push_back(CUnicodeUtils::GetUnicode(name));
+			targets.emplace_back(oid);
 		};
 
 		CAutoReference ref;
@@ -1746,6 +1886,21 @@ int CGit::GetRefsCommitIsOn(STRING_VECTOR& list, const CGitHash& hash, bool incl
 
 			checkDescendent(git_reference_target(ref), ref);
 		}
+
+		std::vector<bool> contains;
+		std::vector<CGitHash> tips = targets;
+		tips.push_back(hash);
+		if (!QueryCommitIndex(repo, tips, [&hash, &targets, &contains](const CGitCommitIndex& index) { return index.GetContaining(hash, targets, contains); }))
+		{
+			contains.assign(targets.size(), false);
+			for (size_t i = 0; i < targets.size(); ++i)
+				contains[i] = targets[i] == hash || git_graph_descendant_of(repo, targets[i], hash) == 1;
+		}
+		for (size_t i = 0; i < names.size(); ++i)
+		{
+			if (contains[i])
+				list.push_back(names[i]);
+		}
 	}
 	else
 	{
@@ -2543,11 +2698,15 @@ bool CGit::IsFastForward(const CString &from, const CString &to, CGitHash * comm
 		if (GetHash(repo, fromHash, FixBranchName(from)))
 			return false;
 
-		git_oid baseOid;
-		if (git_merge_base(&baseOid, repo, toHash, fromHash))
-			return false;
+		// the index answers repeated queries without walking the history, it only lacks support for several merge bases
+		if (!QueryCommitIndex(repo, { toHash, fromHash }, [&toHash, &fromHash, &baseHash](const CGitCommitIndex& index) { return index.GetMergeBase(toHash, fromHash, baseHash); }))
+		{
+			git_oid baseOid;
+			if (git_merge_base(&baseOid, repo, toHash, fromHash))
+				return false;
 
-		baseHash = baseOid;
+			baseHash = baseOid;
+		}
 
 		if (commonAncestor)
 			*commonAncestor = baseHash;
@@ -2573,6 +2732,186 @@ bool CGit::IsFastForward(const CString &from, const CString &to, CGitHash * comm
 	return hash == basehash;
 }
 
+bool CGit::GetReachableFrom(git_repository* repo, const CString& baseRef, const CGitHash& baseHash, const std::vector<CGitHash>& commits, std::vector<bool>& reachable)
+{
+	std::vector<CGitHash> tips = commits;
+	tips.push_back(baseHash);
+	return QueryCommitIndex(repo, tips, [&](const CGitCommitIndex& index) {
+		const auto bitmap = index.GetReachabilityBitmap(baseRef, baseHash);
+		if (!bitmap)
+			return false;
+		reachable.assign(commits.size(), false);
+		for (size_t i = 0; i < commits.size(); ++i)
+		{
+			const int ret = index.IsReachable(*bitmap, commits[i]);
+			if (ret < 0)
+				return false;
+			reachable[i] = ret == 1;
+		}
+		return true;
+	});
+}
+
+static std::map<std::pair<CGitHash, CGitHash>, std::pair<size_t, size_t>> g_AheadBehindCache;
+static CComAutoCriticalSection g_critSecAheadBehindCache;
+#define AHEADBEHIND_CACHE_MAX_ENTRIES 10000
+
+int CGit::GetAheadBehind(git_repository* repo, const std::vector<std::pair<CGitHash, CGitHash>>& pairs, std::vector<std::pair<size_t, size_t>>& aheadBehind)
+{
+	aheadBehind.assign(pairs.size(), { 0, 0 });
+
+	// pair i is walked with the bits 2 * i (local) and 2 * i + 1 (upstream)
+	std::vector<size_t> pending;
+	{
+		CAutoLocker lock(g_critSecAheadBehindCache);
+		for (size_t i = 0; i < pairs.size(); ++i)
+		{
+			if (pairs[i].first == pairs[i].second)
+				continue;
+			if (auto it = g_AheadBehindCache.find(pairs[i]); it != g_AheadBehindCache.cend())
+				aheadBehind[i] = it->second;
+			else
+				pending.push_back(i);
+		}
+	}
+	if (pending.empty())
+		return 0;
+
+	struct WalkCommit
+	{
+		std::vector<UINT64>		bits;
+		std::vector<UINT64>		counted; // the bits of the pairs this commit is currently counted for, ahead (2 * i) or behind (2 * i + 1)
+		std::vector<CGitHash>	parents;
+		git_time_t				time = 0;
+		bool					queued = false;
+		bool					walked = false;
+	};
+	// both bits of a pair are in the same word, the even bits are the local sides
+	constexpr UINT64 localMask = 0x5555555555555555ULL;
+	const size_t words = (2 * pending.size() + 63) / 64;
+	auto countedBits = [](UINT64 bits) {
+		const UINT64 local = bits & localMask;
+		const UINT64 upstream = (bits >> 1) & localMask;
+		return (local & ~upstream) | ((upstream & ~local) << 1);
+	};
+	// a queued commit has to be processed if it is not reached by both sides of a pair, or if it was counted or walked
+	// before, then the new bits might correct its count and the counts of its ancestors
+	auto needsWalk = [&countedBits](const WalkCommit& commit) {
+		if (commit.walked)
+			return true;
+		for (size_t i = 0; i < commit.bits.size(); ++i)
+		{
+			if (countedBits(commit.bits[i]) || commit.counted[i])
+				return true;
+		}
+		return false;
+	};
+
+	// walks all pairs at once by commit date like git_graph_ahead_behind, commits reached by both sides of every pair
+	// that reaches them do not change any count, so the walk ends when only such commits are left.
+	// Commits with equal (or skewed) dates might be processed before one of their children, then they get processed
+	// again with the additional bits and their counts are corrected, so that no commit is counted twice.
+	std::unordered_map<CGitHash, WalkCommit> commits;
+	std::priority_queue<std::pair<git_time_t, CGitHash>> queue;
+	size_t walkQueued = 0;
+	auto enqueue = [&](const CGitHash& hash, const std::vector<UINT64>& bits) {
+		auto& commit = commits[hash];
+		if (commit.bits.empty())
+		{
+			CAutoCommit gitCommit;
+			if (git_commit_lookup(gitCommit.GetPointer(), repo, hash))
+				return false;
+			commit.bits.assign(words, 0);
+			commit.counted.assign(words, 0);
+			commit.time = git_commit_time(gitCommit);
+			const unsigned int parentCount = git_commit_parentcount(gitCommit);
+			for (unsigned int i = 0; i < parentCount; ++i)
+				commit.parents.emplace_back(git_commit_parent_id(gitCommit, i));
+		}
+		bool changed = false;
+		for (size_t i = 0; i < words; ++i)
+			changed |= (commit.bits[i] | bits[i]) != commit.bits[i];
+		if (!changed)
+			return true; // already processed or queued with these bits
+		const bool walk = commit.queued && needsWalk(commit);
+		for (size_t i = 0; i < words; ++i)
+			commit.bits[i] |= bits[i];
+		if (!commit.queued)
+		{
+			commit.queued = true;
+			queue.emplace(commit.time, hash);
+		}
+		if (!walk && needsWalk(commit))
+			++walkQueued;
+		else if (walk && !needsWalk(commit))
+			--walkQueued;
+		return true;
+	};
+
+	for (size_t i = 0; i < pending.size(); ++i)
+	{
+		std::vector<UINT64> bits(words);
+		bits[(2 * i) / 64] |= 1ULL << ((2 * i) % 64);
+		if (!enqueue(pairs[pending[i]].first, bits))
+			return -1;
+		bits.assign(words, 0);
+		bits[(2 * i + 1) / 64] |= 1ULL << ((2 * i + 1) % 64);
+		if (!enqueue(pairs[pending[i]].second, bits))
+			return -1;
+	}
+
+	while (walkQueued > 0 && !queue.empty())
+	{
+		const CGitHash hash = queue.top().second;
+		queue.pop();
+		auto& commit = commits[hash];
+		commit.queued = false;
+		if (needsWalk(commit))
+			--walkQueued;
+		commit.walked = true;
+		for (size_t word = 0; word < words; ++word)
+		{
+			const UINT64 counted = countedBits(commit.bits[word]);
+			const UINT64 changed = counted ^ commit.counted[word];
+			commit.counted[word] = counted;
+			for (size_t bit = 0; bit < 64 && (changed >> bit); bit += 2)
+			{
+				if (!((changed >> bit) & 3))
+					continue;
+				auto& [ahead, behind] = aheadBehind[pending[word * 32 + bit / 2]];
+				if ((changed >> bit) & 1)
+				{
+					if ((counted >> bit) & 1)
+						++ahead;
+					else
+						--ahead;
+				}
+				if ((changed >> (bit + 1)) & 1)
+				{
+					if ((counted >> (bit + 1)) & 1)
+						++behind;
+					else
+						--behind;
+				}
+			}
+		}
+		const std::vector<UINT64> bits = commit.bits;
+		const std::vector<CGitHash> parents = commit.parents;
+		for (const auto& parent : parents)
+		{
+			if (!enqueue(parent, bits))
+				return -1;
+		}
+	}
+
+	CAutoLocker lock(g_critSecAheadBehindCache);
+	if (g_AheadBehindCache.size() > AHEADBEHIND_CACHE_MAX_ENTRIES)
+		g_AheadBehindCache.clear();
+	for (auto i : pending)
+		g_AheadBehindCache[pairs[i]] = aheadBehind[i];
+	return 0;
+}
+
 unsigned int CGit::Hash2int(const CGitHash &hash)
 {
 	int ret=0;
@@ -2688,6 +3027,22 @@ int CGit::GetOneFile(const CString &Refname, const CTGitPath &path, const CStrin
 	}
 	else
 	{
+		if (auto batchHelper = GetBatchHelper())
+		{
+			CStringA type;
+			BYTE_VECTOR content;
+			// "cat-file -p" pretty prints trees and fails for submodules, so only blobs are taken from the helper
+			if (batchHelper->GetObjectContents(Refname + L':' + path.GetGitPathString(), type, content) == 1 && type == "blob")
+			{
+				CAutoFILE file = _wfsopen(outputfile, L"wb", SH_DENYWR);
+				if (file && fwrite(content.data(), sizeof(char), content.size(), file) == content.size())
+				{
+					gitLastErr.Empty();
+					return 0;
+				}
+			}
+		}
+
 		CString cmd;
 		cmd.Format(L"git.exe cat-file -p %s:\"%s\"", static_cast<LPCWSTR>(Refname), static_cast<LPCWSTR>(path.GetGitPathString()));
 		gitLastErr.Empty();
@@ -3264,11 +3619,260 @@ bool CGit::LoadTextFile(const CString &filename, CString &msg)
 	return true; // load no further files
 }
 
+void CGit::GetPathspecs(const CTGitPathList* list, std::vector<CStringA>& buffers, std::vector<char*>& pointers, git_strarray& specs)
+{
+	buffers.clear();
+	pointers.clear();
+	for (int i = 0; list && i < list->GetCount(); ++i)
+	{
+		ATLASSERT(!(*list)[i].GetGitPathString().IsEmpty());
+		buffers.push_back(CUnicodeUtils::GetUTF8((*list)[i].GetGitPathString()));
+	}
+	for (auto& buffer : buffers)
+		pointers.push_back(buffer.GetBuffer());
+	specs = { pointers.data(), pointers.size() };
+}
+
+int CGit::AppendRawNumstat(git_diff* diff, BYTE_VECTOR& out)
+{
+	auto isListed = [](const git_diff_delta* delta) {
+		switch (delta->status)
+		{
+		case GIT_DELTA_ADDED:
+		case GIT_DELTA_DELETED:
+		case GIT_DELTA_MODIFIED:
+		case GIT_DELTA_RENAMED:
+		case GIT_DELTA_COPIED:
+		case GIT_DELTA_TYPECHANGE:
+		case GIT_DELTA_CONFLICTED:
+			return true;
+		default:
+			return false;
+		}
+	};
+	auto appendPaths = [&out](const git_diff_delta* delta) {
+		if (delta->status == GIT_DELTA_RENAMED || delta->status == GIT_DELTA_COPIED)
+			out.append(delta->old_file.path, strlen(delta->old_file.path) + 1);
+		out.append(delta->new_file.path, strlen(delta->new_file.path) + 1);
+	};
+
+	const size_t deltas = git_diff_num_deltas(diff);
+	CStringA record;
+	// raw output first, then the numstat output, like git.exe does
+	for (size_t i = 0; i < deltas; ++i)
+	{
+		const git_diff_delta* delta = git_diff_get_delta(diff, i);
+		if (!isListed(delta))
+			continue;
+
+		char oldHash[GIT_OID_SHA1_HEXSIZE + 1];
+		char newHash[GIT_OID_SHA1_HEXSIZE + 1];
+		git_oid_tostr(oldHash, sizeof(oldHash), &delta->old_file.id);
+		git_oid_tostr(newHash, sizeof(newHash), &delta->new_file.id);
+		record.Format(":%06o %06o %s %s ", delta->old_file.mode, delta->new_file.mode, oldHash, newHash);
+		switch (delta->status)
+		{
+		case GIT_DELTA_ADDED: record += 'A'; break;
+		case GIT_DELTA_DELETED: record += 'D'; break;
+		case GIT_DELTA_MODIFIED: record += 'M'; break;
+		case GIT_DELTA_TYPECHANGE: record += 'T'; break;
+		case GIT_DELTA_CONFLICTED: record += 'U'; break;
+		case GIT_DELTA_RENAMED: record.AppendFormat("R%03u", delta->similarity); break;
+		case GIT_DELTA_COPIED: record.AppendFormat("C%03u", delta->similarity); break;
+		}
+		out.append(record, record.GetLength() + 1);
+		appendPaths(delta);
+	}
+	for (size_t i = 0; i < deltas; ++i)
+	{
+		const git_diff_delta* delta = git_diff_get_delta(diff, i);
+		// git.exe does not output numstat lines for unmerged entries
+		if (!isListed(delta) || delta->status == GIT_DELTA_CONFLICTED)
+			continue;
+
+		CAutoPatch patch;
+		if (git_patch_from_diff(patch.GetPointer(), diff, i) < 0)
+			return -1;
+		size_t additions = 0, deletions = 0;
+		if (git_patch_line_stats(nullptr, &additions, &deletions, patch) < 0)
+			return -1;
+		if (git_patch_get_delta(patch)->flags & GIT_DIFF_FLAG_BINARY)
+			record = "-\t-\t";
+		else
+			record.Format("%zu\t%zu\t", additions, deletions);
+		if (delta->status == GIT_DELTA_RENAMED || delta->status == GIT_DELTA_COPIED)
+			out.append(record, record.GetLength() + 1); // old and new name are separated by NULs
+		else
+			out.append(record, record.GetLength());
+		appendPaths(delta);
+	}
+	return 0;
+}
+
+int CGit::GetWorkingTreeChangesLibGit2(CTGitPathList& result, bool amend, const CTGitPathList* filterlist, bool includedStaged, bool getStagingStatus)
+{
+	CAutoRepository repo(GetGitRepository());
+	if (!repo)
+		return -1;
+
+	CAutoIndex index;
+	if (git_repository_index(index.GetPointer(), repo) < 0)
+		return -1;
+
+	CAutoTree headTree; // stays empty when amending a root commit, i.e. everything is compared to the empty tree
+	{
+		CAutoObject obj;
+		if (git_revparse_single(obj.GetPointer(), repo, amend ? "HEAD~1^{tree}" : "HEAD^{tree}") == 0)
+			headTree.ConvertFrom(std::move(obj));
+		else if (!amend)
+			return -1;
+	}
+
+	std::vector<CStringA> pathspecBuffers;
+	std::vector<char*> pathspecPointers;
+	git_strarray pathspecs;
+	GetPathspecs(filterlist, pathspecBuffers, pathspecPointers, pathspecs);
+
+	// cf. "-C -M", "-C<threshold>% -M<threshold>%"
+	auto findSimilar = [](git_diff* diff, int threshold) {
+		git_diff_find_options findOpts = GIT_DIFF_FIND_OPTIONS_INIT;
+		findOpts.flags = GIT_DIFF_FIND_COPIES | GIT_DIFF_FIND_RENAMES;
+		if (threshold > 0)
+			findOpts.rename_threshold = findOpts.copy_threshold = static_cast<uint16_t>(threshold);
+		return git_diff_find_similar(diff, &findOpts);
+	};
+	auto diffOptions = [](const git_strarray* specs) {
+		git_diff_options opts = GIT_DIFF_OPTIONS_INIT;
+		opts.flags = GIT_DIFF_INCLUDE_TYPECHANGE;
+		if (specs)
+			opts.pathspec = *specs;
+		return opts;
+	};
+
+	BYTE_VECTOR out;
+	// also list staged files which will be in the commit
+	git_diff_options opts = diffOptions(includedStaged ? nullptr : &pathspecs);
+	CAutoDiff stagedDiff;
+	if (git_diff_tree_to_index(stagedDiff.GetPointer(), repo, headTree, index, &opts) < 0 || findSimilar(stagedDiff, 0) < 0 || AppendRawNumstat(stagedDiff, out) < 0)
+		return -1;
+
+	opts = diffOptions(&pathspecs);
+	CAutoDiff workingTreeDiff;
+	if (git_diff_tree_to_workdir_with_index(workingTreeDiff.GetPointer(), repo, headTree, &opts) < 0 || findSimilar(workingTreeDiff, ms_iSimilarityIndexThreshold) < 0 || AppendRawNumstat(workingTreeDiff, out) < 0)
+		return -1;
+	result.ParserFromLog(out);
+
+	// index against working tree, filtered for the deleted files and unfiltered for the staging status
+	opts = diffOptions(getStagingStatus ? nullptr : &pathspecs);
+	CAutoDiff unstagedDiff;
+	if (git_diff_index_to_workdir(unstagedDiff.GetPointer(), repo, index, &opts) < 0 || findSimilar(unstagedDiff, 0) < 0)
+		return -1;
+
+	CAutoPathspec pathspecMatcher;
+	if (git_pathspec_new(pathspecMatcher.GetPointer(), &pathspecs) < 0)
+		return -1;
+	auto matchesFilter = [&](const char* path) {
+		return !filterlist || git_pathspec_matches_path(pathspecMatcher, GIT_PATHSPEC_DEFAULT, path) == 1;
+	};
+
+	if (getStagingStatus)
+	{
+		// cf. the comments in the git.exe code path
+		std::set<CString> staged, unstaged;
+		opts = diffOptions(nullptr);
+		CAutoDiff stagedUnfilteredDiff;
+		if (git_diff_tree_to_index(stagedUnfilteredDiff.GetPointer(), repo, headTree, index, &opts) < 0 || findSimilar(stagedUnfilteredDiff, 0) < 0)
+			return -1;
+		for (size_t i = 0, deltas = git_diff_num_deltas(stagedUnfilteredDiff); i < deltas; ++i)
+			staged.insert(CUnicodeUtils::GetUnicode(git_diff_get_delta(stagedUnfilteredDiff, i)->new_file.path));
+		for (size_t i = 0, deltas = git_diff_num_deltas(unstagedDiff); i < deltas; ++i)
+			unstaged.insert(CUnicodeUtils::GetUnicode(git_diff_get_delta(unstagedDiff, i)->new_file.path));
+
+		for (const auto& path : staged)
+			result.UpdateStagingStatusFromPath(path, unstaged.contains(path) ? CTGitPath::StagingStatus::PartiallyStaged : CTGitPath::StagingStatus::TotallyStaged);
+		for (const auto& path : unstaged)
+		{
+			if (!staged.contains(path))
+				result.UpdateStagingStatusFromPath(path, CTGitPath::StagingStatus::TotallyUnstaged);
+		}
+		for (int j = 0; j < result.GetCount(); ++j)
+		{
+			if (result[j].m_Action & CTGitPath::LOGACTIONS_UNMERGED)
+				const_cast<CTGitPath&>(result[j]).m_stagingStatus = CTGitPath::StagingStatus::TotallyUnstaged;
+		}
+	}
+
+	std::map<CString, int> duplicateMap;
+	for (int i = 0; i < result.GetCount(); ++i)
+		duplicateMap.emplace(result[i].GetGitPathString(), i);
+
+	// handle delete conflict case, when remote : modified, local : deleted.
+	if (git_index_has_conflicts(index))
+	{
+		CAutoIndexConflictIterator it;
+		if (git_index_conflict_iterator_new(it.GetPointer(), index) < 0)
+			return -1;
+		const git_index_entry* ancestor;
+		const git_index_entry* ours;
+		const git_index_entry* theirs;
+		while (git_index_conflict_next(&ancestor, &ours, &theirs, it) == 0)
+		{
+			const git_index_entry* entry = ours ? ours : theirs ? theirs : ancestor;
+			if (!matchesFilter(entry->path))
+				continue;
+			CString path = CUnicodeUtils::GetUnicode(entry->path);
+			if (auto existing = duplicateMap.find(path); existing != duplicateMap.end())
+				const_cast<CTGitPath&>(result[existing->second]).m_Action |= CTGitPath::LOGACTIONS_UNMERGED;
+			else
+			{
+				CTGitPath conflict;
+				conflict.SetFromGit(path, (entry->mode & S_IFDIR) == S_IFDIR);
+				conflict.m_Action = CTGitPath::LOGACTIONS_UNMERGED;
+				result.AddPath(conflict);
+				duplicateMap.emplace(path, result.GetCount() - 1);
+			}
+		}
+	}
+
+	// handle source files of file renames/moves (issue #860)
+	for (size_t i = 0, deltas = git_diff_num_deltas(unstagedDiff); i < deltas; ++i)
+	{
+		const git_diff_delta* delta = git_diff_get_delta(unstagedDiff, i);
+		if (delta->status != GIT_DELTA_DELETED || !matchesFilter(delta->old_file.path))
+			continue;
+		CString path = CUnicodeUtils::GetUnicode(delta->old_file.path);
+		if (auto existing = duplicateMap.find(path); existing == duplicateMap.end())
+		{
+			CTGitPath deleted;
+			deleted.SetFromGit(path);
+			deleted.m_Action = CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_MISSING;
+			result.AddPath(deleted);
+			duplicateMap.emplace(path, result.GetCount() - 1);
+		}
+		else
+		{
+			const_cast<CTGitPath&>(result[existing->second]).m_Action |= CTGitPath::LOGACTIONS_MISSING;
+			result.m_Action |= CTGitPath::LOGACTIONS_MISSING;
+		}
+	}
+
+	return 0;
+}
+
 int CGit::GetWorkingTreeChanges(CTGitPathList& result, bool amend, const CTGitPathList* filterlist, bool includedStaged /* = false */, bool getStagingStatus /* = false */)
 {
 	if (IsInitRepos())
 		return GetInitAddList(result, getStagingStatus);
 
+	// libgit2 does not support everything git.exe does (e.g. some index extensions), so fall back to git.exe in case of an error
+	if (UsingLibGit2(GIT_CMD_WORKINGTREECHANGES))
+	{
+		if (!GetWorkingTreeChangesLibGit2(result, amend, filterlist, includedStaged, getStagingStatus))
+			return 0;
+		CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": libgit2 failed, falling back to git.exe: %s\n", static_cast<LPCWSTR>(GetLibGit2LastErr()));
+		result.Clear();
+	}
+
 	BYTE_VECTOR out;
 
 	int count = 1;
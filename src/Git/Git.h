@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -25,14 +25,19 @@
 #include <functional>
 #include "StringUtils.h"
 #include "PathUtils.h"
+#include "GitLineSplitter.h"
+#include "SmartHandle.h"
+#include <memory>
 
 #define REG_MSYSGIT_PATH L"Software\\TortoiseGit\\MSysGit"
 #define REG_SYSTEM_GITCONFIGPATH L"Software\\TortoiseGit\\SystemConfig"
 #define REG_MSYSGIT_EXTRA_PATH L"Software\\TortoiseGit\\MSysGitExtra"
 
-#define DEFAULT_USE_LIBGIT2_MASK (1 << CGit::GIT_CMD_MERGE_BASE) | (1 << CGit::GIT_CMD_DELETETAGBRANCH) | (1 << CGit::GIT_CMD_GETONEFILE) | (1 << CGit::GIT_CMD_ADD) | (1 << CGit::GIT_CMD_CHECKCONFLICTS) | (1 << CGit::GIT_CMD_GET_COMMIT) | (1 << CGit::GIT_CMD_GETCONFLICTINFO) | (1 << CGit::GIT_CMD_FOREACHREF)
+#define DEFAULT_USE_LIBGIT2_MASK (1 << CGit::GIT_CMD_MERGE_BASE) | (1 << CGit::GIT_CMD_DELETETAGBRANCH) | (1 << CGit::GIT_CMD_GETONEFILE) | (1 << CGit::GIT_CMD_ADD) | (1 << CGit::GIT_CMD_CHECKCONFLICTS) | (1 << CGit::GIT_CMD_GET_COMMIT) | (1 << CGit::GIT_CMD_GETCONFLICTINFO) | (1 << CGit::GIT_CMD_FOREACHREF) | (1 << CGit::GIT_CMD_WORKINGTREECHANGES)
 
 struct git_repository;
+class CGitCommitIndex;
+class CGitBatchHelper;
 
 using CAutoLocker = CComCritSecLock<CComCriticalSection>;
 
@@ -84,6 +89,8 @@ public:
 	virtual bool	OnOutputData(const char* data, size_t size) = 0;
 	virtual bool	OnOutputErrData(const char* data, size_t size) = 0;
 	virtual void	OnEnd(){}
+	/// called with the handle of the git process once it is running (e.g. to terminate it), the handle is closed after the command ended
+	virtual void	OnStarted(HANDLE /*hProcess*/) {}
 
 private:
 	CString m_Cmd;
@@ -98,32 +105,15 @@ public:
 		, m_recv(recv)
 		, m_pvectorErr(pvectorErr)
 	{
-		static_assert(std::is_convertible_v<GitReceiverFunc, std::function<void(const CStringA&)>>, "Wrong signature for GitReceiverFunc!");
+		static_assert(std::is_convertible_v<GitReceiverFunc, std::function<void(const CStringA&)>> || std::is_convertible_v<GitReceiverFunc, std::function<void(std::string_view)>>, "Wrong signature for GitReceiverFunc!");
 	}
 
 	bool OnOutputData(const char* data, size_t size) override
 	{
 		ASSERT(data);
-		// Add data
 		if (size == 0 || size >= INT_MAX)
 			return false;
-		const int oldEndPos = m_buffer.GetLength();
-		int newLength;
-		if (IntAdd(oldEndPos, static_cast<int>(size), &newLength) != S_OK)
-			return false;
-		memcpy(CStrBufA(m_buffer, newLength, 0) + oldEndPos, data, size);
-
-		// Break into lines and feed to m_recv
-		int eolPos;
-		CStringA line;
-		while ((eolPos = m_buffer.Find('\n')) >= 0)
-		{
-			memcpy(CStrBufA(line, eolPos, 0), static_cast<const char*>(m_buffer), eolPos);
-			auto oldLen = m_buffer.GetLength();
-			memmove(m_buffer.GetBuffer(oldLen), static_cast<const char*>(m_buffer) + eolPos + 1, m_buffer.GetLength() - eolPos - 1);
-			m_buffer.ReleaseBuffer(oldLen - eolPos - 1);
-			m_recv(line);
-		}
+		m_splitter.Feed(data, size, [this](std::string_view line) { Receive(line); });
 		return false;
 	}
 
@@ -143,14 +133,26 @@ public:
 
 	void OnEnd() override
 	{
-		if (!m_buffer.IsEmpty())
-			m_recv(m_buffer);
-		m_buffer.Empty(); // Just for sure
+		m_splitter.Finish([this](std::string_view line) { Receive(line); });
 	}
 
 private:
+	/// receivers taking a std::string_view get the line without any copy
+	void Receive(std::string_view line)
+	{
+		if constexpr (std::is_invocable_v<GitReceiverFunc&, std::string_view>)
+			m_recv(line);
+		else
+		{
+			ASSERT(line.size() < INT_MAX);
+			m_line.SetString(line.data(), static_cast<int>(line.size()));
+			m_recv(m_line);
+		}
+	}
+
 	GitReceiverFunc m_recv;
-	CStringA m_buffer;
+	CGitLineSplitter m_splitter;
+	CStringA m_line;
 	BYTE_VECTOR* m_pvectorErr;
 };
 
@@ -303,6 +305,7 @@ public:
 		GIT_CMD_BRANCH_CONTAINS,
 		GIT_CMD_GETCONFLICTINFO,
 		GIT_CMD_FOREACHREF,
+		GIT_CMD_WORKINGTREECHANGES,
 		LAST_VALUE,
 	};
 	static_assert(LIBGIT2_CMD::LAST_VALUE < sizeof(DWORD) * 8, "too many flags for storing them in a DWORD bitfield");
@@ -373,16 +376,47 @@ private:
 		HANDLE fileHandle;
 		CGitCall* pcall;
 	};
+	std::unique_ptr<CGitCommitIndex>	m_commitIndex;
+	CComAutoCriticalSection	m_critSecCommitIndex;
+	/**
+	 * Extends the commit index of the current repository towards \a tips and calls \a query on it once it covers them.
+	 * New commits are stored right away. If too many commits are missing, the index is built on a background thread.
+	 * \return false if the index cannot be used (yet), then the caller has to fall back to walking the history
+	 */
+	bool QueryCommitIndex(git_repository* repo, const std::vector<CGitHash>& tips, const std::function<bool(const CGitCommitIndex&)>& query);
+	/// m_critSecCommitIndex has to be locked
+	void StartCommitIndexBuild(const CString& adminDir, const std::vector<CGitHash>& tips);
+	struct COMMITINDEXBUILDARGS
+	{
+		CGit* pGit;
+		CString adminDir;
+		CString workingDir;
+		std::vector<CGitHash> tips;
+	};
+	static DWORD WINAPI CommitIndexBuildThread(LPVOID lpParam);
+	CAutoGeneralHandle	m_hCommitIndexThread;
+	volatile LONG		m_bCancelCommitIndexBuild = FALSE;
+	std::unique_ptr<CGitBatchHelper>	m_batchHelper;
+	CComAutoCriticalSection	m_critSecBatchHelper;
+	/// \return nullptr if the installed git does not support the helper
+	CGitBatchHelper* GetBatchHelper();
 	CString GetUnifiedDiffCmd(const CTGitPath& path, const CString& rev1, const CString& rev2, bool bMerge, bool bCombine, int diffContext, bool bNoPrefix = false);
 
 public:
 #ifdef _MFC_VER
 	void KillRelatedThreads(CWinThread* thread);
 #endif
-	int RunAsync(CString cmd, PROCESS_INFORMATION& pi, HANDLE* hRead, HANDLE* hErrReadOut, const CString* StdioFile = nullptr);
+	/// \param hWriteInOut if not nullptr, receives the write end of the stdin pipe, otherwise stdin is closed right away
+	int RunAsync(CString cmd, PROCESS_INFORMATION& pi, HANDLE* hRead, HANDLE* hErrReadOut, const CString* StdioFile = nullptr, HANDLE* hWriteInOut = nullptr);
 	int RunLogFile(CString cmd, const CString &filename, CString *stdErr);
 
 	bool IsFastForward(const CString& from, const CString& to, CGitHash* commonAncestor = nullptr);
+	/**
+	 * Checks for all \a commits whether they are reachable from \a baseRef, which currently points to \a baseHash.
+	 * Uses a reachability bitmap which is kept per ref and only extended when the ref moves forward.
+	 * \return false if the commit index cannot be used
+	 */
+	bool GetReachableFrom(git_repository* repo, const CString& baseRef, const CGitHash& baseHash, const std::vector<CGitHash>& commits, std::vector<bool>& reachable);
 	CString GetConfigValue(const CString& name, const CString& def = CString(), bool wantBool = false);
 	bool GetConfigValueBool(const CString& name, const bool def = false);
 	int GetConfigValueInt32(const CString& name, const int def = 0);
@@ -494,6 +528,11 @@ public:
 	int GuessRefForHash(CString& ref, const CGitHash& hash);
 	int GetMapHashToFriendName(MAP_HASH_NAME &map);
 	static int GetMapHashToFriendName(git_repository* repo, MAP_HASH_NAME &map);
+	/**
+	 * Computes how many commits each local commit is ahead of and behind its upstream commit (pairs of local, upstream).
+	 * All pairs are computed in one walk over the history and the results are cached per pair.
+	 */
+	static int GetAheadBehind(git_repository* repo, const std::vector<std::pair<CGitHash, CGitHash>>& pairs, std::vector<std::pair<size_t, size_t>>& aheadBehind);
 
 	CString DerefFetchHead();
 
@@ -560,8 +599,18 @@ public:
 	static CString StripRefName(CString refName);
 
 	int GetCommitDiffList(const CString &rev1, const CString &rev2, CTGitPathList &outpathlist, bool ignoreSpaceAtEol = false, bool ignoreSpaceChange = false, bool ignoreAllSpace = false, bool ignoreBlankLines = false);
+	/// like GetCommitDiffList(), but without rename detection and line statistics, which take most of the time on large diffs
+	int GetCommitDiffListQuick(const CString& rev1, const CString& rev2, CTGitPathList& outpathlist);
 	int GetInitAddList(CTGitPathList &outpathlist, bool getStagingStatus = false);
 	int GetWorkingTreeChanges(CTGitPathList& result, bool amend = false, const CTGitPathList* filterlist = nullptr, bool includedStaged = false, bool getStagingStatus = false);
+	/// fills \a specs with the git paths of all entries of \a list (no entries for nullptr), \a buffers and \a pointers hold the data
+	static void GetPathspecs(const CTGitPathList* list, std::vector<CStringA>& buffers, std::vector<char*>& pointers, git_strarray& specs);
+private:
+	/// in-process implementation of GetWorkingTreeChanges(), handles all entries of \a filterlist in one pass
+	int GetWorkingTreeChangesLibGit2(CTGitPathList& result, bool amend, const CTGitPathList* filterlist, bool includedStaged, bool getStagingStatus);
+	/// appends the records "git diff-index --raw --numstat -z" would output for \a diff, so that they are merged by CTGitPathList::ParserFromLog() exactly the same way
+	static int AppendRawNumstat(git_diff* diff, BYTE_VECTOR& out);
+public:
 
 	static int ParseConflictHashesFromLsFile(const BYTE_VECTOR& out, CGitHash& baseHash, bool& baseIsFile, CGitHash& mineHash, bool& mineIsFile, CGitHash& remoteHash, bool& remoteIsFile);
 
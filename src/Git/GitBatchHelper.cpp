@@ -0,0 +1,364 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "GitBatchHelper.h"
+#include "Git.h"
+#include "UnicodeUtils.h"
+
+#define READ_BUFFER_SIZE (64 * 1024)
+
+CGitBatchHelper::~CGitBatchHelper()
+{
+	if (m_hIdleTimer)
+		DeleteTimerQueueTimer(nullptr, m_hIdleTimer, INVALID_HANDLE_VALUE);
+	StopProcess();
+}
+
+bool CGitBatchHelper::IsSupported()
+{
+	// "cat-file --batch-command" is available since git 2.36, Cygwin and MSYS2 git would need their commands to be wrapped by bash
+	return CGit::ms_LastMsysGitVersion >= ConvertVersionToInt(2, 36, 0) && !CGit::ms_bCygwinGit && !CGit::ms_bMsys2Git;
+}
+
+void CGitBatchHelper::Stop()
+{
+	CAutoLocker lock(m_critSec);
+	StopProcess();
+}
+
+bool CGitBatchHelper::Start()
+{
+	StopProcess();
+
+	// RunAsync() remembers the process so that it can be killed by the user, which must not happen to this long-lived one
+	const PROCESS_INFORMATION currentGitPi = m_git.m_CurrentGitPi;
+	PROCESS_INFORMATION pi;
+	CAutoGeneralHandle hStderr;
+	const int ret = m_git.RunAsync(L"git.exe cat-file --batch-command", pi, m_hStdout.GetPointer(), hStderr.GetPointer(), nullptr, m_hStdin.GetPointer());
+	m_git.m_CurrentGitPi = currentGitPi;
+	if (ret)
+		return false;
+
+	CloseHandle(pi.hThread);
+	m_hProcess = std::move(pi.hProcess);
+	m_hStderrThread = CreateThread(nullptr, 0, DrainStderrThread, static_cast<HANDLE>(hStderr), 0, nullptr);
+	if (!m_hStderrThread)
+	{
+		StopProcess();
+		return false;
+	}
+	hStderr.Detach(); // now owned by the thread
+	m_directory = m_git.m_CurrentDir;
+	m_readBuffer.resize(READ_BUFFER_SIZE);
+	m_readPos = m_readEnd = 0;
+
+	if (!m_hIdleTimer && !CreateTimerQueueTimer(&m_hIdleTimer, nullptr, OnIdle, this, IDLE_TIMEOUT, IDLE_TIMEOUT, WT_EXECUTEDEFAULT))
+		m_hIdleTimer = nullptr;
+	return true;
+}
+
+void CGitBatchHelper::StopProcess()
+{
+	if (!m_hProcess)
+		return;
+
+	// git exits as soon as it sees the end of its input
+	m_hStdin.CloseHandle();
+	if (WaitForSingleObject(m_hProcess, 1000) == WAIT_TIMEOUT)
+		TerminateProcess(m_hProcess, 1);
+	m_hProcess.CloseHandle();
+	m_hStdout.CloseHandle();
+	// the pipe is broken as soon as git is gone
+	if (m_hStderrThread && WaitForSingleObject(m_hStderrThread, 1000) == WAIT_TIMEOUT)
+	{
+		CancelSynchronousIo(m_hStderrThread);
+		WaitForSingleObject(m_hStderrThread, INFINITE);
+	}
+	m_hStderrThread.CloseHandle();
+	m_directory.Empty();
+	m_readPos = m_readEnd = 0;
+}
+
+DWORD WINAPI CGitBatchHelper::DrainStderrThread(LPVOID lpParam)
+{
+	CAutoGeneralHandle hStderr(static_cast<HANDLE>(lpParam));
+	// git only writes warnings to stderr
+	char buffer[4096];
+	DWORD read = 0;
+	while (ReadFile(hStderr, buffer, sizeof(buffer), &read, nullptr) && read > 0)
+		CTraceToOutputDebugString::Instance()(__FUNCTION__ ": %s\n", static_cast<LPCSTR>(CStringA(buffer, read)));
+	return 0;
+}
+
+void CALLBACK CGitBatchHelper::OnIdle(PVOID parameter, BOOLEAN)
+{
+	auto helper = static_cast<CGitBatchHelper*>(parameter);
+	CAutoLocker lock(helper->m_critSec);
+	if (helper->m_hProcess && GetTickCount64() - helper->m_lastUse >= IDLE_TIMEOUT)
+		helper->StopProcess();
+}
+
+bool CGitBatchHelper::ReadLine(CStringA& line)
+{
+	line.Empty();
+	for (;;)
+	{
+		if (const auto eol = static_cast<const char*>(memchr(m_readBuffer.data() + m_readPos, '\n', m_readEnd - m_readPos)); eol)
+		{
+			const size_t length = eol - (m_readBuffer.data() + m_readPos);
+			line.Append(m_readBuffer.data() + m_readPos, static_cast<int>(length));
+			m_readPos += length + 1;
+			return true;
+		}
+		line.Append(m_readBuffer.data() + m_readPos, static_cast<int>(m_readEnd - m_readPos));
+		m_readPos = m_readEnd = 0;
+		DWORD read = 0;
+		if (!ReadFile(m_hStdout, m_readBuffer.data(), READ_BUFFER_SIZE, &read, nullptr) || read == 0)
+			return false;
+		m_readEnd = read;
+	}
+}
+
+bool CGitBatchHelper::Read(char* buffer, size_t size)
+{
+	const size_t buffered = min(size, m_readEnd - m_readPos);
+	memcpy(buffer, m_readBuffer.data() + m_readPos, buffered);
+	m_readPos += buffered;
+	// large objects are read directly into the target buffer
+	for (size_t pos = buffered; pos < size;)
+	{
+		DWORD read = 0;
+		if (!ReadFile(m_hStdout, buffer + pos, static_cast<DWORD>(min(size - pos, static_cast<size_t>(MAXDWORD))), &read, nullptr) || read == 0)
+			return false;
+		pos += read;
+	}
+	return true;
+}
+
+int CGitBatchHelper::Request(const CString& command, const CString& rev, CGitHash& hash, CStringA& type, size_t& size)
+{
+	// one request per line, so a revision containing a newline cannot be sent
+	if (rev.IsEmpty() || rev.FindOneOf(L"\r\n") >= 0)
+		return -1;
+
+	if (m_hProcess && (m_directory != m_git.m_CurrentDir || WaitForSingleObject(m_hProcess, 0) != WAIT_TIMEOUT))
+		StopProcess();
+	if (!m_hProcess && !Start())
+		return -1;
+
+	const CStringA request = CUnicodeUtils::GetUTF8(command + L' ' + rev) + '\n';
+	DWORD written = 0;
+	CStringA header;
+	if (!WriteFile(m_hStdin, request, request.GetLength(), &written, nullptr) || written != static_cast<DWORD>(request.GetLength()) || !ReadLine(header))
+	{
+		StopProcess();
+		return -1;
+	}
+	m_lastUse = GetTickCount64();
+
+	// "<oid> <type> <size>" or "<rev> missing"
+	const int typeStart = header.Find(' ') + 1;
+	const int sizeStart = header.ReverseFind(' ') + 1;
+	if (const CStringA last = header.Mid(sizeStart); last == "missing" || last == "ambiguous")
+		return 0;
+	bool isHash = false;
+	if (typeStart <= 0 || sizeStart <= typeStart)
+	{
+		StopProcess();
+		return -1;
+	}
+	hash = CGitHash::FromHexStr(header.Left(typeStart - 1), &isHash);
+	type = header.Mid(typeStart, sizeStart - typeStart - 1);
+	size = static_cast<size_t>(_atoi64(header.Mid(sizeStart)));
+	if (!isHash)
+	{
+		StopProcess();
+		return -1;
+	}
+	return 1;
+}
+
+int CGitBatchHelper::GetObjectInfo(const CString& rev, CGitHash& hash, CStringA& type)
+{
+	CAutoLocker lock(m_critSec);
+	size_t size = 0;
+	return Request(L"info", rev, hash, type, size);
+}
+
+int CGitBatchHelper::GetObjectContents(const CString& rev, CStringA& type, BYTE_VECTOR& content)
+{
+	CAutoLocker lock(m_critSec);
+	CGitHash hash;
+	size_t size = 0;
+	if (const int ret = Request(L"contents", rev, hash, type, size); ret != 1)
+		return ret;
+
+	// the contents are followed by a newline
+	content.resize(size + 1);
+	if (!Read(content.data(), size + 1))
+	{
+		StopProcess();
+		return -1;
+	}
+	content.resize(size);
+	return 1;
+}
+
+CGitBatchHelper::FileState CGitBatchHelper::GetFileState(const CString& path)
+{
+	FileState state;
+	state.path = path;
+	WIN32_FILE_ATTRIBUTE_DATA attributes;
+	if (GetFileAttributesEx(path, GetFileExInfoStandard, &attributes))
+	{
+		state.exists = true;
+		state.lastWrite = attributes.ftLastWriteTime;
+		state.size = (static_cast<ULONGLONG>(attributes.nFileSizeHigh) << 32) | attributes.nFileSizeLow;
+	}
+	return state;
+}
+
+void CGitBatchHelper::InvalidateConfig()
+{
+	CAutoLocker lock(m_critSec);
+	m_bConfigValid = false;
+}
+
+bool CGitBatchHelper::IsConfigUpToDate() const
+{
+	if (!m_bConfigValid || m_configDirectory != m_git.m_CurrentDir)
+		return false;
+	for (const auto& file : m_configFiles)
+	{
+		const auto current = GetFileState(file.path);
+		if (current.exists != file.exists || current.size != file.size || CompareFileTime(&current.lastWrite, &file.lastWrite) != 0)
+			return false;
+	}
+	return true;
+}
+
+bool CGitBatchHelper::ReadConfig()
+{
+	m_bConfigValid = false;
+	m_config.clear();
+	m_configFiles.clear();
+
+	const CString directory = m_git.m_CurrentDir;
+	// files which affect the config, even if they do not exist yet
+	std::vector<CString> files = { m_git.GetGitLocalConfig(), m_git.GetGitGlobalConfig(), m_git.GetGitGlobalXDGConfig(), m_git.GetGitSystemConfig() };
+	if (CString worktreeAdminDir; GitAdminDir::GetWorktreeAdminDirPath(directory, worktreeAdminDir))
+	{
+		files.push_back(worktreeAdminDir + L"config.worktree");
+		files.push_back(worktreeAdminDir + L"HEAD"); // for includeIf.onbranch
+	}
+	// take the states before reading, so that a change while reading is detected next time
+	const auto addFile = [this, &directory](CString path) {
+		path.Replace(L'/', L'\\');
+		if (PathIsRelative(path))
+			path = directory + L'\\' + path;
+		for (const auto& file : m_configFiles)
+		{
+			if (file.path.CompareNoCase(path) == 0)
+				return;
+		}
+		m_configFiles.push_back(GetFileState(path));
+	};
+	for (const auto& file : files)
+		addFile(file);
+
+	// records are "<origin>\0<name>\n<value>\0", or "<origin>\0<name>\0" for names without a value
+	BYTE_VECTOR output;
+	if (m_git.Run(L"git.exe config --list --show-origin -z", &output))
+		return false;
+
+	for (size_t pos = 0; pos < output.size();)
+	{
+		const size_t originEnd = output.find('\0', pos);
+		if (originEnd == BYTE_VECTOR::npos)
+			break;
+		const size_t entryEnd = output.find('\0', originEnd + 1);
+		if (entryEnd == BYTE_VECTOR::npos)
+			break;
+		const CStringA origin(&output[pos], static_cast<int>(originEnd - pos));
+		const CStringA entry(&output[originEnd + 1], static_cast<int>(entryEnd - originEnd - 1));
+		pos = entryEnd + 1;
+
+		CString originFile;
+		if (CStringUtils::StartsWith(origin, "file:"))
+		{
+			originFile = CUnicodeUtils::GetUnicode(origin.Mid(static_cast<int>(strlen("file:"))));
+			addFile(originFile);
+		}
+
+		const int newline = entry.Find('\n');
+		const CString name = CUnicodeUtils::GetUnicode(newline >= 0 ? entry.Left(newline) : entry);
+		const CString value = newline >= 0 ? CUnicodeUtils::GetUnicode(entry.Mid(newline + 1)) : CString();
+		m_config[name] = { value, newline >= 0 };
+
+		// included files are only listed as origin if they exist, but creating them changes the config
+		if (newline >= 0 && !value.IsEmpty() && (name == L"include.path" || (CStringUtils::StartsWith(name, L"includeif.") && CStringUtils::EndsWith(name, L".path"))))
+		{
+			CString includePath = value;
+			if (CStringUtils::StartsWith(includePath, L"~/"))
+				includePath = m_git.GetHomeDirectory() + includePath.Mid(1);
+			else if (PathIsRelative(includePath) && !originFile.IsEmpty())
+			{
+				originFile.Replace(L'/', L'\\');
+				includePath = originFile.Left(originFile.ReverseFind(L'\\') + 1) + includePath;
+			}
+			addFile(includePath);
+		}
+	}
+
+	m_configDirectory = directory;
+	m_bConfigValid = true;
+	return true;
+}
+
+int CGitBatchHelper::GetConfigValue(const CString& name, bool wantBool, CString& value)
+{
+	CAutoLocker lock(m_critSec);
+	if (!IsConfigUpToDate() && !ReadConfig())
+		return -1;
+
+	// section and key are case insensitive, the subsection is not
+	const int firstDot = name.Find(L'.');
+	const int lastDot = name.ReverseFind(L'.');
+	if (firstDot <= 0 || lastDot == name.GetLength() - 1)
+		return -1;
+	CString normalized = name.Left(firstDot).MakeLower() + name.Mid(firstDot, lastDot - firstDot) + name.Mid(lastDot).MakeLower();
+
+	const auto it = m_config.find(normalized);
+	if (it == m_config.cend())
+		return 0;
+
+	const auto& [configValue, hasValue] = it->second;
+	if (!wantBool)
+	{
+		value = configValue;
+		return 1;
+	}
+
+	// "git config --bool" prints the canonical values and fails for invalid ones
+	int parsed = 1;
+	if (hasValue && git_config_parse_bool(&parsed, CUnicodeUtils::GetUTF8(configValue)))
+		return 0;
+	value = parsed ? L"true" : L"false";
+	return 1;
+}
@@ -0,0 +1,105 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include "GitHash.h"
+#include "gittype.h"
+#include "SmartHandle.h"
+
+class CGit;
+
+/**
+ * Answers object and config queries of CGit without starting a git.exe for
+ * each of them, used if neither libgit2 nor gitdll is used.
+ *
+ * Objects are looked up by a "git cat-file --batch-command" process which is
+ * kept running for the working tree. It is stopped after some idle time, so
+ * that it does not keep pack files open which "git gc" wants to delete.
+ *
+ * The config is read at once by "git config --list" and read again as soon as
+ * one of the config files (or included files) changes.
+ */
+class CGitBatchHelper
+{
+public:
+	explicit CGitBatchHelper(CGit& git) : m_git(git) {}
+	~CGitBatchHelper();
+	CGitBatchHelper(const CGitBatchHelper&) = delete;
+	CGitBatchHelper& operator=(const CGitBatchHelper&) = delete;
+
+	static bool		IsSupported();
+
+	/// \return 1 if \a rev was resolved, 0 if there is no such object, -1 if the helper cannot be used
+	int				GetObjectInfo(const CString& rev, CGitHash& hash, CStringA& type);
+	/// \return 1 if the object \a rev was read, 0 if there is no such object, -1 if the helper cannot be used
+	int				GetObjectContents(const CString& rev, CStringA& type, BYTE_VECTOR& content);
+	/**
+	 * Looks up a config value like "git config [--bool] <name>".
+	 * \return 1 if \a name is set, 0 if not, -1 if the helper cannot be used
+	 */
+	int				GetConfigValue(const CString& name, bool wantBool, CString& value);
+	/// has to be called after the config was changed by this process
+	void			InvalidateConfig();
+
+	/// stops the cat-file process, it is started again on demand
+	void			Stop();
+
+private:
+	static constexpr DWORD IDLE_TIMEOUT = 10000;
+
+	bool			Start();
+	void			StopProcess();
+	/// sends \a command and parses the header "<oid> <type> <size>" of the answer
+	int				Request(const CString& command, const CString& rev, CGitHash& hash, CStringA& type, size_t& size);
+	bool			ReadLine(CStringA& line);
+	bool			Read(char* buffer, size_t size);
+	static void CALLBACK OnIdle(PVOID parameter, BOOLEAN);
+	/// reads stderr until git exits, so that git never blocks on a full stderr pipe while we wait for stdout; owns the pipe handle \a lpParam
+	static DWORD WINAPI DrainStderrThread(LPVOID lpParam);
+
+	bool			IsConfigUpToDate() const;
+	bool			ReadConfig();
+
+	CGit&				m_git;
+	CComAutoCriticalSection	m_critSec;
+
+	CString				m_directory;
+	CAutoGeneralHandle	m_hProcess;
+	CAutoGeneralHandle	m_hStdin;
+	CAutoGeneralHandle	m_hStdout;
+	CAutoGeneralHandle	m_hStderrThread;
+	HANDLE				m_hIdleTimer = nullptr;
+	ULONGLONG			m_lastUse = 0;
+	std::vector<char>	m_readBuffer;
+	size_t				m_readPos = 0;
+	size_t				m_readEnd = 0;
+
+	struct FileState
+	{
+		CString		path;
+		bool		exists = false;
+		FILETIME	lastWrite{};
+		ULONGLONG	size = 0;
+	};
+	static FileState	GetFileState(const CString& path);
+
+	CString				m_configDirectory;
+	std::map<CString, std::pair<CString, bool>>	m_config;	///< name (section and key in lower case) vs. (last value, has a value)
+	std::vector<FileState>	m_configFiles;
+	bool				m_bConfigValid = false;
+};
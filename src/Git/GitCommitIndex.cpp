@@ -0,0 +1,588 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "GitCommitIndex.h"
+#include "SmartHandle.h"
+#include "SmartLibgit2Ref.h"
+#include <queue>
+
+#define COMMITINDEX_FILE_NAME L"tortoisegit.commitindex"
+#define COMMITINDEX_MAGIC 0x49434754 // "TGCI"
+#define COMMITINDEX_VERSION 2
+#define COMMITINDEX_BITMAPS_FILE_NAME L"tortoisegit.commitindex-bitmaps"
+#define COMMITINDEX_BITMAPS_MAGIC 0x42434754 // "TGCB"
+#define COMMITINDEX_BITMAPS_VERSION 1
+
+/*
+ * File format: magic and version (UINT32 each) and the id of the index
+ * (UINT64), followed by one record per commit in index order: the raw hash,
+ * the number of parents (UINT32) and the positions of the parents (UINT32 each).
+ *
+ * Bitmap file format: magic and version (UINT32 each), the id of the index
+ * the positions refer to (UINT64) and the number of bitmaps (UINT32),
+ * followed by one record per bitmap: the length of the ref name (UINT32),
+ * the ref name (UTF-16), the raw hash of the tip, the number of runs (UINT32)
+ * and the ends of the runs (UINT32 each).
+ */
+
+static UINT64 NewIndexId()
+{
+	FILETIME now;
+	GetSystemTimeAsFileTime(&now);
+	return (static_cast<UINT64>(now.dwHighDateTime) << 32 | now.dwLowDateTime) ^ (static_cast<UINT64>(GetCurrentProcessId()) << 40);
+}
+
+void CGitCommitIndex::Load(const CString& adminDir)
+{
+	m_adminDir = adminDir;
+	m_filename.Empty();
+	m_indexId = 0;
+	m_hashes.clear();
+	m_generations.clear();
+	m_parentOffsets.assign(1, 0);
+	m_parents.clear();
+	m_positions.clear();
+	m_savedCount = 0;
+	m_savedSize = 0;
+	m_bNeedsRewrite = false;
+	m_bitmaps.clear();
+	m_bBitmapsChanged = false;
+
+	if (adminDir.IsEmpty() || PathFileExists(adminDir + L"shallow"))
+		return;
+	m_filename = adminDir + COMMITINDEX_FILE_NAME;
+
+	CAutoFILE pFile = _wfsopen(m_filename, L"rb", _SH_DENYWR);
+	if (!pFile)
+		return;
+
+	auto read = [&pFile](auto& value) { return fread(&value, sizeof(value), 1, pFile) == 1; };
+	UINT32 value = 0;
+	if (!read(value) || value != COMMITINDEX_MAGIC || !read(value) || value != COMMITINDEX_VERSION || !read(m_indexId))
+	{
+		m_indexId = 0;
+		m_bNeedsRewrite = true;
+		return;
+	}
+
+	// a record which is incomplete or does not fit (e.g. written by two processes at once) ends the index
+	std::vector<UINT32> parents;
+	LONGLONG recordStart = _ftelli64(pFile);
+	for (;; recordStart = _ftelli64(pFile))
+	{
+		unsigned char rawHash[GIT_HASH_SIZE];
+		UINT32 parentCount = 0;
+		if (fread(rawHash, sizeof(rawHash), 1, pFile) != 1)
+		{
+			m_bNeedsRewrite = _ftelli64(pFile) != recordStart;
+			break;
+		}
+		if (!read(parentCount) || parentCount > 0xFFFF)
+		{
+			m_bNeedsRewrite = true;
+			break;
+		}
+		parents.resize(parentCount);
+		if (parentCount && fread(parents.data(), sizeof(UINT32), parentCount, pFile) != parentCount)
+		{
+			m_bNeedsRewrite = true;
+			break;
+		}
+		const auto hash = CGitHash::FromRaw(rawHash);
+		if (Find(hash) != NOT_INDEXED || std::any_of(parents.cbegin(), parents.cend(), [this](UINT32 parent) { return parent >= m_hashes.size(); }))
+		{
+			m_bNeedsRewrite = true;
+			break;
+		}
+		Add(hash, parents);
+	}
+	m_savedCount = m_hashes.size();
+	m_savedSize = recordStart; // only the valid records
+	pFile.CloseHandle();
+
+	LoadBitmaps();
+}
+
+UINT32 CGitCommitIndex::Find(const CGitHash& hash) const
+{
+	if (auto it = m_positions.find(hash); it != m_positions.cend())
+		return it->second;
+	return NOT_INDEXED;
+}
+
+void CGitCommitIndex::Add(const CGitHash& hash, const std::vector<UINT32>& parents)
+{
+	UINT32 generation = 1;
+	for (auto parent : parents)
+		generation = max(generation, m_generations[parent] + 1);
+
+	m_positions.emplace(hash, static_cast<UINT32>(m_hashes.size()));
+	m_hashes.push_back(hash);
+	m_generations.push_back(generation);
+	m_parents.insert(m_parents.end(), parents.cbegin(), parents.cend());
+	m_parentOffsets.push_back(static_cast<UINT32>(m_parents.size()));
+}
+
+UINT32 CGitCommitIndex::GetGeneration(const CGitHash& hash) const
+{
+	const UINT32 pos = Find(hash);
+	return pos == NOT_INDEXED ? 0 : m_generations[pos];
+}
+
+bool CGitCommitIndex::Update(git_repository* repo, const std::vector<CGitHash>& tips, size_t maxNewCommits, const volatile LONG* pbCancel)
+{
+	if (!IsEnabled())
+		return false;
+
+	// depth first, so that all parents of a commit are indexed before the commit itself
+	std::vector<PendingCommit> pending;
+	size_t lookups = 0;
+	auto push = [&pending, &lookups, maxNewCommits, pbCancel, repo](const CGitHash& hash) {
+		if (lookups++ >= maxNewCommits || (pbCancel && *pbCancel))
+			return false;
+		CAutoCommit commit;
+		if (git_commit_lookup(commit.GetPointer(), repo, hash))
+			return false;
+		PendingCommit pendingCommit;
+		pendingCommit.hash = hash;
+		const unsigned int parentCount = git_commit_parentcount(commit);
+		pendingCommit.parents.reserve(parentCount);
+		for (unsigned int i = 0; i < parentCount; ++i)
+			pendingCommit.parents.emplace_back(git_commit_parent_id(commit, i));
+		pending.push_back(std::move(pendingCommit));
+		return true;
+	};
+	std::vector<UINT32> parents;
+	auto walk = [&]() {
+		while (!pending.empty())
+		{
+			if (auto& top = pending.back(); top.nextParent < top.parents.size())
+			{
+				// a pushed parent is checked again once it is indexed, it might be reachable on several paths
+				if (Find(top.parents[top.nextParent]) != NOT_INDEXED)
+					++top.nextParent;
+				else if (!push(top.parents[top.nextParent]))
+					return false;
+				continue;
+			}
+			// the history is acyclic, so a commit on the stack cannot have been indexed in the meantime
+			const auto& top = pending.back();
+			parents.clear();
+			for (const auto& parent : top.parents)
+				parents.push_back(Find(parent));
+			Add(top.hash, parents);
+			pending.pop_back();
+		}
+		return true;
+	};
+
+	bool ok = true;
+	for (size_t i = 0; ok && i < tips.size(); ++i)
+	{
+		if (tips[i].IsEmpty() || Find(tips[i]) != NOT_INDEXED)
+			continue;
+		ok = push(tips[i]) && walk();
+	}
+	return ok;
+}
+
+bool CGitCommitIndex::Save()
+{
+	if (!IsEnabled())
+		return true;
+	if ((m_savedCount != m_hashes.size() || m_bNeedsRewrite) && !SaveCommits())
+		return false;
+	// the bitmaps may only refer to stored commits, other processes might append different ones
+	return !m_bBitmapsChanged || SaveBitmaps();
+}
+
+bool CGitCommitIndex::SaveCommits()
+{
+	if (!m_bNeedsRewrite && m_savedCount > 0)
+	{
+		CAutoFILE pFile = _wfsopen(m_filename, L"r+b", _SH_DENYRW);
+		if (!pFile)
+			return false;
+		// another process has changed the index, ours is complete for this process, so it replaces the stored one
+		UINT32 header[2] = { 0 };
+		UINT64 indexId = 0;
+		if (fread(header, sizeof(header), 1, pFile) != 1 || fread(&indexId, sizeof(indexId), 1, pFile) != 1 || indexId != m_indexId || _fseeki64(pFile, 0, SEEK_END) || _ftelli64(pFile) != m_savedSize)
+		{
+			pFile.CloseHandle();
+			return Rewrite();
+		}
+
+		bool ok = true;
+		for (size_t i = m_savedCount; ok && i < m_hashes.size(); ++i)
+		{
+			const UINT32 parentCount = m_parentOffsets[i + 1] - m_parentOffsets[i];
+			ok = fwrite(m_hashes[i].ToRaw(), GIT_HASH_SIZE, 1, pFile) == 1 && fwrite(&parentCount, sizeof(parentCount), 1, pFile) == 1;
+			ok = ok && (!parentCount || fwrite(&m_parents[m_parentOffsets[i]], sizeof(UINT32), parentCount, pFile) == parentCount);
+		}
+		if (!ok || fflush(pFile))
+		{
+			m_bNeedsRewrite = true;
+			return false;
+		}
+		m_savedCount = m_hashes.size();
+		m_savedSize = _ftelli64(pFile);
+		return true;
+	}
+
+	return Rewrite();
+}
+
+bool CGitCommitIndex::Rewrite()
+{
+	// write to a temporary file first, so that readers never see a partial index
+	const CString tempPath = m_filename + L".tmp";
+	const UINT64 indexId = NewIndexId();
+	LONGLONG size = 0;
+	{
+		CAutoFILE pFile = _wfsopen(tempPath, L"wb", _SH_DENYRW);
+		if (!pFile)
+			return false;
+
+		bool ok = true;
+		auto write = [&pFile, &ok](const auto& value) { ok = ok && fwrite(&value, sizeof(value), 1, pFile) == 1; };
+		write(static_cast<UINT32>(COMMITINDEX_MAGIC));
+		write(static_cast<UINT32>(COMMITINDEX_VERSION));
+		write(indexId);
+		for (size_t i = 0; ok && i < m_hashes.size(); ++i)
+		{
+			const UINT32 parentCount = m_parentOffsets[i + 1] - m_parentOffsets[i];
+			ok = fwrite(m_hashes[i].ToRaw(), GIT_HASH_SIZE, 1, pFile) == 1;
+			write(parentCount);
+			ok = ok && (!parentCount || fwrite(&m_parents[m_parentOffsets[i]], sizeof(UINT32), parentCount, pFile) == parentCount);
+		}
+		if (!ok || fflush(pFile))
+		{
+			pFile.CloseHandle();
+			DeleteFile(tempPath);
+			return false;
+		}
+		size = _ftelli64(pFile);
+	}
+	if (!MoveFileEx(tempPath, m_filename, MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFile(tempPath);
+		return false;
+	}
+	m_indexId = indexId;
+	m_savedCount = m_hashes.size();
+	m_savedSize = size;
+	m_bNeedsRewrite = false;
+	// the stored bitmaps refer to the old id
+	m_bBitmapsChanged = !m_bitmaps.empty();
+	return true;
+}
+
+void CGitCommitIndex::LoadBitmaps()
+{
+	CAutoFILE pFile = _wfsopen(m_adminDir + COMMITINDEX_BITMAPS_FILE_NAME, L"rb", _SH_DENYWR);
+	if (!pFile)
+		return;
+
+	// the bitmaps are a cache, anything which does not fit the loaded index is dropped
+	auto read = [&pFile](auto& value) { return fread(&value, sizeof(value), 1, pFile) == 1; };
+	UINT32 value = 0;
+	UINT64 indexId = 0;
+	UINT32 bitmapCount = 0;
+	if (!read(value) || value != COMMITINDEX_BITMAPS_MAGIC || !read(value) || value != COMMITINDEX_BITMAPS_VERSION || !read(indexId) || indexId != m_indexId || !read(bitmapCount))
+		return;
+
+	std::vector<wchar_t> name;
+	for (UINT32 i = 0; i < bitmapCount; ++i)
+	{
+		UINT32 nameLength = 0;
+		if (!read(nameLength) || nameLength > 0xFFFF)
+			return;
+		name.resize(nameLength);
+		unsigned char rawHash[GIT_HASH_SIZE];
+		UINT32 runCount = 0;
+		if (fread(name.data(), sizeof(wchar_t), nameLength, pFile) != nameLength || fread(rawHash, sizeof(rawHash), 1, pFile) != 1 || !read(runCount) || !runCount || runCount > m_hashes.size() + 1)
+			return;
+		Bitmap bitmap;
+		bitmap.tip = CGitHash::FromRaw(rawHash);
+		bitmap.runEnds.resize(runCount);
+		if (fread(bitmap.runEnds.data(), sizeof(UINT32), runCount, pFile) != runCount || !std::is_sorted(bitmap.runEnds.cbegin(), bitmap.runEnds.cend()) || bitmap.runEnds.back() > m_hashes.size())
+			return;
+		if (const UINT32 tipPos = Find(bitmap.tip); tipPos == NOT_INDEXED || !bitmap.Get(tipPos))
+			return;
+		m_bitmaps.emplace(CString(name.data(), static_cast<int>(nameLength)), std::move(bitmap));
+	}
+}
+
+bool CGitCommitIndex::SaveBitmaps()
+{
+	const CString filename = m_adminDir + COMMITINDEX_BITMAPS_FILE_NAME;
+	const CString tempPath = filename + L".tmp";
+	{
+		CAutoFILE pFile = _wfsopen(tempPath, L"wb", _SH_DENYRW);
+		if (!pFile)
+			return false;
+
+		bool ok = true;
+		auto write = [&pFile, &ok](const auto& value) { ok = ok && fwrite(&value, sizeof(value), 1, pFile) == 1; };
+		write(static_cast<UINT32>(COMMITINDEX_BITMAPS_MAGIC));
+		write(static_cast<UINT32>(COMMITINDEX_BITMAPS_VERSION));
+		write(m_indexId);
+		write(static_cast<UINT32>(m_bitmaps.size()));
+		for (const auto& [name, bitmap] : m_bitmaps)
+		{
+			write(static_cast<UINT32>(name.GetLength()));
+			ok = ok && fwrite(static_cast<LPCWSTR>(name), sizeof(wchar_t), name.GetLength(), pFile) == static_cast<size_t>(name.GetLength());
+			ok = ok && fwrite(bitmap.tip.ToRaw(), GIT_HASH_SIZE, 1, pFile) == 1;
+			write(static_cast<UINT32>(bitmap.runEnds.size()));
+			ok = ok && fwrite(bitmap.runEnds.data(), sizeof(UINT32), bitmap.runEnds.size(), pFile) == bitmap.runEnds.size();
+		}
+		if (!ok || fflush(pFile))
+		{
+			pFile.CloseHandle();
+			DeleteFile(tempPath);
+			return false;
+		}
+	}
+	if (!MoveFileEx(tempPath, filename, MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFile(tempPath);
+		return false;
+	}
+	m_bBitmapsChanged = false;
+	return true;
+}
+
+int CGitCommitIndex::IsAncestor(const CGitHash& ancestor, const CGitHash& descendant) const
+{
+	const UINT32 ancestorPos = Find(ancestor);
+	const UINT32 descendantPos = Find(descendant);
+	if (ancestorPos == NOT_INDEXED || descendantPos == NOT_INDEXED)
+		return -1;
+	if (ancestorPos == descendantPos)
+		return 1;
+	// ancestors are always indexed before their descendants
+	if (ancestorPos > descendantPos || m_generations[descendantPos] <= m_generations[ancestorPos])
+		return 0;
+
+	// commits with a generation not above the one of the ancestor cannot lead to it
+	const UINT32 minGeneration = m_generations[ancestorPos];
+	std::vector<bool> visited(descendantPos + 1);
+	std::vector<UINT32> stack = { descendantPos };
+	while (!stack.empty())
+	{
+		const UINT32 pos = stack.back();
+		stack.pop_back();
+		for (UINT32 i = m_parentOffsets[pos]; i < m_parentOffsets[pos + 1]; ++i)
+		{
+			const UINT32 parent = m_parents[i];
+			if (parent == ancestorPos)
+				return 1;
+			if (m_generations[parent] <= minGeneration || parent < ancestorPos || visited[parent])
+				continue;
+			visited[parent] = true;
+			stack.push_back(parent);
+		}
+	}
+	return 0;
+}
+
+bool CGitCommitIndex::GetMergeBase(const CGitHash& one, const CGitHash& two, CGitHash& base) const
+{
+	const UINT32 onePos = Find(one);
+	const UINT32 twoPos = Find(two);
+	if (onePos == NOT_INDEXED || twoPos == NOT_INDEXED)
+		return false;
+	if (onePos == twoPos)
+	{
+		base = one;
+		return true;
+	}
+
+	// paint the history of both commits, in the order of decreasing generations all descendants
+	// of a commit are processed before the commit itself, so the flags of a commit are complete
+	// when it is taken from the queue and common ancestors of a found merge base become stale
+	enum : BYTE
+	{
+		PARENT1 = 0x1,
+		PARENT2 = 0x2,
+		STALE = 0x4,
+		QUEUED = 0x8,
+	};
+	std::vector<BYTE> flags(max(onePos, twoPos) + 1);
+	std::priority_queue<std::pair<UINT32, UINT32>> queue; // generation, position
+	size_t nonStaleQueued = 0;
+	auto enqueue = [&](UINT32 pos, BYTE newFlags) {
+		BYTE& f = flags[pos];
+		if (f & QUEUED)
+		{
+			if ((newFlags & STALE) && !(f & STALE))
+				--nonStaleQueued;
+			f |= newFlags;
+			return;
+		}
+		f |= newFlags | QUEUED;
+		if (!(f & STALE))
+			++nonStaleQueued;
+		queue.emplace(m_generations[pos], pos);
+	};
+	enqueue(onePos, PARENT1);
+	enqueue(twoPos, PARENT2);
+
+	std::vector<UINT32> results;
+	while (nonStaleQueued > 0 && !queue.empty())
+	{
+		const UINT32 pos = queue.top().second;
+		queue.pop();
+		BYTE f = flags[pos] & ~QUEUED;
+		flags[pos] = f;
+		if (!(f & STALE))
+			--nonStaleQueued;
+		if ((f & (PARENT1 | PARENT2)) == (PARENT1 | PARENT2) && !(f & STALE))
+		{
+			results.push_back(pos);
+			f |= STALE;
+		}
+		for (UINT32 i = m_parentOffsets[pos]; i < m_parentOffsets[pos + 1]; ++i)
+			enqueue(m_parents[i], f);
+	}
+
+	if (results.size() != 1)
+		return false;
+	base = m_hashes[results.front()];
+	return true;
+}
+
+bool CGitCommitIndex::GetContaining(const CGitHash& commit, const std::vector<CGitHash>& tips, std::vector<bool>& contains) const
+{
+	const UINT32 commitPos = Find(commit);
+	if (commitPos == NOT_INDEXED)
+		return false;
+	std::vector<UINT32> tipPositions;
+	tipPositions.reserve(tips.size());
+	UINT32 lastPos = commitPos;
+	for (const auto& tip : tips)
+	{
+		const UINT32 pos = Find(tip);
+		if (pos == NOT_INDEXED)
+			return false;
+		tipPositions.push_back(pos);
+		if (pos > lastPos)
+			lastPos = pos;
+	}
+
+	// descendants are indexed after the commit, so one pass in index order marks all of them up to the last tip
+	const UINT32 minGeneration = m_generations[commitPos];
+	std::vector<bool> reaches(lastPos - commitPos + 1);
+	reaches[0] = true;
+	for (UINT32 pos = commitPos + 1; pos <= lastPos; ++pos)
+	{
+		if (m_generations[pos] <= minGeneration)
+			continue;
+		for (UINT32 i = m_parentOffsets[pos]; i < m_parentOffsets[pos + 1]; ++i)
+		{
+			if (m_parents[i] >= commitPos && reaches[m_parents[i] - commitPos])
+			{
+				reaches[pos - commitPos] = true;
+				break;
+			}
+		}
+	}
+
+	contains.resize(tips.size());
+	for (size_t i = 0; i < tipPositions.size(); ++i)
+		contains[i] = tipPositions[i] >= commitPos && reaches[tipPositions[i] - commitPos];
+	return true;
+}
+
+const CGitCommitIndex::Bitmap* CGitCommitIndex::GetReachabilityBitmap(const CString& baseRef, const CGitHash& tip) const
+{
+	const UINT32 tipPos = Find(tip);
+	if (tipPos == NOT_INDEXED)
+		return nullptr;
+
+	// commits indexed after the tip cannot be reachable from it, so the bitmap of an unchanged tip is up to date
+	auto& bitmap = m_bitmaps[baseRef];
+	if (bitmap.tip == tip && !bitmap.runEnds.empty())
+		return &bitmap;
+
+	std::vector<bool> reachable;
+	if (!bitmap.tip.IsEmpty() && IsAncestor(bitmap.tip, tip) == 1)
+		bitmap.Decode(reachable);
+	reachable.resize(m_hashes.size());
+
+	// stops at commits which are already marked, so a ref which moved forward only costs the new commits
+	std::vector<UINT32> stack;
+	if (!reachable[tipPos])
+	{
+		reachable[tipPos] = true;
+		stack.push_back(tipPos);
+	}
+	while (!stack.empty())
+	{
+		const UINT32 pos = stack.back();
+		stack.pop_back();
+		for (UINT32 i = m_parentOffsets[pos]; i < m_parentOffsets[pos + 1]; ++i)
+		{
+			if (reachable[m_parents[i]])
+				continue;
+			reachable[m_parents[i]] = true;
+			stack.push_back(m_parents[i]);
+		}
+	}
+	bitmap.tip = tip;
+	bitmap.Encode(reachable);
+	m_bBitmapsChanged = true;
+	return &bitmap;
+}
+
+int CGitCommitIndex::IsReachable(const Bitmap& bitmap, const CGitHash& commit) const
+{
+	const UINT32 pos = Find(commit);
+	if (pos == NOT_INDEXED)
+		return -1;
+	return bitmap.Get(pos) ? 1 : 0;
+}
+
+bool CGitCommitIndex::Bitmap::Get(UINT32 pos) const
+{
+	const auto it = std::upper_bound(runEnds.cbegin(), runEnds.cend(), pos);
+	return it != runEnds.cend() && (it - runEnds.cbegin()) % 2 == 1;
+}
+
+void CGitCommitIndex::Bitmap::Decode(std::vector<bool>& reachable) const
+{
+	reachable.assign(runEnds.empty() ? 0 : runEnds.back(), false);
+	for (size_t i = 1; i < runEnds.size(); i += 2)
+		std::fill(reachable.begin() + runEnds[i - 1], reachable.begin() + runEnds[i], true);
+}
+
+void CGitCommitIndex::Bitmap::Encode(const std::vector<bool>& reachable)
+{
+	// the history of a branch mostly consists of long runs of reachable commits
+	runEnds.clear();
+	bool value = false;
+	for (UINT32 pos = 0; pos < reachable.size(); ++pos)
+	{
+		if (reachable[pos] == value)
+			continue;
+		runEnds.push_back(pos);
+		value = !value;
+	}
+	runEnds.push_back(static_cast<UINT32>(reachable.size()));
+}
@@ -0,0 +1,131 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include "GitHash.h"
+#include <unordered_map>
+
+/**
+ * Index of the commit graph for answering ancestry queries without walking
+ * the history again and again.
+ *
+ * Every indexed commit gets a position, its parents always have lower
+ * positions, and a generation number which is one more than the highest
+ * generation of its parents (root commits have generation 1). A commit
+ * can only be an ancestor of commits with a higher generation, which
+ * limits the walks.
+ *
+ * The index is stored in the admin directory and new commits are appended
+ * to it. It is not used for shallow repositories, because their parents
+ * change when they are deepened.
+ *
+ * Reachability bitmaps are stored run-length encoded next to the index.
+ * They refer to the id of the index, which changes whenever the index is
+ * written anew, because only appending keeps the positions.
+ */
+class CGitCommitIndex
+{
+public:
+	CGitCommitIndex() = default;
+	CGitCommitIndex(const CGitCommitIndex&) = delete;
+	CGitCommitIndex& operator=(const CGitCommitIndex&) = delete;
+
+	/// loads the index of the repository with the admin directory \a adminDir (an empty index if there is none yet)
+	void			Load(const CString& adminDir);
+	bool			IsEnabled() const { return !m_filename.IsEmpty(); }
+	const CString&	GetAdminDir() const { return m_adminDir; }
+
+	/**
+	 * Adds the history of \a tips which is not indexed yet, but reads at most \a maxNewCommits commits.
+	 * A commit is only added after all of its parents, so a walk which stops early might not have added
+	 * anything (e.g. in a long linear history). The walk is not continued by the next call.
+	 * \param pbCancel if not nullptr, the walk stops as soon as it is set
+	 * \return false if a commit cannot be read, if more commits are missing or if the walk was cancelled, the commits indexed so far stay valid
+	 */
+	bool			Update(git_repository* repo, const std::vector<CGitHash>& tips, size_t maxNewCommits = SIZE_MAX, const volatile LONG* pbCancel = nullptr);
+	/// appends the commits added since the last Load() or Save() to the stored index and stores the changed bitmaps
+	bool			Save();
+
+	size_t			GetCount() const { return m_hashes.size(); }
+	/// 0 if the commit is not indexed
+	UINT32			GetGeneration(const CGitHash& hash) const;
+
+	/// \return 1 if \a ancestor is \a descendant or one of its ancestors, 0 if not, -1 if one of them is not indexed
+	int				IsAncestor(const CGitHash& ancestor, const CGitHash& descendant) const;
+	/**
+	 * Finds the best common ancestor of \a one and \a two.
+	 * \return false if one of them is not indexed, if there is no common ancestor or if there are several best common ancestors
+	 */
+	bool			GetMergeBase(const CGitHash& one, const CGitHash& two, CGitHash& base) const;
+	/**
+	 * Checks for all \a tips at once whether \a commit is one of their ancestors (or the tip itself).
+	 * \return false if \a commit or one of the tips is not indexed
+	 */
+	bool			GetContaining(const CGitHash& commit, const std::vector<CGitHash>& tips, std::vector<bool>& contains) const;
+
+	/// commits reachable from a ref, indexed by position
+	struct Bitmap
+	{
+		CGitHash			tip;
+		std::vector<UINT32>	runEnds;	///< run i ends before position runEnds[i], odd runs are reachable, positions behind the last run are not
+
+		bool	Get(UINT32 pos) const;
+		void	Decode(std::vector<bool>& reachable) const;
+		void	Encode(const std::vector<bool>& reachable);
+	};
+	/**
+	 * Returns the cached bitmap of \a baseRef (e.g. "HEAD" or a release branch) brought up to date with \a tip.
+	 * If the ref moved forward only the new commits are walked, otherwise the bitmap is computed again.
+	 * The bitmaps are stored by the next Save().
+	 * \return nullptr if \a tip is not indexed
+	 */
+	const Bitmap*	GetReachabilityBitmap(const CString& baseRef, const CGitHash& tip) const;
+	/// \return 1 if \a commit is reachable, 0 if not, -1 if it is not indexed
+	int				IsReachable(const Bitmap& bitmap, const CGitHash& commit) const;
+
+private:
+	static constexpr UINT32 NOT_INDEXED = UINT32_MAX;
+
+	struct PendingCommit
+	{
+		CGitHash				hash;
+		std::vector<CGitHash>	parents;
+		size_t					nextParent = 0;
+	};
+
+	UINT32			Find(const CGitHash& hash) const;
+	void			Add(const CGitHash& hash, const std::vector<UINT32>& parents);
+	bool			SaveCommits();
+	bool			Rewrite();
+	void			LoadBitmaps();
+	bool			SaveBitmaps();
+
+	CString					m_adminDir;
+	CString					m_filename;
+	UINT64					m_indexId = 0;			///< changes whenever the stored index is written anew
+	std::vector<CGitHash>	m_hashes;
+	std::vector<UINT32>		m_generations;
+	std::vector<UINT32>		m_parentOffsets = { 0 };	///< the parents of commit i are m_parents[m_parentOffsets[i]] ... m_parents[m_parentOffsets[i + 1] - 1]
+	std::vector<UINT32>		m_parents;
+	std::unordered_map<CGitHash, UINT32>	m_positions;
+	size_t					m_savedCount = 0;		///< number of commits in the stored index
+	LONGLONG				m_savedSize = 0;		///< size of the stored index, used to detect changes by other processes
+	bool					m_bNeedsRewrite = false;
+	mutable std::map<CString, Bitmap>	m_bitmaps;
+	mutable bool			m_bBitmapsChanged = false;
+};
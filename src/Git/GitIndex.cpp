@@ -204,8 +204,12 @@ int CGitIndexList::ReadIncomingOutgoing(git_repository* repository)
 	if (git_branch_upstream_name(upstreambranchname, repository, git_reference_name(head)) != 0 || git_reference_name_to_id(&upstream, repository, upstreambranchname->ptr) != 0)
 		return 0; // we don't have an upstream branch
 
-	if (git_graph_ahead_behind(&m_outgoing, &m_incoming, repository, git_reference_target(head), &upstream) < 0)
+	// the index is reloaded on every change of the working tree, but head and upstream rarely move, so the counts are cached
+	std::vector<std::pair<size_t, size_t>> aheadBehind;
+	if (CGit::GetAheadBehind(repository, { { CGitHash(git_reference_target(head)), CGitHash(upstream) } }, aheadBehind) < 0)
 		return -1;
+	m_outgoing = aheadBehind[0].first;
+	m_incoming = aheadBehind[0].second;
 
 	return 0;
 }
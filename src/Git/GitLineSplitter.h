@@ -0,0 +1,69 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include <string>
+#include <string_view>
+
+/**
+ * Splits data which arrives in chunks (e.g. the output of git.exe) into lines.
+ *
+ * Lines which are completely contained in a chunk are handed out as views into
+ * the chunk, only the incomplete line at the end of a chunk is kept until the
+ * next chunk arrives. So every byte is looked at and copied at most once.
+ * The views are only valid during the callback, the '\n' is not part of them.
+ */
+class CGitLineSplitter
+{
+public:
+	template <typename LineFunc>
+	void Feed(const char* data, size_t size, LineFunc&& onLine)
+	{
+		std::string_view chunk(data, size);
+		if (!m_pending.empty())
+		{
+			const size_t eol = chunk.find('\n');
+			if (eol == std::string_view::npos)
+			{
+				m_pending.append(chunk);
+				return;
+			}
+			m_pending.append(chunk.substr(0, eol));
+			onLine(std::string_view(m_pending));
+			m_pending.clear();
+			chunk.remove_prefix(eol + 1);
+		}
+
+		for (size_t eol; (eol = chunk.find('\n')) != std::string_view::npos; chunk.remove_prefix(eol + 1))
+			onLine(chunk.substr(0, eol));
+
+		m_pending.append(chunk);
+	}
+
+	/// hands out the last line if the data did not end with a '\n'
+	template <typename LineFunc>
+	void Finish(LineFunc&& onLine)
+	{
+		if (!m_pending.empty())
+			onLine(std::string_view(m_pending));
+		m_pending.clear();
+	}
+
+private:
+	std::string m_pending;
+};
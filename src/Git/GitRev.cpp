@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2016, 2018-2021, 2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2016, 2018-2021, 2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -23,6 +23,9 @@
 #include "gitdll.h"
 #include "UnicodeUtils.h"
 
+// guards the lazy decoding of the body, GetBody() is called from the UI and the filter threads
+static CComAutoCriticalSection g_critSecBody;
+
 GitRev::GitRev()
 {
 }
@@ -39,6 +42,8 @@ void GitRev::Clear()
 	m_CommitterName.Empty();
 	m_CommitterEmail.Empty();
 	m_Body.Empty();
+	m_BodyRaw.Empty();
+	m_BodyEncoding = CP_UTF8;
 	m_Subject.Empty();
 	m_CommitHash.Empty();
 	m_sErr.Empty();
@@ -57,12 +62,35 @@ int GitRev::ParserParentFromCommit(const GIT_COMMIT* commit)
 	return 0;
 }
 
-int GitRev::ParserFromCommit(const GIT_COMMIT *commit)
+int GitRev::GetCommitEncoding(const GIT_COMMIT* commit)
+{
+	if (commit->m_Encode != 0 && commit->m_EncodeSize != 0)
+		return CUnicodeUtils::GetCPCode(CUnicodeUtils::GetUnicodeLength(commit->m_Encode, commit->m_EncodeSize));
+	return CP_UTF8;
+}
+
+CString GitRev::GetBody() const
+{
+	CComCritSecLock<CComCriticalSection> lock(g_critSecBody);
+	if (!m_BodyRaw.IsEmpty())
+	{
+		m_Body = CUnicodeUtils::GetUnicodeLength(m_BodyRaw, m_BodyRaw.GetLength(), m_BodyEncoding);
+		m_BodyRaw.Empty();
+	}
+	return m_Body;
+}
+
+void GitRev::SetBody(const CString& body)
+{
+	CComCritSecLock<CComCriticalSection> lock(g_critSecBody);
+	m_BodyRaw.Empty();
+	m_Body = body;
+}
+
+int GitRev::ParserFromCommit(const GIT_COMMIT* commit, bool decodeBody)
 {
 	ATLASSERT(commit);
-	int encode =CP_UTF8;
-	if(commit->m_Encode != 0 && commit->m_EncodeSize != 0)
-		encode = CUnicodeUtils::GetCPCode(CUnicodeUtils::GetUnicodeLength(commit->m_Encode, commit->m_EncodeSize));
+	const int encode = GetCommitEncoding(commit);
 
 	this->m_CommitHash = CGitHash::FromRaw(commit->m_hash);
 
@@ -70,7 +98,17 @@ int GitRev::ParserFromCommit(const GIT_COMMIT *commit)
 	this->m_AuthorEmail = CUnicodeUtils::GetUnicodeLength(commit->m_Author.Email, commit->m_Author.EmailSize, encode);
 	this->m_AuthorName = CUnicodeUtils::GetUnicodeLength(commit->m_Author.Name, commit->m_Author.NameSize, encode);
 
-	this->m_Body = CUnicodeUtils::GetUnicodeLength(commit->m_Body, commit->m_BodySize, encode);
+	if (decodeBody)
+	{
+		this->m_Body = CUnicodeUtils::GetUnicodeLength(commit->m_Body, commit->m_BodySize, encode);
+		m_BodyRaw.Empty();
+	}
+	else
+	{
+		m_Body.Empty();
+		m_BodyRaw.SetString(commit->m_Body, commit->m_BodySize);
+		m_BodyEncoding = encode;
+	}
 
 	this->m_CommitterDate = commit->m_Committer.Date;
 	this->m_CommitterEmail = CUnicodeUtils::GetUnicodeLength(commit->m_Committer.Email, commit->m_Committer.EmailSize, encode);
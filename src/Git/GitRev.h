@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2017, 2019-2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2017, 2019-2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -49,7 +49,9 @@ protected:
 	CString	m_CommitterEmail;
 	CTime	m_CommitterDate;
 	CString	m_Subject;
-	CString	m_Body;
+	mutable CString	m_Body;
+	mutable CStringA	m_BodyRaw;	// body as stored in the commit, decoded into m_Body by the first GetBody()
+	int		m_BodyEncoding = CP_UTF8;
 
 	CString m_sErr;
 
@@ -90,10 +92,8 @@ public:
 		return m_Subject;
 	}
 
-	CString GetBody() const
-	{
-		return m_Body;
-	}
+	CString GetBody() const;
+	void SetBody(const CString& body);
 
 	virtual ~GitRev();
 
@@ -106,7 +106,9 @@ public:
 	inline int ParentsCount() const { return static_cast<int>(m_ParentHash.size()); }
 
 protected:
-	int ParserFromCommit(const GIT_COMMIT* commit);
+	static int GetCommitEncoding(const GIT_COMMIT* commit);
+	/// \a decodeBody = false only keeps the raw body, GetBody() decodes it when it is needed the first time
+	int ParserFromCommit(const GIT_COMMIT* commit, bool decodeBody = true);
 	int ParserParentFromCommit(const GIT_COMMIT* commit);
 
 	int ParserFromCommit(const git_commit* commit);
@@ -23,6 +23,7 @@
 #include "gitdll.h"
 #include "UnicodeUtils.h"
 #include <sys/stat.h>
+#include "GitStringPool.h"
 
 std::atomic<std::shared_ptr<CGitMailmap>> GitRevLoglist::s_Mailmap = nullptr;
 
@@ -40,6 +41,7 @@ void GitRevLoglist::Clear()
 	GitRev::Clear();
 	m_Action = 0;
 	m_Files.Clear();
+	m_LineStat = {};
 	m_UnRevFiles.Clear();
 	m_Ref.Empty();
 	m_RefAction.Empty();
@@ -50,6 +52,14 @@ void GitRevLoglist::Clear()
 }
 
 
+void GitRevLoglist::InternIdentities()
+{
+	m_AuthorName = CGitStringPool::Intern(m_AuthorName);
+	m_AuthorEmail = CGitStringPool::Intern(m_AuthorEmail);
+	m_CommitterName = CGitStringPool::Intern(m_CommitterName);
+	m_CommitterEmail = CGitStringPool::Intern(m_CommitterEmail);
+}
+
 int GitRevLoglist::SafeGetSimpleList(CGit* git)
 {
 	ATLASSERT(git);
@@ -174,6 +184,7 @@ int GitRevLoglist::SafeFetchFullInfo(CGit* git)
 	AcquireSRWLockExclusive(&m_lock);
 	SCOPE_EXIT { ReleaseSRWLockExclusive(&m_lock); };
 	m_Files.Clear();
+	m_LineStat = {};
 	if (git->UsingLibGit2(CGit::GIT_CMD_LOGLISTDIFF))
 	{
 		CAutoRepository repo(git->GetGitRepository());
@@ -239,6 +250,7 @@ int GitRevLoglist::SafeFetchFullInfo(CGit* git)
 
 			const git_diff_delta* lastDelta = nullptr;
 			int oldAction = 0;
+			LineStat oldLineStat;
 			size_t deltas = git_diff_num_deltas(diff);
 			for (size_t i = 0; i < deltas; ++i)
 			{
@@ -262,10 +274,12 @@ int GitRevLoglist::SafeFetchFullInfo(CGit* git)
 					m_Files.RemoveItem(path);
 					if (path.IsDirectory() && !isDir)
 						path.UnsetDirectoryStatus();
-					path.m_StatAdd = L"-";
-					path.m_StatDel = L"-";
+					path.m_StatAdd = CTGitPath::STAT_BINARY;
+					path.m_StatDel = CTGitPath::STAT_BINARY;
 					path.m_Action = CTGitPath::LOGACTIONS_MODIFIED;
 					m_Action = oldAction | CTGitPath::LOGACTIONS_MODIFIED;
+					m_LineStat = oldLineStat;
+					m_LineStat.Add(path.m_Action, 0, 0);
 					m_Files.AddPath(path);
 					lastDelta = nullptr;
 					continue;
@@ -282,13 +296,15 @@ int GitRevLoglist::SafeFetchFullInfo(CGit* git)
 					path.SetFromGit(newname, &oldname, &isDir);
 				}
 				oldAction = m_Action;
+				oldLineStat = m_LineStat;
 				m_Action |= path.ParseAndUpdateStatus(delta->status);
 				path.m_ParentNo = parentId;
 
 				if (delta->flags & GIT_DIFF_FLAG_BINARY)
 				{
-					path.m_StatAdd = L"-";
-					path.m_StatDel = L"-";
+					path.m_StatAdd = CTGitPath::STAT_BINARY;
+					path.m_StatDel = CTGitPath::STAT_BINARY;
+					m_LineStat.Add(path.m_Action, 0, 0);
 				}
 				else
 				{
@@ -298,9 +314,11 @@ int GitRevLoglist::SafeFetchFullInfo(CGit* git)
 						m_sErr = CGit::GetLibGit2LastErr();
 						return -1;
 					}
-					path.m_StatAdd.Format(L"%zu", adds);
-					path.m_StatDel.Format(L"%zu", dels);
+					path.m_StatAdd = static_cast<int>(adds);
+					path.m_StatDel = static_cast<int>(dels);
+					m_LineStat.Add(path.m_Action, static_cast<int>(adds), static_cast<int>(dels));
 				}
+				path.InternPaths();
 				m_Files.AddPath(path);
 			}
 		}
@@ -387,14 +405,17 @@ int GitRevLoglist::SafeFetchFullInfo(CGit* git)
 
 			if (isBin)
 			{
-				path.m_StatAdd = L"-";
-				path.m_StatDel = L"-";
+				path.m_StatAdd = CTGitPath::STAT_BINARY;
+				path.m_StatDel = CTGitPath::STAT_BINARY;
+				m_LineStat.Add(path.m_Action, 0, 0);
 			}
 			else
 			{
-				path.m_StatAdd.Format(L"%d", inc);
-				path.m_StatDel.Format(L"%d", dec);
+				path.m_StatAdd = inc;
+				path.m_StatDel = dec;
+				m_LineStat.Add(path.m_Action, inc, dec);
 			}
+			path.InternPaths();
 			m_Files.AddPath(path);
 		}
 		git_diff_flush(git->GetGitDiff());
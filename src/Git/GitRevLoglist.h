@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -22,6 +22,7 @@
 #include "TGitPath.h"
 #include "gitdll.h"
 #include "lanes.h"
+#include "UnicodeUtils.h"
 
 class CGit;
 extern CGit g_Git;
@@ -80,11 +81,37 @@ public:
 		PSRWLOCK m_lock;
 	};
 
+	/// Line statistics of all changed files, kept as integers so that they do not have to be parsed from the file list
+	struct LineStat
+	{
+		int files = 0;
+		int inc = 0;			///< lines added to modified files
+		int dec = 0;			///< lines removed from modified files
+		int newFile = 0;		///< lines of added files
+		int deletedFile = 0;	///< lines of deleted files
+
+		/// \a add and \a del are 0 for binary files
+		void Add(unsigned int action, int add, int del)
+		{
+			++files;
+			if (action & CTGitPath::LOGACTIONS_DELETED)
+				deletedFile += del;
+			else if (action & CTGitPath::LOGACTIONS_ADDED)
+				newFile += add;
+			else
+			{
+				inc += add;
+				dec += del;
+			}
+		}
+	};
+
 protected:
 	int				m_RebaseAction = 0;
 	unsigned int	m_Action = 0;
 	CTGitPathList	m_Files;
 	CTGitPathList	m_UnRevFiles;
+	LineStat		m_LineStat;	// filled together with m_Files by SafeFetchFullInfo() and the log cache
 
 	SRWLOCK m_lock;
 
@@ -146,6 +173,15 @@ public:
 		return GitRevLoglistSharedFiles(&m_lock, m_Files);
 	}
 
+	/// only valid after the files have been fetched, cf. m_IsDiffFiles
+	LineStat GetLineStat()
+	{
+		AcquireSRWLockShared(&m_lock);
+		const LineStat lineStat = m_LineStat;
+		ReleaseSRWLockShared(&m_lock);
+		return lineStat;
+	}
+
 	GitRevLoglistSharedFilesWriter GetFilesWriter()
 	{
 		return GitRevLoglistSharedFilesWriter(&m_lock, m_Files, m_UnRevFiles);
@@ -159,12 +195,18 @@ public:
 	void Parse(GIT_COMMIT* commit, const CGitMailmap* mailmap)
 	{
 		ParserParentFromCommit(commit);
-		ParserFromCommit(commit);
+		// most bodies of a large log are never shown, so they are kept in their (usually much smaller) raw form
+		ParserFromCommit(commit, false);
 		// no caching here, because mailmap might have changed
 		if (mailmap)
 			ApplyMailmap(*mailmap);
+		InternIdentities();
 	}
 
+private:
+	/// lets all revisions with the same author or committer share one buffer for the name and email
+	void InternIdentities();
+
 public:
 	CString& GetAuthorName()
 	{
@@ -201,24 +243,19 @@ public:
 		return m_Subject;
 	}
 
-	CString& GetBody()
-	{
-		return m_Body;
-	}
-
 	CString GetSubjectBody(bool crlf = false) const
 	{
 		CString ret(m_Subject);
 		if (!crlf)
 		{
 			ret += L"\n";
-			ret += m_Body;
+			ret += GetBody();
 		}
 		else
 		{
 			ret.TrimRight();
 			ret += L"\r\n";
-			CString body(m_Body);
+			CString body(GetBody());
 			body.Replace(L"\n", L"\r\n");
 			ret += body.TrimRight();
 		}
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2009-2020, 2024-2025 - TortoiseGit
+// Copyright (C) 2009-2020, 2024-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -32,6 +32,72 @@ void GitRevRefBrowser::Clear()
 	GitRev::Clear();
 	m_Description.Empty();
 	m_UpstreamRef.Empty();
+	m_Ahead = static_cast<size_t>(-1);
+	m_Behind = static_cast<size_t>(-1);
+}
+
+// all tracking branches are computed in one walk, instead of one git_graph_ahead_behind per branch
+static void ReadAheadBehind(MAP_REF_GITREVREFBROWSER& map)
+{
+	CAutoRepository repo = g_Git.GetGitRepository();
+	if (!repo)
+		return;
+
+	std::vector<GitRevRefBrowser*> entries;
+	std::vector<std::pair<CGitHash, CGitHash>> pairs;
+	for (auto& [refName, entry] : map)
+	{
+		if (entry.m_UpstreamRef.IsEmpty() || !CStringUtils::StartsWith(refName, L"refs/heads/"))
+			continue;
+		git_oid upstream;
+		if (git_reference_name_to_id(&upstream, repo, CUnicodeUtils::GetUTF8(entry.m_UpstreamRef)))
+			continue; // gone
+		entries.push_back(&entry);
+		pairs.emplace_back(entry.m_CommitHash, upstream);
+	}
+
+	std::vector<std::pair<size_t, size_t>> aheadBehind;
+	if (pairs.empty() || CGit::GetAheadBehind(repo, pairs, aheadBehind) < 0)
+		return;
+	for (size_t i = 0; i < entries.size(); ++i)
+	{
+		entries[i]->m_Ahead = aheadBehind[i].first;
+		entries[i]->m_Behind = aheadBehind[i].second;
+	}
+}
+
+// the reachability bitmap of HEAD answers this for all refs at once, "git_graph_descendant_of" would walk the history once per ref
+static bool GetRefsMergedIntoHead(git_repository* repo, const git_reference* head, std::set<CString>& mergedRefs, const std::function<bool(const CString& refName)>& filterCallback)
+{
+	CAutoReferenceIterator iter;
+	if (git_reference_iterator_new(iter.GetPointer(), repo) < 0)
+		return false;
+
+	std::vector<CString> refNames;
+	std::vector<CGitHash> targets;
+	CAutoReference ref;
+	while (git_reference_next(ref.GetPointer(), iter) == 0)
+	{
+		CString refName = CUnicodeUtils::GetUnicode(git_reference_name(ref));
+		if (filterCallback && !filterCallback(refName))
+			continue;
+
+		CAutoObject target;
+		if (git_reference_peel(target.GetPointer(), ref, GIT_OBJECT_COMMIT) < 0)
+			return false;
+		refNames.push_back(refName);
+		targets.emplace_back(git_object_id(target));
+	}
+
+	std::vector<bool> reachable;
+	if (!g_Git.GetReachableFrom(repo, L"HEAD", git_reference_target(head), targets, reachable))
+		return false;
+	for (size_t i = 0; i < refNames.size(); ++i)
+	{
+		if (reachable[i])
+			mergedRefs.insert(refNames[i]);
+	}
+	return true;
 }
 
 int GitRevRefBrowser::GetGitRevRefMap(MAP_REF_GITREVREFBROWSER& map, int mergefilter, CString& err, std::function<bool(const CString& refName)> filterCallback)
@@ -41,16 +107,19 @@ int GitRevRefBrowser::GetGitRevRefMap(MAP_REF_GITREVREFBROWSER& map, int mergefi
 	g_Git.GetBranchDescriptions(descriptions);
 
 	CGitMailmap mailmap;
-	if (g_Git.UsingLibGit2(CGit::GIT_CMD_FOREACHREF) && mergefilter <= 0) // libgit2 implementation is significantly slower because of "git_graph_descendant_of", hence, only use it when merge status is not a filter
+	CAutoRepository repo;
+	CAutoReference head;
+	std::set<CString> mergedRefs;
+	bool useLibGit2 = g_Git.UsingLibGit2(CGit::GIT_CMD_FOREACHREF);
+	if (useLibGit2)
 	{
-		CAutoRepository repo = g_Git.GetGitRepository();
+		repo = g_Git.GetGitRepository();
 		if (!repo)
 		{
 			err = g_Git.GetLibGit2LastErr();
 			return -1;
 		}
 
-		CAutoReference head;
 		if (mergefilter > 0)
 		{
 			if (const auto ret = git_repository_head(head.GetPointer(), repo); ret == GIT_EUNBORNBRANCH)
@@ -61,6 +130,13 @@ int GitRevRefBrowser::GetGitRevRefMap(MAP_REF_GITREVREFBROWSER& map, int mergefi
 			}
 		}
 
+		// without the commit index the merge status is left to git.exe, which is significantly faster than "git_graph_descendant_of" for every ref
+		if (mergefilter > 0 && !GetRefsMergedIntoHead(repo, head, mergedRefs, filterCallback))
+			useLibGit2 = false;
+	}
+	if (useLibGit2)
+	{
+
 		CAutoReferenceIterator iter;
 		if (git_reference_iterator_new(iter.GetPointer(), repo) < 0)
 		{
@@ -93,19 +169,10 @@ int GitRevRefBrowser::GetGitRevRefMap(MAP_REF_GITREVREFBROWSER& map, int mergefi
 
 			if (mergefilter > 0)
 			{
-				const git_oid* oid = git_reference_target(ref);
-				if (tag)
-					oid = git_tag_target_id(tag);
-
-				const int ret = git_graph_descendant_of(repo, git_reference_target(head), oid);
-				if (ret < 0)
-				{
-					err = g_Git.GetLibGit2LastErr();
-					return -1;
-				}
-				if (mergefilter == 1 && ret == 0 && git_oid_cmp(oid, git_reference_target(head)) != 0)
+				const bool merged = mergedRefs.contains(refName);
+				if (mergefilter == 1 && !merged)
 					continue;
-				if (mergefilter == 2 && (ret == 1 || git_oid_cmp(oid, git_reference_target(head)) == 0))
+				if (mergefilter == 2 && merged)
 					continue;
 			}
 
@@ -177,6 +244,8 @@ int GitRevRefBrowser::GetGitRevRefMap(MAP_REF_GITREVREFBROWSER& map, int mergefi
 			return -1;
 		}
 
+		ReadAheadBehind(map);
+
 		return 0;
 	}
 
@@ -246,5 +315,7 @@ int GitRevRefBrowser::GetGitRevRefMap(MAP_REF_GITREVREFBROWSER& map, int mergefi
 		map.emplace(refName, ref);
 	}
 
+	ReadAheadBehind(map);
+
 	return 0;
 }
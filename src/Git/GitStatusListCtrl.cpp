@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2013-2015 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -50,6 +50,8 @@
 #include "CreateChangelistDlg.h"
 #include "Theme.h"
 #include <fstream>
+#include <string_view>
+#include <unordered_map>
 
 const UINT CGitStatusListCtrl::GITSLNM_ITEMCOUNTCHANGED
 					= ::RegisterWindowMessage(L"GITSLNM_ITEMCOUNTCHANGED");
@@ -615,9 +617,9 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 
 	WORD langID = static_cast<WORD>(CRegStdDWORD(L"Software\\TortoiseGit\\LanguageID", GetUserDefaultLangID()));
 	SetRedraw(FALSE);
+	bool incremental = false;
 	{
 		CAutoWriteLock locker(m_guard);
-		DeleteAllItems();
 		m_nSelected = 0;
 
 		m_nShownUnversioned = 0;
@@ -651,7 +653,10 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 		m_bTooManyItems = (m_bHideTooManyItems && m_arStatusArray.size() > m_nTooManyItemsThreshold);
 		if (m_bTooManyItems)
 		{
+			DeleteAllItems();
 			m_arListArray.clear();
+			m_arListPaths.clear();
+			ReleasePreviousEntries();
 			RemoveAllGroups();
 
 			RestoreScrollPos();
@@ -666,15 +671,23 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 		}
 
 		PrepareGroups();
-		m_arListArray.clear();
-		m_arListArray.reserve(m_arStatusArray.size());
 		if (m_nSortedColumn >= 0)
 		{
 			CSorter predicate(&m_ColumnManager, m_nSortedColumn, m_bAscending);
 			std::stable_sort(m_arStatusArray.begin(), m_arStatusArray.end(), predicate);
 		}
 
-		int index = 0;
+		// the unversioned files kept from the last refresh might be gone already
+		const CTGitPath* staleFirst = nullptr;
+		const CTGitPath* staleLast = nullptr;
+		if (m_bUnRevFileListStale && !m_UnRevFileList.IsEmpty())
+		{
+			staleFirst = &m_UnRevFileList[0];
+			staleLast = staleFirst + m_UnRevFileList.GetCount();
+		}
+
+		std::vector<size_t> shown;
+		shown.reserve(m_arStatusArray.size());
 		for (size_t i = 0; i < m_arStatusArray.size(); ++i)
 		{
 			//set default checkbox status
@@ -688,6 +701,8 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 				else
 					entry->m_Checked = false;
 			}
+			else if (entry >= staleFirst && entry < staleLast)
+				entry->m_Checked = false;
 			else if (!m_mapFilenameToChecked.empty() && m_mapFilenameToChecked.find(path) != m_mapFilenameToChecked.end())
 				entry->m_Checked = m_mapFilenameToChecked[path];
 			else if (!UseStoredCheckStatus)
@@ -710,8 +725,23 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 			}
 
 			if (entry->m_Action & dwShow)
+				shown.push_back(i);
+		}
+
+		incremental = UpdateShownEntries(shown);
+		if (!incremental)
+		{
+			DeleteAllItems();
+			m_arListArray.clear();
+			// no row refers to the previous entries anymore, and the new rows refer to m_arStatusArray
+			ReleasePreviousEntries();
+			m_arListArray.reserve(shown.size());
+			m_arListPaths.clear();
+			m_arListPaths.reserve(shown.size());
+			int index = 0;
+			for (size_t i : shown)
 			{
-				AddEntry(i, entry, langID, index);
+				AddEntry(i, const_cast<CTGitPath*>(m_arStatusArray[i]), langID, index);
 				index++;
 			}
 		}
@@ -738,7 +768,11 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 		pHeader->SetItem(m_nSortedColumn, &HeaderItem);
 	}
 
-	RestoreScrollPos();
+	// rows which were kept did not lose their selection and position
+	if (incremental)
+		m_sScrollPos.enabled = false;
+	else
+		RestoreScrollPos();
 
 	m_bWaitCursor = false;
 	m_bBusy = false;
@@ -874,6 +908,86 @@ void CGitStatusListCtrl::Show(unsigned int dwShow, unsigned int dwCheck /*=0*/,
 #endif
 }
 
+bool CGitStatusListCtrl::UpdateShownEntries(const std::vector<size_t>& shown)
+{
+	const size_t rowCount = m_arListPaths.size();
+	if (rowCount == 0 || rowCount != static_cast<size_t>(GetItemCount()))
+		return false;
+
+	// the strings are owned by the entries and m_arListPaths, which both outlive the maps
+	std::unordered_map<std::wstring_view, size_t> newPositions;
+	newPositions.reserve(shown.size());
+	for (size_t i = 0; i < shown.size(); ++i)
+	{
+		const CString& path = m_arStatusArray[shown[i]]->GetGitPathString();
+		if (!newPositions.emplace(std::wstring_view(path, path.GetLength()), i).second)
+			return false; // rows cannot be matched by path
+	}
+
+	// rows are only moved by deleting and inserting them, so the kept rows have to stay in the same order
+	// (not the case e.g. if the list is sorted by a column whose values changed)
+	std::vector<bool> keep(rowCount);
+	size_t kept = 0;
+	size_t lastPosition = 0;
+	for (size_t row = 0; row < rowCount; ++row)
+	{
+		auto it = newPositions.find(std::wstring_view(m_arListPaths[row], m_arListPaths[row].GetLength()));
+		if (it == newPositions.cend())
+			continue;
+		if (kept > 0 && it->second <= lastPosition)
+			return false;
+		lastPosition = it->second;
+		keep[row] = true;
+		++kept;
+	}
+	if (kept == 0)
+		return false;
+
+	ScopedInDecrement blocker(m_nBlockItemChangeHandler);
+	// from the end, so that the indexes of the other rows do not change
+	for (size_t row = rowCount; row-- > 0;)
+	{
+		if (!keep[row])
+			DeleteItem(static_cast<int>(row));
+	}
+
+	std::vector<size_t> listArray;
+	listArray.reserve(shown.size());
+	std::vector<CString> listPaths;
+	listPaths.reserve(shown.size());
+	size_t row = 0;
+	for (size_t i = 0; i < shown.size(); ++i)
+	{
+		auto entry = const_cast<CTGitPath*>(m_arStatusArray[shown[i]]);
+		const int listIndex = static_cast<int>(i);
+		while (row < rowCount && !keep[row])
+			++row;
+
+		CountShownEntry(entry);
+		if (row < rowCount && m_arListPaths[row] == entry->GetGitPathString())
+		{
+			UpdateEntryItem(listIndex, entry);
+			++row;
+		}
+		else
+			InsertEntryItem(listIndex, entry);
+		listArray.push_back(shown[i]);
+		listPaths.push_back(entry->GetGitPathString());
+		SetEntryItemState(listIndex, entry);
+	}
+	m_arListArray.swap(listArray);
+	m_arListPaths.swap(listPaths);
+	// all rows refer to m_arStatusArray now
+	ReleasePreviousEntries();
+	return true;
+}
+
+void CGitStatusListCtrl::ReleasePreviousEntries()
+{
+	m_arPreviousStatusArray.clear();
+	m_previousFileLists.clear();
+}
+
 void CGitStatusListCtrl::AppendLFSLocks(bool onlyExisting)
 {
 	for (int i = 0; i < m_LocksFileList.GetCount(); ++i)
@@ -1045,10 +1159,10 @@ CString CGitStatusListCtrl::GetCellText(int listIndex, int column)
 		return entry->GetActionName();
 
 	case 4: // GITSLC_COLADD
-		return entry->m_StatAdd;
+		return CTGitPath::FormatStat(entry->m_StatAdd);
 
 	case 5: // GITSLC_COLDEL
-		return entry->m_StatDel;
+		return CTGitPath::FormatStat(entry->m_StatDel);
 
 	case 6: // GITSLC_COLMODIFICATIONDATE
 		if (!(entry->m_Action & CTGitPath::LOGACTIONS_DELETED) && m_ColumnManager.IsRelevant(GetColumnIndex(GITSLC_COLMODIFICATIONDATE)))
@@ -1099,8 +1213,18 @@ void CGitStatusListCtrl::AddEntry(size_t arStatusArrayIndex, CTGitPath * GitPath
 {
 	CAutoWriteLock locker(m_guard);
 	ScopedInDecrement blocker(m_nBlockItemChangeHandler);
-	CString path = GitPath->GetGitPathString();
 
+	CountShownEntry(GitPath);
+	InsertEntryItem(listIndex, GitPath);
+
+	m_arListArray.push_back(arStatusArrayIndex);
+	m_arListPaths.push_back(GitPath->GetGitPathString());
+
+	SetEntryItemState(listIndex, GitPath);
+}
+
+void CGitStatusListCtrl::InsertEntryItem(int listIndex, CTGitPath* GitPath)
+{
 	// Load the icons *now* so the icons are cached when showing them later in the
 	// WM_PAINT handler.
 	// Problem is that (at least on Win10), loading the icons in the WM_PAINT
@@ -1110,17 +1234,45 @@ void CGitStatusListCtrl::AddEntry(size_t arStatusArrayIndex, CTGitPath * GitPath
 	// later in the WM_PAINT handler.
 	// This solves the 'hang' which happens in the commit dialog if images are
 	// shown in the file list.
-	int icon_idx = 0;
+	int icon_idx = GitPath->IsDirectory() ? m_nIconFolder : SYS_IMAGE_LIST().GetPathIconIndex(*GitPath);
+
+	LVITEM lvItem = { 0 };
+	lvItem.iItem = listIndex;
+	lvItem.lParam = reinterpret_cast<LPARAM>(GitPath);
+	lvItem.mask = LVIF_TEXT | LVIF_IMAGE | LVIF_STATE | LVIF_PARAM;
+	lvItem.pszText = LPSTR_TEXTCALLBACK;
+	lvItem.stateMask = LVIS_OVERLAYMASK;
+	if (m_restorepaths.find(GitPath->GetWinPathString()) != m_restorepaths.end())
+		lvItem.state = INDEXTOOVERLAYMASK(OVL_RESTORE);
+	lvItem.iImage = icon_idx;
+	InsertItem(&lvItem);
+}
+
+void CGitStatusListCtrl::UpdateEntryItem(int listIndex, CTGitPath* GitPath)
+{
+	LVITEM lvItem = { 0 };
+	lvItem.iItem = listIndex;
+	lvItem.mask = LVIF_IMAGE;
+	GetItem(&lvItem);
+	// the icon only depends on the path, except that a file might have become a submodule or the other way round
+	if (GitPath->IsDirectory() != (lvItem.iImage == m_nIconFolder))
+		lvItem.iImage = GitPath->IsDirectory() ? m_nIconFolder : SYS_IMAGE_LIST().GetPathIconIndex(*GitPath);
+
+	lvItem.mask = LVIF_IMAGE | LVIF_STATE | LVIF_PARAM;
+	lvItem.lParam = reinterpret_cast<LPARAM>(GitPath);
+	lvItem.stateMask = LVIS_OVERLAYMASK;
+	lvItem.state = 0;
+	if (m_restorepaths.find(GitPath->GetWinPathString()) != m_restorepaths.end())
+		lvItem.state = INDEXTOOVERLAYMASK(OVL_RESTORE);
+	SetItem(&lvItem);
+}
+
+void CGitStatusListCtrl::CountShownEntry(const CTGitPath* GitPath)
+{
 	if (GitPath->IsDirectory())
-	{
-		icon_idx = m_nIconFolder;
 		m_nShownSubmodules++;
-	}
 	else
-	{
-		icon_idx = SYS_IMAGE_LIST().GetPathIconIndex(*GitPath);
 		m_nShownFiles++;
-	}
 	switch (GitPath->m_Action)
 	{
 	case CTGitPath::LOGACTIONS_ADDED:
@@ -1149,20 +1301,10 @@ void CGitStatusListCtrl::AddEntry(size_t arStatusArrayIndex, CTGitPath * GitPath
 		m_nShownUnversioned++;
 		break;
 	}
+}
 
-	LVITEM lvItem = { 0 };
-	lvItem.iItem = listIndex;
-	lvItem.lParam = reinterpret_cast<LPARAM>(GitPath);
-	lvItem.mask = LVIF_TEXT | LVIF_IMAGE | LVIF_STATE | LVIF_PARAM;
-	lvItem.pszText = LPSTR_TEXTCALLBACK;
-	lvItem.stateMask = LVIS_OVERLAYMASK;
-	if (m_restorepaths.find(GitPath->GetWinPathString()) != m_restorepaths.end())
-		lvItem.state = INDEXTOOVERLAYMASK(OVL_RESTORE);
-	lvItem.iImage = icon_idx;
-	InsertItem(&lvItem);
-
-	m_arListArray.push_back(arStatusArrayIndex);
-
+void CGitStatusListCtrl::SetEntryItemState(int listIndex, const CTGitPath* GitPath)
+{
 	if (m_bThreeStateCheckboxes) // if three-state, display the staging status in the checkboxes
 	{
 		if (GitPath->m_stagingStatus == CTGitPath::StagingStatus::PartiallyStaged)
@@ -1473,8 +1615,11 @@ void CGitStatusListCtrl::BuildStatistics()
 	{
 		int status = m_arStatusArray[i]->m_Action;
 
-		m_nLineAdded += _wtol(m_arStatusArray[i]->m_StatAdd);
-		m_nLineDeleted += _wtol(m_arStatusArray[i]->m_StatDel);
+		// binary and unknown are negative
+		if (m_arStatusArray[i]->m_StatAdd > 0)
+			m_nLineAdded += m_arStatusArray[i]->m_StatAdd;
+		if (m_arStatusArray[i]->m_StatDel > 0)
+			m_nLineDeleted += m_arStatusArray[i]->m_StatDel;
 
 		if(status&(CTGitPath::LOGACTIONS_ADDED|CTGitPath::LOGACTIONS_COPY))
 			m_nAdded++;
@@ -3482,6 +3627,8 @@ void CGitStatusListCtrl::RemoveListEntry(int index)
 	DeleteItem(index);
 
 	m_arStatusArray.erase(m_arStatusArray.cbegin() + index);
+	// the rows do not match m_arListArray anymore, rebuild them on the next Show()
+	m_arListPaths.clear();
 
 #if 0
 	delete m_arStatusArray[m_arListArray[index]];
@@ -4212,13 +4359,57 @@ int CGitStatusListCtrl::UpdateLFSLockedFileList(bool onlyExisting)
 
 int CGitStatusListCtrl::UpdateUnRevFileList(const CTGitPathList* List)
 {
-	CAutoWriteLock locker(m_guard);
-	if (CString err; m_UnRevFileList.FillUnRev(CTGitPath::LOGACTIONS_UNVER, List, &err))
+	// the list is only locked for taking over the files, not while the working tree is scanned
+	CTGitPathList unRevFileList;
+	if (CString err; unRevFileList.FillUnRev(CTGitPath::LOGACTIONS_UNVER, List, &err))
 	{
 		MessageBox(L"Failed to get UnRev file list\n" + err, L"TortoiseGit", MB_OK | MB_ICONERROR);
 		return -1;
 	}
 
+	CAutoWriteLock locker(m_guard);
+	SetUnRevFileList(unRevFileList);
+	return 0;
+}
+
+void CGitStatusListCtrl::KeepUnRevFileList()
+{
+	CAutoWriteLock locker(m_guard);
+	// only after ClearForRefresh(), otherwise the list might be left over from other paths
+	if (m_arPreviousStatusArray.empty())
+		return;
+	for (int i = 0; i < m_UnRevFileList.GetCount(); ++i)
+		m_arStatusArray.push_back(&m_UnRevFileList[i]);
+	m_bUnRevFileListStale = true;
+}
+
+int CGitStatusListCtrl::FetchUnRevFileList(CGit& git, const CTGitPathList* pList, CTGitPathList& unRevFileList, CString& err)
+{
+	auto List = (pList && pList->GetCount() >= 1 && !(*pList)[0].GetWinPathString().IsEmpty()) ? pList : nullptr;
+	return unRevFileList.FillUnRev(CTGitPath::LOGACTIONS_UNVER, List, &err, &git);
+}
+
+void CGitStatusListCtrl::ShowUnRevFileList(const CTGitPathList& unRevFileList, unsigned int dwShow, unsigned int dwCheck)
+{
+	// the rows refer to the replaced entries until Show() updated them
+	CAutoWriteLock locker(m_guard);
+	SetUnRevFileList(unRevFileList);
+	m_FileLoaded |= CGitStatusListCtrl::FILELIST_UNVER;
+	Show(dwShow, dwCheck);
+}
+
+void CGitStatusListCtrl::SetUnRevFileList(const CTGitPathList& list)
+{
+	// drop the entries of the previous list, e.g. those added by KeepUnRevFileList()
+	if (!m_UnRevFileList.IsEmpty())
+	{
+		const CTGitPath* first = &m_UnRevFileList[0];
+		const CTGitPath* last = first + m_UnRevFileList.GetCount();
+		std::erase_if(m_arStatusArray, [first, last](const CTGitPath* entry) { return entry >= first && entry < last; });
+	}
+	m_UnRevFileList = list;
+	m_bUnRevFileListStale = false;
+
 	if (m_StatusFileList.m_Action & CTGitPath::LOGACTIONS_DELETED)
 	{
 		int unrev = 0;
@@ -4243,7 +4434,6 @@ int CGitStatusListCtrl::UpdateUnRevFileList(const CTGitPathList* List)
 		gitpatch->m_Checked = FALSE;
 		m_arStatusArray.push_back(&m_UnRevFileList[i]);
 	}
-	return 0;
 }
 
 int CGitStatusListCtrl::UpdateIgnoreFileList(const CTGitPathList* List)
@@ -4325,9 +4515,37 @@ void CGitStatusListCtrl::Clear()
 	m_FileLoaded=0;
 	this->DeleteAllItems();
 	this->m_arListArray.clear();
+	this->m_arListPaths.clear();
 	this->m_arStatusArray.clear();
 	this->m_changelists.clear();
 	this->m_pathToChangelist.clear();
+	ReleasePreviousEntries();
+}
+
+void CGitStatusListCtrl::ClearForRefresh()
+{
+	CAutoWriteLock locker(m_guard);
+	if (m_arListPaths.empty() || m_arListPaths.size() != static_cast<size_t>(GetItemCount()))
+	{
+		Clear();
+		return;
+	}
+
+	m_FileLoaded = 0;
+	// The rows keep showing the old entries until Show() updated them. The entries are moved
+	// away, so that they stay valid while the lists are filled again; the lists keep a copy
+	// of their content, as with Clear().
+	ReleasePreviousEntries();
+	m_arPreviousStatusArray.swap(m_arStatusArray);
+	const auto lists = { &m_StatusFileList, &m_UnRevFileList, &m_LocksFileList, &m_IgnoreFileList, &m_LocalChangesIgnoredFileList };
+	m_previousFileLists.reserve(lists.size()); // no reallocation, which might copy the lists instead of moving them
+	for (auto list : lists)
+	{
+		m_previousFileLists.push_back(std::move(*list));
+		*list = m_previousFileLists.back();
+	}
+	m_changelists.clear();
+	m_pathToChangelist.clear();
 }
 
 bool CGitStatusListCtrl::CheckMultipleDiffs()
@@ -4920,17 +5138,19 @@ BOOL CGitStatusListCtrl::OnWndMsg(UINT message, WPARAM wParam, LPARAM lParam, LR
 CTGitPath* CGitStatusListCtrl::GetListEntry(int index)
 {
 	ATLASSERT(m_guard.GetCurrentThreadStatus());
+	// between ClearForRefresh() and Show() the rows still show the previous entries
+	const auto& statusArray = m_arPreviousStatusArray.empty() ? m_arStatusArray : m_arPreviousStatusArray;
 	if (static_cast<size_t>(index) >= m_arListArray.size())
 	{
 		ATLASSERT(FALSE);
 		return nullptr;
 	}
-	if (m_arListArray[index] >= m_arStatusArray.size())
+	if (m_arListArray[index] >= statusArray.size())
 	{
 		ATLASSERT(FALSE);
 		return nullptr;
 	}
-	return const_cast<CTGitPath*>(m_arStatusArray[m_arListArray[index]]);
+	return const_cast<CTGitPath*>(statusArray[m_arListArray[index]]);
 }
 
 ULONG CGitStatusListCtrl::GetGestureStatus(CPoint /*ptTouch*/)
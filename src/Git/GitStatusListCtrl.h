@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2023 - TortoiseGit
+// Copyright (C) 2008-2023, 2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2014 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -151,17 +151,6 @@ public:
 	bool operator() ( const CTGitPath* entry1
 		, const CTGitPath* entry2) const;
 
-	static int A2L(const CString &str)
-	{
-		if (str == L"-")
-			return -1;
-
-		if (str.IsEmpty())
-			return -2;
-
-		return _wtol(str);
-	}
-
 private:
 
 	ColumnManager* columnManager = nullptr;
@@ -664,6 +653,19 @@ private:
 	CString GetCellText(int listIndex, int column);    ///< get the text for a certain grid cell
 	//void AddEntry(FileEntry * entry, WORD langID, int listIndex);	///< add an entry to the control
 	void RemoveListEntry(int index);	///< removes an entry from the listcontrol and both arrays
+	void CountShownEntry(const CTGitPath* GitPath);	///< updates the m_nShownXXX counters
+	void InsertEntryItem(int listIndex, CTGitPath* GitPath);	///< inserts the row of an entry into the control
+	void UpdateEntryItem(int listIndex, CTGitPath* GitPath);	///< lets an existing row show an entry with the same path
+	void SetEntryItemState(int listIndex, const CTGitPath* GitPath);	///< sets the checkbox and group of a row
+	/**
+	 * Updates the rows of the control to show the entries \a shown (indexes into m_arStatusArray)
+	 * by only deleting, inserting and updating the rows whose path changed.
+	 * \return false if the rows cannot be matched and have to be rebuilt
+	 */
+	bool UpdateShownEntries(const std::vector<size_t>& shown);
+	void ReleasePreviousEntries();
+	/// replaces m_UnRevFileList and its entries in m_arStatusArray, m_guard has to be locked for writing
+	void SetUnRevFileList(const CTGitPathList& list);
 	void BuildStatistics();	///< build the statistics and correct the case of files/folders
 	void StartDiff(int fileindex);	///< start the external diff program
 	void StartDiffWC(int fileindex, bool parent = false);	///< start the external diff program
@@ -785,11 +787,15 @@ private:
 	//FileEntryVector				m_arStatusArray;
 	std::vector<const CTGitPath*>	m_arStatusArray;
 	std::vector<size_t>			m_arListArray;
+	std::vector<CString>		m_arListPaths;	///< git path of each row, used to match the rows with the entries of a refresh
+	std::vector<const CTGitPath*>	m_arPreviousStatusArray;	///< used by the rows between ClearForRefresh() and Show()
+	std::vector<CTGitPathList>	m_previousFileLists;	///< keeps the entries of m_arPreviousStatusArray alive
 	std::map<CString, int>		m_changelists; // maps changelist to group index
 	std::map<CString, CString>	m_pathToChangelist; // maps gitpath to changelist
 	bool						m_bHasIgnoreGroup = false;
 	CTGitPathList				m_StatusFileList;
 	CTGitPathList				m_UnRevFileList;
+	bool						m_bUnRevFileListStale = false;	///< m_UnRevFileList is the one of the last refresh, see KeepUnRevFileList()
 	CTGitPathList				m_LocksFileList;
 	CTGitPathList				m_IgnoreFileList;
 	CTGitPathList				m_LocalChangesIgnoredFileList; // assume valid & skip worktree
@@ -867,6 +873,22 @@ public:
 	int UpdateFileList(int mask, bool once = true, const CTGitPathList* list = nullptr, bool getStagingStatus = false);
 	int InsertUnRevListFromPreCalculatedList(const CTGitPathList& list);
 	int UpdateUnRevFileList(const CTGitPathList* list = nullptr);
+	/**
+	 * Lets Show() list the unversioned files of the last status again after ClearForRefresh(),
+	 * so that they do not vanish while the new ones are fetched by FetchUnRevFileList().
+	 * These files might not exist anymore, so they are not checked until they are replaced.
+	 */
+	void KeepUnRevFileList();
+	/**
+	 * Fetches the unversioned files without touching the list, so it can run in a worker thread
+	 * with its own \a git instance while the versioned files are already shown and the list is in use.
+	 */
+	static int FetchUnRevFileList(CGit& git, const CTGitPathList* list, CTGitPathList& unRevFileList, CString& err);
+	/**
+	 * Shows the unversioned files fetched by FetchUnRevFileList() together with the entries
+	 * which are already there, has to be called from the thread owning the list.
+	 */
+	void ShowUnRevFileList(const CTGitPathList& unRevFileList, unsigned int dwShow, unsigned int dwCheck);
 	int UpdateLFSLockedFileList(bool onlyExisting);
 	int UpdateIgnoreFileList(const CTGitPathList* list = nullptr);
 	int UpdateLocalChangesIgnoredFileList(const CTGitPathList* list = nullptr);
@@ -875,6 +897,13 @@ public:
 
 	void AddEntry(size_t arStatusArrayIndex, CTGitPath* path, WORD langID, int ListIndex);
 	void Clear();
+	/**
+	 * Like Clear(), but keeps the rows of the control until the next Show(),
+	 * which then only applies the differences to them. This keeps the
+	 * selection and the scroll position and is much faster for large lists
+	 * with only a few changes. Use it for refreshing.
+	 */
+	void ClearForRefresh();
 	int m_FileLoaded = 0;
 	CGitHash m_CurrentVersion;
 	bool m_bDoNotAutoselectSubmodules = false;
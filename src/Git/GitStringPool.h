@@ -0,0 +1,62 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include <string_view>
+#include <unordered_set>
+
+/**
+ * Process wide pool of strings which occur very often, e.g. author names or
+ * file paths in the log.
+ * CString shares its buffer between copies, so equal strings taken from the
+ * pool only take memory once. The pool is never cleared.
+ */
+class CGitStringPool
+{
+public:
+	CGitStringPool() = delete;
+
+	static CString Intern(const CString& str)
+	{
+		if (str.IsEmpty())
+			return str;
+
+		static SRWLOCK lock = SRWLOCK_INIT;
+		static std::unordered_set<CString, Hash> pool;
+
+		AcquireSRWLockShared(&lock);
+		if (auto it = pool.find(str); it != pool.cend())
+		{
+			CString interned = *it;
+			ReleaseSRWLockShared(&lock);
+			return interned;
+		}
+		ReleaseSRWLockShared(&lock);
+
+		AcquireSRWLockExclusive(&lock);
+		CString interned = *pool.insert(str).first;
+		ReleaseSRWLockExclusive(&lock);
+		return interned;
+	}
+
+private:
+	struct Hash
+	{
+		size_t operator()(const CString& str) const { return std::hash<std::wstring_view>()(std::wstring_view(str, str.GetLength())); }
+	};
+};
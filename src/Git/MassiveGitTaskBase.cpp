@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2011-2016, 2019-2020, 2022-2024 - TortoiseGit
+// Copyright (C) 2011-2016, 2019-2020, 2022-2024, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -20,8 +20,32 @@
 #include "stdafx.h"
 #include "MassiveGitTaskBase.h"
 #include "Git.h"
+#include "UnicodeUtils.h"
 #include <assert.h>
 
+namespace
+{
+// number of paths written to git at once, progress and cancellation are checked in between
+constexpr int STDIN_BATCH_SIZE = 1000;
+
+struct ReadOutputThreadArgs
+{
+	HANDLE		hRead = nullptr;
+	BYTE_VECTOR	output;
+};
+
+// git blocks if nobody reads its output while the paths are still written
+DWORD WINAPI ReadOutputThread(LPVOID lpParam)
+{
+	auto pArgs = static_cast<ReadOutputThreadArgs*>(lpParam);
+	DWORD readnumber;
+	char data[1024];
+	while (ReadFile(pArgs->hRead, data, sizeof(data), &readnumber, nullptr))
+		pArgs->output.append(data, readnumber);
+	return 0;
+}
+}
+
 CMassiveGitTaskBase::CMassiveGitTaskBase(CString gitParameters, BOOL isPath, bool ignoreErrors)
 	: m_bIsPath(isPath)
 	, m_bIgnoreErrors(ignoreErrors)
@@ -127,6 +151,9 @@ bool CMassiveGitTaskBase::ExecuteCommands(volatile BOOL& cancel)
 		return true;
 	}
 
+	if (m_bIsPath && startsWithOrIsParam(m_sParams, L"update-index"))
+		return ExecuteWithStdin(cancel);
+
 	int max_command_line_length = 30000;
 	int quotes_length = 2;
 	if (CGit::ms_bCygwinGit || CGit::ms_bMsys2Git) // see issue https://tortoisegit.org/issue/3542
@@ -179,6 +206,85 @@ bool CMassiveGitTaskBase::ExecuteCommands(volatile BOOL& cancel)
 	return true;
 }
 
+/**
+ * Runs one git process for the whole list and writes the paths to its stdin in batches instead of
+ * running one process per command line. git processes every path as soon as it is read and writes
+ * the index after its input ended, so progress is reported per batch and on cancellation the input
+ * is just ended early, which leaves a consistent index behind.
+ */
+bool CMassiveGitTaskBase::ExecuteWithStdin(volatile BOOL& cancel)
+{
+	// --stdin has to be the last option
+	CString cmd;
+	cmd.Format(L"git.exe %s -z --stdin", static_cast<LPCWSTR>(m_sParams));
+	PROCESS_INFORMATION pi;
+	ReadOutputThreadArgs threadArgs;
+	CAutoGeneralHandle hRead, hWrite;
+	if (g_Git.RunAsync(cmd, pi, hRead.GetPointer(), nullptr, nullptr, hWrite.GetPointer()))
+	{
+		ReportError(L"Could not start " + cmd, -1);
+		return false;
+	}
+	CAutoGeneralHandle piThread(std::move(pi.hThread));
+	CAutoGeneralHandle piProcess(std::move(pi.hProcess));
+	threadArgs.hRead = hRead;
+	CAutoGeneralHandle thread = CreateThread(nullptr, 0, ReadOutputThread, &threadArgs, 0, nullptr);
+	if (!thread)
+	{
+		hWrite.CloseHandle();
+		WaitForSingleObject(piProcess, INFINITE);
+		ReportError(L"Could not read the output of " + cmd, -1);
+		return false;
+	}
+
+	bool bCanceled = false;
+	for (int first = 0; first < GetListCount(); first += STDIN_BATCH_SIZE)
+	{
+		if (cancel)
+		{
+			bCanceled = true;
+			break;
+		}
+
+		const int last = min(first + STDIN_BATCH_SIZE, GetListCount());
+		CStringA batch;
+		for (int i = first; i < last; ++i)
+		{
+			batch += CUnicodeUtils::GetUTF8(m_pathList[i].GetGitPathString());
+			batch += '\0';
+		}
+		DWORD written = 0;
+		// git exited early, its output tells why
+		if (!WriteFile(hWrite, batch, batch.GetLength(), &written, nullptr) || written != static_cast<DWORD>(batch.GetLength()))
+			break;
+
+		for (int i = first; i < last; ++i)
+			ReportProgress(m_pathList[i], i);
+	}
+	hWrite.CloseHandle();
+
+	WaitForSingleObject(thread, INFINITE);
+	WaitForSingleObject(piProcess, INFINITE);
+	DWORD exitCode = 0;
+	if (!GetExitCodeProcess(piProcess, &exitCode))
+		exitCode = static_cast<DWORD>(TGIT_GIT_ERROR_GET_EXIT_CODE);
+	if (exitCode && !m_bIgnoreErrors)
+	{
+		CString out;
+		if (!threadArgs.output.empty())
+			CGit::StringAppend(out, threadArgs.output.data(), CP_UTF8, static_cast<int>(threadArgs.output.size()));
+		ReportError(out, static_cast<int>(exitCode));
+		return false;
+	}
+
+	if (bCanceled)
+	{
+		ReportUserCanceled();
+		return false;
+	}
+	return true;
+}
+
 void CMassiveGitTaskBase::ReportError(const CString& out, int /*exitCode*/)
 {
 	MessageBox(nullptr, out, L"TortoiseGit", MB_OK | MB_ICONERROR);
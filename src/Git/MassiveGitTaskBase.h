@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2011-2013 - Sven Strickroth <email@cs-ware.de>
-// Copyright (C) 2013-2017, 2020, 2022-2023 - TortoiseGit
+// Copyright (C) 2013-2017, 2020, 2022-2023, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -43,6 +43,7 @@ protected:
 	CString					GetParams() const { return m_sParams; }
 private:
 	CString					GetListItem(int index) const;
+	bool					ExecuteWithStdin(volatile BOOL& cancel);
 	bool					m_bUnused = true;
 	BOOL					m_bIsPath = TRUE;
 	bool					m_bIgnoreErrors = false;
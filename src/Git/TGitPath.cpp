@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2025 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -27,6 +27,7 @@
 #include "../TortoiseShell/Globals.h"
 #include "StringUtils.h"
 #include "SmartHandle.h"
+#include "GitStringPool.h"
 #include "../Resources/LoglistCommonResource.h"
 #include <sys/stat.h>
 
@@ -224,6 +225,39 @@ const CString &CTGitPath::GetGitOldPathString() const
 	return m_sOldFwdslashPath;
 }
 
+void CTGitPath::InternPaths()
+{
+	m_sFwdslashPath = CGitStringPool::Intern(GetGitPathString());
+	m_sOldFwdslashPath = CGitStringPool::Intern(m_sOldFwdslashPath);
+}
+
+CString CTGitPath::FormatStat(int stat)
+{
+	if (stat == STAT_UNKNOWN)
+		return CString();
+	if (stat == STAT_BINARY)
+		return L"-";
+	CString str;
+	str.Format(L"%d", stat);
+	return str;
+}
+
+int CTGitPath::ParseStat(const char* p, size_t length)
+{
+	if (length == 1 && *p == '-')
+		return STAT_BINARY;
+	if (length == 0)
+		return STAT_UNKNOWN;
+	int stat = 0;
+	for (size_t i = 0; i < length; ++i)
+	{
+		if (p[i] < '0' || p[i] > '9' || stat > (INT_MAX - 9) / 10)
+			return STAT_UNKNOWN;
+		stat = stat * 10 + (p[i] - '0');
+	}
+	return stat;
+}
+
 const CString& CTGitPath::GetUIPathString() const
 {
 	if (m_sUIPath.IsEmpty())
@@ -415,8 +449,8 @@ void CTGitPath::Reset()
 	m_sOldFwdslashPath.Empty();
 
 	this->m_Action=0;
-	this->m_StatAdd.Empty();
-	this->m_StatDel.Empty();
+	this->m_StatAdd = STAT_UNKNOWN;
+	this->m_StatDel = STAT_UNKNOWN;
 	m_ParentNo=0;
 	m_stagingStatus = CTGitPath::StagingStatus::DontCare;
 	ATLASSERT(IsEmpty());
@@ -1033,6 +1067,7 @@ int CTGitPathList::ParserFromLsFile(const BYTE_VECTOR& out)
 	const size_t end = out.size();
 	CTGitPath path;
 	CString pathstring;
+	std::string_view lastUnmerged;
 	this->Clear();
 	while (pos < end)
 	{
@@ -1065,17 +1100,21 @@ int CTGitPathList::ParserFromLsFile(const BYTE_VECTOR& out)
 		const size_t fileNameEnd = out.find(0, pos);
 		if (fileNameEnd == CGitByteArray::npos || fileNameEnd == pos || pos - lineStart != strlen("H 100644 ") + 2 * GIT_HASH_SIZE + strlen(" 0\t")) // <tag> <mode> <object> <stage>\t<file>
 			return -1;
+		const std::string_view rawPath(&out[pos], fileNameEnd - pos);
+		const bool unmerged = strtol(&out[stagestart], nullptr, 10) != 0;
+		// the stages of a conflicted file follow each other, only the first one is converted and added
+		if (unmerged && rawPath == lastUnmerged)
+		{
+			pos = out.findNextString(pos);
+			continue;
+		}
 		pathstring.Empty();
-		CGit::StringAppend(pathstring, &out[pos], CP_UTF8, static_cast<int>(fileNameEnd - pos));
+		CGit::StringAppend(pathstring, rawPath.data(), CP_UTF8, static_cast<int>(rawPath.size()));
 		// SetFromGit resets the path
 		path.SetFromGit(pathstring, (strtol(&out[modestart], nullptr, 8) & S_IFDIR) == S_IFDIR);
-		if (strtol(&out[stagestart], nullptr, 10) != 0)
+		if (unmerged)
 		{
-			if (!IsEmpty() && path == m_paths[m_paths.size() - 1])
-			{
-				pos = out.findNextString(pos);
-				continue;
-			}
+			lastUnmerged = rawPath;
 			path.m_Action = CTGitPath::LOGACTIONS_UNMERGED;
 		}
 
@@ -1098,10 +1137,52 @@ void CTGitPathList::UpdateStagingStatusFromPath(const CString& path, CTGitPath::
 	}
 }
 
-int CTGitPathList::FillUnRev(unsigned int action, const CTGitPathList* list, CString* err)
+int CTGitPathList::FillUnRev(unsigned int action, const CTGitPathList* list, CString* err, CGit* git)
 {
 	this->Clear();
 	CTGitPath path;
+	if (!git)
+		git = &g_Git;
+
+	// falls back to git.exe in case of an error, cf. CGit::GetWorkingTreeChanges()
+	auto fillUnRevLibGit2 = [&]() {
+		CAutoRepository repo(git->GetGitRepository());
+		if (!repo)
+			return false;
+
+		std::vector<CStringA> pathspecBuffers;
+		std::vector<char*> pathspecPointers;
+		git_status_options opts = GIT_STATUS_OPTIONS_INIT;
+		CGit::GetPathspecs(list, pathspecBuffers, pathspecPointers, opts.pathspec);
+		opts.show = GIT_STATUS_SHOW_WORKDIR_ONLY;
+		const bool ignored = (action & CTGitPath::LOGACTIONS_IGNORE) != 0;
+		if (ignored)
+			opts.flags = GIT_STATUS_OPT_INCLUDE_IGNORED | GIT_STATUS_OPT_RECURSE_IGNORED_DIRS;
+		else
+			opts.flags = GIT_STATUS_OPT_INCLUDE_UNTRACKED | GIT_STATUS_OPT_RECURSE_UNTRACKED_DIRS;
+
+		CAutoStatusList status;
+		if (git_status_list_new(status.GetPointer(), repo, &opts) < 0)
+			return false;
+
+		// same format as "git ls-files --others -z", e.g. nested repositories end with a slash
+		BYTE_VECTOR out;
+		for (size_t i = 0, count = git_status_list_entrycount(status); i < count; ++i)
+		{
+			const git_status_entry* entry = git_status_byindex(status, i);
+			if (!(entry->status & (ignored ? GIT_STATUS_IGNORED : GIT_STATUS_WT_NEW)) || !entry->index_to_workdir)
+				continue;
+			out.append(entry->index_to_workdir->new_file.path, strlen(entry->index_to_workdir->new_file.path) + 1);
+		}
+		return ParserFromLsFileSimple(out, action, false) >= 0;
+	};
+	if (git->UsingLibGit2(CGit::GIT_CMD_WORKINGTREECHANGES))
+	{
+		if (fillUnRevLibGit2())
+			return 0;
+		CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": libgit2 failed, falling back to git.exe: %s\n", static_cast<LPCWSTR>(CGit::GetLibGit2LastErr()));
+		this->Clear();
+	}
 
 	const int count = [list]() {
 		if (!list)
@@ -1131,7 +1212,7 @@ int CTGitPathList::FillUnRev(unsigned int action, const CTGitPathList* list, CSt
 		}
 
 		BYTE_VECTOR out, errb;
-		if (g_Git.Run(cmd, &out, &errb))
+		if (git->Run(cmd, &out, &errb))
 		{
 			if (err)
 				*err = errb;
@@ -1241,12 +1322,13 @@ int CTGitPathList::ParserFromLog(const BYTE_VECTOR& log)
 {
 	static bool mergeReplacedStatus = CRegDWORD(L"Software\\TortoiseGit\\MergeReplacedStatusKS", TRUE, false, HKEY_LOCAL_MACHINE) == TRUE; // TODO: remove kill-switch
 	this->Clear();
-	std::map<CString, size_t> duplicateMap;
+	// paths are looked up by their UTF-8 bytes in log, so that only new paths have to be converted
+	std::unordered_map<std::string_view, size_t> duplicateMap;
 	size_t pos = 0;
 	CTGitPath path;
 	m_Action=0;
-	CString StatAdd;
-	CString StatDel;
+	int StatAdd = CTGitPath::STAT_UNKNOWN;
+	int StatDel = CTGitPath::STAT_UNKNOWN;
 	CString pathname1;
 	CString pathname2;
 
@@ -1285,24 +1367,23 @@ int CTGitPathList::ParserFromLog(const BYTE_VECTOR& log)
 				return -1;
 			++pos;
 
-			pathname2.Empty();
+			std::string_view rawPathname2;
 			if (log[statusStart] == 'C' || log[statusStart] == 'R')
 			{
 				const size_t filenameEnd = log.find('\0', pos);
 				if (filenameEnd == BYTE_VECTOR::npos || pos == filenameEnd || filenameEnd - pos >= INT_MAX)
 					return -1;
 				// old filename before rename
-				CGit::StringAppend(pathname2, &log[pos], CP_UTF8, static_cast<int>(filenameEnd - pos));
+				rawPathname2 = std::string_view(&log[pos], filenameEnd - pos);
 				pos = filenameEnd + 1;
 			}
 			const size_t filenameEnd = log.find('\0', pos);
 			if (filenameEnd == BYTE_VECTOR::npos || pos == filenameEnd || filenameEnd - pos >= INT_MAX)
 				return -1;
-			pathname1.Empty();
-			CGit::StringAppend(pathname1, &log[pos], CP_UTF8, static_cast<int>(filenameEnd - pos));
+			const std::string_view rawPathname1(&log[pos], filenameEnd - pos);
 			pos = filenameEnd + 1;
 
-			if (const auto existing = duplicateMap.find(pathname1); existing != duplicateMap.end())
+			if (const auto existing = duplicateMap.find(rawPathname1); existing != duplicateMap.end())
 			{
 				CTGitPath& p = m_paths[existing->second];
 				if (!(mergeReplacedStatus && p.m_Action == CTGitPath::LOGACTIONS_REPLACED && (log[statusStart] == 'A' || log[statusStart] == 'D')))
@@ -1329,15 +1410,19 @@ int CTGitPathList::ParserFromLog(const BYTE_VECTOR& log)
 				else
 					isSubmodule = (modeNew & S_IFDIR) == S_IFDIR;
 
+				pathname1.Empty();
+				CGit::StringAppend(pathname1, rawPathname1.data(), CP_UTF8, static_cast<int>(rawPathname1.size()));
+				pathname2.Empty();
+				CGit::StringAppend(pathname2, rawPathname2.data(), CP_UTF8, static_cast<int>(rawPathname2.size()));
 				// SetFromGit resets the path, hence action must be set afterwards
 				path.SetFromGit(pathname1, &pathname2, &isSubmodule);
 				path.m_Action=ac;
 				this->m_Action|=ac;
 
 				AddPath(path);
-				duplicateMap.insert(std::pair<CString, size_t>(path.GetGitPathString(), m_paths.size() - 1));
-				if (mergeReplacedStatus && !pathname2.IsEmpty())
-					duplicateMap.insert(std::pair<CString, size_t>(path.GetGitOldPathString(), m_paths.size() - 1));
+				duplicateMap.emplace(rawPathname1, m_paths.size() - 1);
+				if (mergeReplacedStatus && !rawPathname2.empty())
+					duplicateMap.emplace(rawPathname2, m_paths.size() - 1);
 			}
 		}
 		else // numstat output
@@ -1346,44 +1431,37 @@ int CTGitPathList::ParserFromLog(const BYTE_VECTOR& log)
 			if (tabstart == BYTE_VECTOR::npos || tabstart - pos >= INT_MAX)
 				return -1;
 
-			StatAdd.Empty();
-			CGit::StringAppend(StatAdd, &log[pos], CP_UTF8, static_cast<int>(tabstart - pos));
+			StatAdd = CTGitPath::ParseStat(&log[pos], tabstart - pos);
 			pos = tabstart + 1;
 
 			tabstart = log.find('\t', pos); // find end of second number (removed lines)
 			if (tabstart == BYTE_VECTOR::npos || tabstart - pos >= INT_MAX)
 				return -1;
 
-			StatDel.Empty();
-			CGit::StringAppend(StatDel, &log[pos], CP_UTF8, static_cast<int>(tabstart - pos));
+			StatDel = CTGitPath::ParseStat(&log[pos], tabstart - pos);
 			pos = tabstart + 1;
 
 			if (pos >= logend)
 				return -1;
 
-			pathname2.Empty();
+			std::string_view rawPathname2;
 			if (log[pos] == '\0') // rename which holds an "old" pathname
 			{
 				++pos;
 				const size_t endPathname = log.find('\0', pos);
 				if (endPathname == BYTE_VECTOR::npos || pos == endPathname || endPathname - pos >= INT_MAX)
 					return -1;
-				CGit::StringAppend(pathname2, &log[pos], CP_UTF8, static_cast<int>(endPathname - pos));
+				rawPathname2 = std::string_view(&log[pos], endPathname - pos);
 				pos = endPathname + 1;
 			}
 			const size_t endPathname = log.find('\0', pos);
 			if (endPathname == BYTE_VECTOR::npos || pos == endPathname || endPathname - pos >= INT_MAX)
 				return -1;
-			pathname1.Empty();
-			CGit::StringAppend(pathname1, &log[pos], CP_UTF8, static_cast<int>(endPathname - pos));
+			const std::string_view rawPathname1(&log[pos], endPathname - pos);
 			pos = endPathname + 1;
 
-			// SetFromGit resets the path
-			int isSubmodule = FALSE;
-			path.SetFromGit(pathname1, &pathname2, &isSubmodule);
-
-			auto existing = duplicateMap.find(path.GetGitPathString());
-			if (existing != duplicateMap.end())
+			// usually the raw output already listed the file
+			if (auto existing = duplicateMap.find(rawPathname1); existing != duplicateMap.end())
 			{
 				CTGitPath& p = m_paths[existing->second];
 				p.m_StatAdd = StatAdd;
@@ -1391,10 +1469,17 @@ int CTGitPathList::ParserFromLog(const BYTE_VECTOR& log)
 			}
 			else
 			{
+				pathname1.Empty();
+				CGit::StringAppend(pathname1, rawPathname1.data(), CP_UTF8, static_cast<int>(rawPathname1.size()));
+				pathname2.Empty();
+				CGit::StringAppend(pathname2, rawPathname2.data(), CP_UTF8, static_cast<int>(rawPathname2.size()));
+				// SetFromGit resets the path
+				int isSubmodule = FALSE;
+				path.SetFromGit(pathname1, &pathname2, &isSubmodule);
 				path.m_StatAdd = StatAdd;
 				path.m_StatDel = StatDel;
 				AddPath(path);
-				duplicateMap.insert(std::pair<CString, size_t>(path.GetGitPathString(), m_paths.size() - 1));
+				duplicateMap.emplace(rawPathname1, m_paths.size() - 1);
 			}
 		}
 	}
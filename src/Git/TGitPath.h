@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2014 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -21,6 +21,8 @@
 #pragma once
 #include "gittype.h"
 
+class CGit;
+
 #define PARENT_MASK   0xFFFFFF
 #define MERGE_MASK	(0x1000000)
 
@@ -65,8 +67,18 @@ public:
 		LOGACTIONS_GRAY		= 0x10000000,
 	};
 
-	CString m_StatAdd;
-	CString m_StatDel;
+	enum : int
+	{
+		STAT_UNKNOWN = -2,	///< no numstat available
+		STAT_BINARY = -1,	///< "-" in the numstat output
+	};
+	/// numbers of added and removed lines, STAT_UNKNOWN or STAT_BINARY; negative, so that they sort before any number
+	int m_StatAdd = STAT_UNKNOWN;
+	int m_StatDel = STAT_UNKNOWN;
+	/// formats a line count as git does it, i.e. "-" for binary files
+	static CString FormatStat(int stat);
+	/// parses a line count of the numstat output
+	static int ParseStat(const char* p, size_t length);
 	StagingStatus m_stagingStatus = StagingStatus::DontCare;
 #ifdef TGIT_LFS
 	CString m_LFSLockOwner;
@@ -112,6 +124,13 @@ public:
 
 	const CString& GetGitOldPathString() const;
 
+	/**
+	 * Lets the path strings share their buffers with equal paths of other
+	 * CTGitPath objects (cf. CGitStringPool). Only useful for long living
+	 * lists with lots of recurring paths, such as the files of the log.
+	 */
+	void InternPaths();
+
 	/**
 	 * Returns the path for showing in an UI.
 	 *
@@ -381,7 +400,8 @@ public:
 	int ParserFromLsFileSimple(const BYTE_VECTOR& out, unsigned int action, bool clear = true);
 	int ParserFromLsFile(const BYTE_VECTOR& out);
 	void UpdateStagingStatusFromPath(const CString& path, CTGitPath::StagingStatus status);
-	int FillUnRev(unsigned int Action, const CTGitPathList* filterlist = nullptr, CString* err = nullptr);
+	/// \a git defaults to g_Git
+	int FillUnRev(unsigned int Action, const CTGitPathList* filterlist = nullptr, CString* err = nullptr, CGit* git = nullptr);
 #ifdef TGIT_LFS
 	int FillLFSLocks(unsigned int action, CString* err = nullptr);
 #ifndef GOOGLETEST_INCLUDE_GTEST_GTEST_H_
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2017, 2019-2021, 2023 - TortoiseGit
+// Copyright (C) 2008-2017, 2019-2021, 2023, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -34,11 +34,11 @@ class CGitByteArray : private std::vector<char>
 public:
 	size_t find(char data, size_t start = 0) const
 	{
-		const size_t end = size();
-		for (size_t i = start; i < end; ++i)
-			if ((*this)[i] == data)
-				return i;
-		return npos;
+		if (start >= size())
+			return npos;
+		// memchr is vectorized by the CRT
+		const auto found = static_cast<const char*>(memchr(this->data() + start, data, size() - start));
+		return found ? static_cast<size_t>(found - this->data()) : npos;
 	}
 	size_t RevertFind(char data, size_t start = npos) const
 	{
@@ -0,0 +1,249 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "BlameCache.h"
+#include "PathUtils.h"
+#include "UnicodeUtils.h"
+#include "Hash.h"
+
+#define BLAMECACHE_VERSION 1
+// number of cached commits per path and options
+#define BLAMECACHE_MAX_ENTRIES 16
+
+void CBlameCache::SetKey(const CGitHash& commit, const CString& path, const CString& options)
+{
+	m_commit.Empty();
+	m_path = path;
+	m_directory = CPathUtils::GetLocalAppDataDirectory();
+	if (commit.IsEmpty() || m_directory.IsEmpty())
+		return;
+
+	const CStringA key = CUnicodeUtils::GetUTF8(path + L'\n' + options);
+	m_directory += L"blamecache\\";
+	m_directory += GetHashText(static_cast<LPCSTR>(key), key.GetLength(), HashType::HashSha1).c_str();
+	m_directory += L'\\';
+	m_commit = commit;
+}
+
+bool CBlameCache::Load(Hunks& hunks) const
+{
+	if (!IsEnabled())
+		return false;
+	return LoadFile(GetEntryPath(m_commit), hunks);
+}
+
+bool CBlameCache::LoadAncestor(git_repository* repo, CGitHash& ancestor, Hunks& hunks) const
+{
+	if (!IsEnabled())
+		return false;
+
+	WIN32_FIND_DATA data;
+	CAutoFindFile handle = ::FindFirstFileEx(m_directory + L"*", FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, 0);
+	if (!handle)
+		return false;
+
+	// the most recent ancestor most likely leaves the fewest commits to walk
+	CGitHash best;
+	git_time_t bestTime = 0;
+	do
+	{
+		bool isHash = false;
+		const auto candidate = CGitHash::FromHexStr(CString(data.cFileName), &isHash);
+		if (!isHash || candidate == m_commit)
+			continue;
+		if (git_graph_descendant_of(repo, m_commit, candidate) != 1)
+			continue;
+		CAutoCommit commit;
+		if (git_commit_lookup(commit.GetPointer(), repo, candidate))
+			continue;
+		if (best.IsEmpty() || git_commit_time(commit) > bestTime)
+		{
+			best = candidate;
+			bestTime = git_commit_time(commit);
+		}
+	} while (::FindNextFile(handle, &data));
+
+	if (best.IsEmpty() || !LoadFile(GetEntryPath(best), hunks))
+		return false;
+	ancestor = best;
+	return true;
+}
+
+bool CBlameCache::LoadFile(const CString& filename, Hunks& hunks)
+{
+	hunks.clear();
+	CAutoFILE pFile = _wfsopen(filename, L"rb", _SH_DENYWR);
+	if (!pFile)
+		return false;
+
+	auto read = [&pFile](auto& value) { return fread(&value, sizeof(value), 1, pFile) == 1; };
+
+	UINT32 value = 0;
+	if (!read(value) || value != BLAMECACHE_VERSION)
+		return false;
+
+	UINT32 numberOfFilenames = 0;
+	if (!read(numberOfFilenames) || numberOfFilenames > 0xFFFF)
+		return false;
+	std::vector<CString> filenames(numberOfFilenames);
+	for (auto& name : filenames)
+	{
+		if (!read(value) || value > SHRT_MAX)
+			return false;
+		if (value && fread(CStrBuf(name, static_cast<int>(value), 0), sizeof(wchar_t), value, pFile) != value)
+			return false;
+	}
+
+	UINT32 numberOfHunks = 0;
+	if (!read(numberOfHunks) || numberOfHunks > INT_MAX / sizeof(CTortoiseGitBlameData::BlameHunk))
+		return false;
+	hunks.resize(numberOfHunks);
+	int nextLine = 1;
+	for (auto& hunk : hunks)
+	{
+		unsigned char rawHash[GIT_HASH_SIZE];
+		UINT32 filenameIndex = 0;
+		if (fread(rawHash, sizeof(rawHash), 1, pFile) != 1 || !read(hunk.originalLine) || !read(hunk.finalLine) || !read(hunk.numberOfLines) || !read(filenameIndex))
+			break;
+		// hunks are stored in line order without gaps
+		if (filenameIndex >= numberOfFilenames || hunk.finalLine != nextLine || hunk.numberOfLines <= 0)
+			break;
+		hunk.hash = CGitHash::FromRaw(rawHash);
+		hunk.filename = filenames[filenameIndex];
+		nextLine += hunk.numberOfLines;
+		--numberOfHunks;
+	}
+	if (numberOfHunks)
+	{
+		hunks.clear();
+		return false;
+	}
+	return true;
+}
+
+void CBlameCache::Save(const Hunks& hunks) const
+{
+	if (!IsEnabled() || hunks.empty())
+		return;
+
+	CreateDirectory(CPathUtils::GetLocalAppDataDirectory() + L"blamecache", nullptr);
+	CreateDirectory(m_directory, nullptr);
+
+	std::vector<CString> filenames;
+	std::vector<UINT32> filenameIndexes;
+	filenameIndexes.reserve(hunks.size());
+	for (const auto& hunk : hunks)
+	{
+		auto it = std::find(filenames.cbegin(), filenames.cend(), hunk.filename);
+		filenameIndexes.push_back(static_cast<UINT32>(it - filenames.cbegin()));
+		if (it == filenames.cend())
+			filenames.push_back(hunk.filename);
+	}
+
+	// write to a temporary file first, so that readers never see a partial entry
+	const CString entryPath = GetEntryPath(m_commit);
+	const CString tempPath = entryPath + L".tmp";
+	{
+		CAutoFILE pFile = _wfsopen(tempPath, L"wb", _SH_DENYRW);
+		if (!pFile)
+			return;
+
+		bool ok = true;
+		auto write = [&pFile, &ok](const auto& value) { ok = ok && fwrite(&value, sizeof(value), 1, pFile) == 1; };
+		write(static_cast<UINT32>(BLAMECACHE_VERSION));
+		write(static_cast<UINT32>(filenames.size()));
+		for (const auto& name : filenames)
+		{
+			write(static_cast<UINT32>(name.GetLength()));
+			ok = ok && fwrite(static_cast<LPCWSTR>(name), sizeof(wchar_t), name.GetLength(), pFile) == static_cast<size_t>(name.GetLength());
+		}
+		write(static_cast<UINT32>(hunks.size()));
+		for (size_t i = 0; i < hunks.size(); ++i)
+		{
+			ok = ok && fwrite(hunks[i].hash.ToRaw(), GIT_HASH_SIZE, 1, pFile) == 1;
+			write(hunks[i].originalLine);
+			write(hunks[i].finalLine);
+			write(hunks[i].numberOfLines);
+			write(filenameIndexes[i]);
+		}
+		if (!ok)
+		{
+			pFile.CloseHandle();
+			DeleteFile(tempPath);
+			return;
+		}
+	}
+	if (!MoveFileEx(tempPath, entryPath, MOVEFILE_REPLACE_EXISTING))
+	{
+		DeleteFile(tempPath);
+		return;
+	}
+
+	Prune();
+}
+
+void CBlameCache::Prune() const
+{
+	std::vector<std::pair<ULONGLONG, CString>> entries;
+	WIN32_FIND_DATA data;
+	CAutoFindFile handle = ::FindFirstFileEx(m_directory + L"*", FindExInfoBasic, &data, FindExSearchNameMatch, nullptr, 0);
+	if (!handle)
+		return;
+	do
+	{
+		if (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY)
+			continue;
+		const ULONGLONG writeTime = (static_cast<ULONGLONG>(data.ftLastWriteTime.dwHighDateTime) << 32) | data.ftLastWriteTime.dwLowDateTime;
+		entries.emplace_back(writeTime, data.cFileName);
+	} while (::FindNextFile(handle, &data));
+
+	if (entries.size() <= BLAMECACHE_MAX_ENTRIES)
+		return;
+
+	// remove the least recently written entries
+	std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return a.first > b.first; });
+	for (size_t i = BLAMECACHE_MAX_ENTRIES; i < entries.size(); ++i)
+		DeleteFile(m_directory + entries[i].second);
+}
+
+bool CBlameCache::Resolve(const CTortoiseGitBlameData::BlameHunk& hunk, const Hunks& ancestorHunks, Hunks& resolved)
+{
+	// the original lines of the hunk are lines of the ancestor's version of the file
+	int line = hunk.originalLine;
+	const int end = hunk.originalLine + hunk.numberOfLines;
+	auto it = std::upper_bound(ancestorHunks.cbegin(), ancestorHunks.cend(), line, [](int l, const auto& ancestorHunk) { return l < ancestorHunk.finalLine; });
+	if (it == ancestorHunks.cbegin())
+		return false;
+	--it;
+	for (; line < end; ++it)
+	{
+		if (it == ancestorHunks.cend() || line < it->finalLine || line >= it->finalLine + it->numberOfLines)
+			return false;
+		const int count = std::min(end, it->finalLine + it->numberOfLines) - line;
+		CTortoiseGitBlameData::BlameHunk part;
+		part.hash = it->hash;
+		part.originalLine = it->originalLine + line - it->finalLine;
+		part.finalLine = hunk.finalLine + line - hunk.originalLine;
+		part.numberOfLines = count;
+		part.filename = it->filename;
+		resolved.push_back(part);
+		line += count;
+	}
+	return true;
+}
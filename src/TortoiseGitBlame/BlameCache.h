@@ -0,0 +1,64 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include "TortoiseGitBlameData.h"
+
+/**
+ * On-disk cache of blame results.
+ *
+ * An entry holds the hunks of a complete blame and is keyed by the blamed
+ * commit, the path and the options which influence the result (e.g. the
+ * detection of moved or copied lines, the diff algorithm). Entries are stored in
+ * %LOCALAPPDATA%\TortoiseGit\blamecache\<hash of path and options>\<commit>,
+ * so that the entries for ancestors of a commit can be found as well.
+ */
+class CBlameCache
+{
+public:
+	using Hunks = std::vector<CTortoiseGitBlameData::BlameHunk>;
+
+	CBlameCache() = default;
+
+	/// sets the key, the cache stays disabled if \a commit is empty
+	void			SetKey(const CGitHash& commit, const CString& path, const CString& options);
+	bool			IsEnabled() const { return !m_commit.IsEmpty(); }
+	const CString&	GetPath() const { return m_path; }
+
+	/// loads the blame of the commit itself
+	bool			Load(Hunks& hunks) const;
+	/// loads the blame of the most recent cached ancestor of the commit
+	bool			LoadAncestor(git_repository* repo, CGitHash& ancestor, Hunks& hunks) const;
+	void			Save(const Hunks& hunks) const;
+
+	/**
+	 * Maps a hunk which "git blame <commit> ^<ancestor>" attributed to the
+	 * ancestor onto the cached blame of the ancestor.
+	 * \return false if a line of the hunk is not covered by \a ancestorHunks
+	 */
+	static bool		Resolve(const CTortoiseGitBlameData::BlameHunk& hunk, const Hunks& ancestorHunks, Hunks& resolved);
+
+private:
+	CString			GetEntryPath(const CGitHash& commit) const { return m_directory + commit.ToString(); }
+	static bool		LoadFile(const CString& filename, Hunks& hunks);
+	void			Prune() const;
+
+	CGitHash		m_commit;
+	CString			m_path;
+	CString			m_directory;
+};
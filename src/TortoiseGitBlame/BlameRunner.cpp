@@ -0,0 +1,273 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "BlameRunner.h"
+#include "BlameCache.h"
+#include "Git.h"
+
+namespace
+{
+// minimum time between two batches of hunks, in ms
+constexpr ULONGLONG BLAME_BATCH_INTERVAL = 100;
+
+struct BlameThreadData
+{
+	HWND								hNotifyWnd = nullptr;
+	CString								cmd;
+	LONG								generation = 0;
+	bool								bStream = true;
+	std::shared_ptr<CBlameRunner::State>	pState;
+	std::unique_ptr<CBlameRunner::Ancestor>	pAncestor;
+};
+
+/**
+ * Parses the output of "git blame --incremental":
+ * every hunk starts with "<hash> <original line> <final line> <number of lines>",
+ * followed by commit information (only the first time a commit is seen)
+ * and ends with "filename <filename>".
+ */
+class CIncrementalBlameCall : public CGitCall
+{
+public:
+	CIncrementalBlameCall(const BlameThreadData& data, const CString& cmd, const CBlameRunner::Ancestor* pAncestor)
+		: CGitCall(cmd)
+		, m_data(data)
+		, m_pAncestor(pAncestor)
+		, m_pResult(std::make_unique<CBlameRunner::Result>())
+	{
+	}
+
+	~CIncrementalBlameCall()
+	{
+		if (!m_hProcess)
+			return;
+		CAutoLocker lock(m_data.pState->critSec);
+		auto& processes = m_data.pState->processes;
+		processes.erase(std::remove(processes.begin(), processes.end(), static_cast<HANDLE>(m_hProcess)), processes.end());
+	}
+
+	void OnStarted(HANDLE hProcess) override
+	{
+		if (!DuplicateHandle(GetCurrentProcess(), hProcess, GetCurrentProcess(), m_hProcess.GetPointer(), 0, FALSE, DUPLICATE_SAME_ACCESS))
+			return;
+		CAutoLocker lock(m_data.pState->critSec);
+		// Cancel() might have been called before the process was registered
+		if (IsCancelled())
+			TerminateProcess(m_hProcess, 1);
+		m_data.pState->processes.push_back(m_hProcess);
+	}
+
+	/// set if a line could not be resolved through the blame of the ancestor
+	bool NeedsFullBlame() const { return m_bNeedsFullBlame; }
+
+	bool OnOutputData(const char* data, size_t size) override
+	{
+		if (IsCancelled() || m_bNeedsFullBlame)
+			return true;
+
+		m_buffer.append(data, size);
+		size_t lineBegin = 0;
+		for (size_t lineEnd; !m_bNeedsFullBlame && (lineEnd = m_buffer.find('\n', lineBegin)) != std::string::npos; lineBegin = lineEnd + 1)
+			ParseLine(m_buffer.c_str() + lineBegin, lineEnd - lineBegin);
+		m_buffer.erase(0, lineBegin);
+
+		if (m_data.bStream && !m_pResult->hunks.empty() && GetTickCount64() - m_lastPost >= BLAME_BATCH_INTERVAL)
+			return !Post();
+		return false;
+	}
+
+	bool OnOutputErrData(const char* data, size_t size) override
+	{
+		m_error.append(data, size);
+		return false;
+	}
+
+	void Finish(int exitCode)
+	{
+		if (IsCancelled())
+			return;
+		m_pResult->bDone = true;
+		m_pResult->exitCode = exitCode;
+		if (exitCode)
+			m_pResult->error = m_error;
+		Post();
+	}
+
+private:
+	bool IsCancelled() const
+	{
+		return m_data.pState->generation != m_data.generation;
+	}
+
+	bool Post()
+	{
+		m_pResult->generation = m_data.generation;
+		const bool bPosted = CBlameRunner::Post(m_data.hNotifyWnd, m_data.pState, std::move(m_pResult));
+		m_pResult = std::make_unique<CBlameRunner::Result>();
+		m_lastPost = GetTickCount64();
+		return bPosted;
+	}
+
+	// the line is followed by a LF, so that strtol() stops there at the latest
+	void ParseLine(const char* line, size_t length)
+	{
+		if (!m_bInHunk)
+		{
+			if (length <= 2 * GIT_HASH_SIZE || line[2 * GIT_HASH_SIZE] != ' ')
+				return;
+			m_hunk.hash = CGitHash::FromHexStr(std::string_view(line, 2 * GIT_HASH_SIZE));
+			char* end = nullptr;
+			m_hunk.originalLine = strtol(line + 2 * GIT_HASH_SIZE + 1, &end, 10);
+			m_hunk.finalLine = strtol(end, &end, 10);
+			m_hunk.numberOfLines = strtol(end, &end, 10);
+			m_bInHunk = true;
+			return;
+		}
+
+		if (std::string_view(line, length) == "boundary")
+		{
+			m_boundaries.insert(m_hunk.hash);
+			return;
+		}
+
+		constexpr std::string_view filenameTag = "filename ";
+		if (length < filenameTag.size() || std::string_view(line, filenameTag.size()) != filenameTag)
+			return;
+
+		// all hunks usually have the same filename, share the string
+		const std::string_view filename(line + filenameTag.size(), length - filenameTag.size());
+		if (filename != m_lastFilenameA)
+		{
+			m_lastFilenameA = filename;
+			m_lastFilename = CTortoiseGitBlameData::UnquoteFilename(CStringA(filename.data(), static_cast<int>(filename.size())));
+		}
+		m_hunk.filename = m_lastFilename;
+		m_bInHunk = false;
+
+		if (m_pAncestor && m_hunk.hash == m_pAncestor->hash)
+		{
+			if (m_hunk.filename != m_pAncestor->path || !CBlameCache::Resolve(m_hunk, m_pAncestor->hunks, m_pResult->hunks))
+				m_bNeedsFullBlame = true;
+			return;
+		}
+		// any other commit at the boundary of the walk cannot be resolved
+		if (m_pAncestor && m_boundaries.contains(m_hunk.hash))
+		{
+			m_bNeedsFullBlame = true;
+			return;
+		}
+		m_pResult->hunks.push_back(m_hunk);
+	}
+
+	const BlameThreadData&					m_data;
+	CAutoGeneralHandle						m_hProcess;
+	const CBlameRunner::Ancestor*			m_pAncestor;
+	bool									m_bNeedsFullBlame = false;
+	std::unordered_set<CGitHash>			m_boundaries;
+	std::unique_ptr<CBlameRunner::Result>	m_pResult;
+	std::string								m_buffer;
+	BYTE_VECTOR								m_error;
+	ULONGLONG								m_lastPost = 0;
+
+	bool									m_bInHunk = false;
+	CTortoiseGitBlameData::BlameHunk		m_hunk;
+	std::string								m_lastFilenameA;
+	CString									m_lastFilename;
+};
+}
+
+bool CBlameRunner::Start(HWND hNotifyWnd, const CString& cmd, std::unique_ptr<Ancestor> pAncestor, bool bStream)
+{
+	auto pData = new BlameThreadData;
+	pData->hNotifyWnd = hNotifyWnd;
+	pData->cmd = cmd;
+	pData->bStream = bStream;
+	Cancel();
+	pData->generation = m_pState->generation;
+	pData->pState = m_pState;
+	pData->pAncestor = std::move(pAncestor);
+	if (!AfxBeginThread(BlameThreadEntry, pData, THREAD_PRIORITY_BELOW_NORMAL))
+	{
+		delete pData;
+		return false;
+	}
+	return true;
+}
+
+UINT CBlameRunner::BlameThreadEntry(LPVOID pVoid)
+{
+	std::unique_ptr<BlameThreadData> pData(static_cast<BlameThreadData*>(pVoid));
+	CIncrementalBlameCall call(*pData, pData->cmd, pData->pAncestor.get());
+	const int exitCode = g_Git.Run(call);
+	if (!call.NeedsFullBlame() || pData->pState->generation != pData->generation)
+	{
+		call.Finish(exitCode);
+		return 0;
+	}
+
+	// the hunks reported so far are correct, the full blame just reports them again
+	CIncrementalBlameCall fullCall(*pData, pData->pAncestor->fullCmd, nullptr);
+	fullCall.Finish(g_Git.Run(fullCall));
+	return 0;
+}
+
+bool CBlameRunner::StartCached(HWND hNotifyWnd, std::vector<CTortoiseGitBlameData::BlameHunk>&& hunks)
+{
+	auto pResult = std::make_unique<Result>();
+	Cancel();
+	pResult->generation = m_pState->generation;
+	pResult->hunks = std::move(hunks);
+	pResult->bDone = true;
+	return Post(hNotifyWnd, m_pState, std::move(pResult));
+}
+
+bool CBlameRunner::Post(HWND hNotifyWnd, const std::shared_ptr<State>& pState, std::unique_ptr<Result>&& pResult)
+{
+	{
+		CAutoLocker lock(pState->critSec);
+		if (pResult->generation != pState->generation)
+			return false;
+		pState->results.push_back(std::move(pResult));
+	}
+	// the batch stays queued if this fails, it is freed with the state
+	return ::PostMessage(hNotifyWnd, WM_BLAMEPROGRESS, 0, 0) != FALSE;
+}
+
+std::vector<std::unique_ptr<CBlameRunner::Result>> CBlameRunner::TakeResults()
+{
+	CAutoLocker lock(m_pState->critSec);
+	std::vector<std::unique_ptr<Result>> results;
+	for (auto& pResult : m_pState->results)
+	{
+		if (pResult->generation == m_pState->generation)
+			results.push_back(std::move(pResult));
+	}
+	m_pState->results.clear();
+	return results;
+}
+
+void CBlameRunner::Cancel()
+{
+	CAutoLocker lock(m_pState->critSec);
+	++m_pState->generation;
+	m_pState->results.clear();
+	// the workers notice the cancellation only on output, git might not write anything for a long time
+	for (auto hProcess : m_pState->processes)
+		TerminateProcess(hProcess, 1);
+}
@@ -0,0 +1,97 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include "TortoiseGitBlameData.h"
+#include <atomic>
+
+/// posted to the notification window for every batch of hunks, the batches are fetched with CBlameRunner::TakeResults()
+#define WM_BLAMEPROGRESS (WM_APP + 1)
+
+/**
+ * Runs "git blame --incremental" on a worker thread and reports the hunks
+ * in batches while git is still working, so that the blame view can be
+ * filled progressively instead of waiting for the complete output.
+ *
+ * Every started blame gets a generation number; a blame is cancelled as
+ * soon as a newer one is started (its git process is terminated), and
+ * results which do not belong to the latest generation are dropped by the
+ * receiver.
+ *
+ * The batches are kept by the runner until the receiver takes them, so
+ * nothing leaks if the notification window is gone before it gets the
+ * message.
+ *
+ * If the blame of an ancestor is known, git only needs to walk the commits
+ * after the ancestor; the lines git attributes to the ancestor are then
+ * looked up in the ancestor's blame.
+ */
+class CBlameRunner
+{
+public:
+	struct Result
+	{
+		LONG		generation = 0;
+		std::vector<CTortoiseGitBlameData::BlameHunk> hunks;
+		bool		bDone = false;	///< last batch, git exited
+		int			exitCode = 0;
+		CString		error;
+	};
+
+	/// a known blame of an ancestor of the blamed commit
+	struct Ancestor
+	{
+		CGitHash	hash;
+		CString		path;		///< the path of the blamed file in the ancestor
+		std::vector<CTortoiseGitBlameData::BlameHunk> hunks;
+		CString		fullCmd;	///< blames all commits, used if a line cannot be resolved through the ancestor's blame
+	};
+
+	/// shared with the worker threads, so that they can check for cancellation after the runner is gone
+	struct State
+	{
+		std::atomic<LONG>		generation = 0;
+		CComAutoCriticalSection	critSec;
+		std::vector<HANDLE>		processes;	///< the running git processes, so that they can be terminated on cancellation
+		std::vector<std::unique_ptr<Result>> results;	///< the batches which were not taken by the receiver yet
+	};
+
+	CBlameRunner() = default;
+	~CBlameRunner() { Cancel(); }
+
+	/**
+	 * Starts \a cmd (a "git blame --incremental" command line) on a worker thread.
+	 * WM_BLAMEPROGRESS is posted to \a hNotifyWnd for each batch of hunks.
+	 * If \a pAncestor is set, \a cmd has to exclude the ancestor and its history.
+	 * If \a bStream is false, all hunks are reported at once after git exited.
+	 * \return false if the thread could not be started
+	 */
+	bool			Start(HWND hNotifyWnd, const CString& cmd, std::unique_ptr<Ancestor> pAncestor = nullptr, bool bStream = true);
+	/// reports \a hunks (e.g. from the cache) as a finished blame without running git
+	bool			StartCached(HWND hNotifyWnd, std::vector<CTortoiseGitBlameData::BlameHunk>&& hunks);
+	/// stops reporting the results of the running blame and terminates its git process
+	void			Cancel();
+	/// returns the batches of the running blame in the order they were reported, older ones are discarded
+	std::vector<std::unique_ptr<Result>> TakeResults();
+
+private:
+	static UINT		BlameThreadEntry(LPVOID pVoid);
+	static bool		Post(HWND hNotifyWnd, const std::shared_ptr<State>& pState, std::unique_ptr<Result>&& pResult);
+
+	std::shared_ptr<State>	m_pState = std::make_shared<State>();
+};
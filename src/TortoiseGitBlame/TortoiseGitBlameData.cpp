@@ -1,6 +1,6 @@
 ﻿// TortoiseGitBlame - a Viewer for Git Blames
 
-// Copyright (C) 2008-2021, 2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2021, 2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2003 Don HO <donho@altern.org>
 
 // This program is free software; you can redistribute it and/or
@@ -76,192 +76,162 @@ int CTortoiseGitBlameData::GetEncode(const char* buff, int size, int* bomoffset)
 	return GetACP();
 }
 
-void CTortoiseGitBlameData::ParseBlameOutput(BYTE_VECTOR &data, CGitHashMap & HashToRev, DWORD dateFormat, bool bRelativeTimes)
+void CTortoiseGitBlameData::SetContent(BYTE_VECTOR&& content)
 {
-	std::unordered_map<CGitHash, CString> hashToFilename;
-
-	std::vector<CGitHash>		hashes;
-	std::vector<int>			originalLineNumbers;
-	std::vector<CString>		filenames;
-	std::vector<BYTE_VECTOR>	rawLines;
-	std::vector<CString>		authors;
-	std::vector<CString>		dates;
-
-	CGitHash hash;
-	int originalLineNumber = 0;
-	int numberOfSubsequentLines = 0;
-	CString filename;
-
-	size_t pos = 0;
-	bool expectHash = true;
-	while (pos < data.size())
+	m_RawData = std::move(content);
+
+	// split the same way git blame does, i.e. only at LF
+	m_LineOffsets.clear();
+	const size_t size = m_RawData.size();
+	for (size_t pos = 0; pos < size;)
 	{
-		if (data[pos] == 0)
-		{
-			++pos;
-			continue;
-		}
+		m_LineOffsets.push_back(pos);
+		const size_t lineEnd = m_RawData.find('\n', pos);
+		pos = (lineEnd == BYTE_VECTOR::npos) ? size : lineEnd + 1;
+	}
+	m_LineOffsets.push_back(size);
 
-		size_t lineBegin = pos;
-		size_t lineEnd = data.find('\n', lineBegin);
-		if (lineEnd == BYTE_VECTOR::npos)
-			lineEnd = data.size();
+	m_LineSpans.assign(m_LineOffsets.size() - 1, -1);
+	m_Spans.clear();
+	m_Commits.clear();
+	m_CommitIndex.clear();
+	m_Filenames.clear();
 
-		if (lineEnd > lineBegin)
-		{
-			if (data[lineBegin] != '\t')
-			{
-				if (expectHash)
-				{
-					expectHash = false;
-					if (lineEnd - lineBegin > 2 * GIT_HASH_SIZE)
-					{
-						hash = CGitHash::FromHexStr(std::string_view(&data[lineBegin], 2 * GIT_HASH_SIZE));
-
-						size_t hashEnd = lineBegin + 2 * GIT_HASH_SIZE;
-						size_t originalLineNumberBegin = hashEnd + 1;
-						size_t originalLineNumberEnd = data.find(' ', originalLineNumberBegin);
-						if (originalLineNumberEnd != BYTE_VECTOR::npos)
-						{
-							originalLineNumber = atoi(CStringA(reinterpret_cast<LPCSTR>(&data[originalLineNumberBegin]), SafeSizeToInt(originalLineNumberEnd - originalLineNumberBegin)));
-							size_t finalLineNumberBegin = originalLineNumberEnd + 1;
-							size_t finalLineNumberEnd = (numberOfSubsequentLines == 0) ? data.find(' ', finalLineNumberBegin) : lineEnd;
-							if (finalLineNumberEnd != BYTE_VECTOR::npos)
-							{
-								if (numberOfSubsequentLines == 0)
-								{
-									size_t numberOfSubsequentLinesBegin = finalLineNumberEnd + 1;
-									size_t numberOfSubsequentLinesEnd = lineEnd;
-									numberOfSubsequentLines = atoi(CStringA(reinterpret_cast<LPCSTR>(&data[numberOfSubsequentLinesBegin]), SafeSizeToInt(numberOfSubsequentLinesEnd - numberOfSubsequentLinesBegin)));
-								}
-							}
-							else
-							{
-								// parse error
-								numberOfSubsequentLines = 0;
-							}
-						}
-						else
-						{
-							// parse error
-							numberOfSubsequentLines = 0;
-						}
-
-						auto it = hashToFilename.find(hash);
-						if (it != hashToFilename.end())
-							filename = it->second;
-						else
-							filename.Empty();
-					}
-					else
-					{
-						// parse error
-						numberOfSubsequentLines = 0;
-					}
-				}
-				else
-				{
-					size_t tokenBegin = lineBegin;
-					size_t tokenEnd = data.find(' ', tokenBegin);
-					if (tokenEnd != BYTE_VECTOR::npos)
-					{
-						if (!strncmp("filename", &data[tokenBegin], tokenEnd - tokenBegin))
-						{
-							size_t filenameBegin = tokenEnd + 1;
-							size_t filenameEnd = lineEnd;
-							CStringA filenameA = CStringA(reinterpret_cast<LPCSTR>(&data[filenameBegin]), SafeSizeToInt(filenameEnd - filenameBegin));
-							filename = UnquoteFilename(filenameA);
-							auto r = hashToFilename.emplace(hash, filename);
-							if (!r.second)
-							{
-								r.first->second = filename;
-							}
-						}
-					}
-				}
-			}
-			else
-			{
-				expectHash = true;
-				// remove <TAB> at start
-				BYTE_VECTOR line;
-				if (lineEnd - 1 > lineBegin)
-					line.append(&data[lineBegin + 1], lineEnd-lineBegin - 1);
-
-				while (!line.empty() && line[line.size() - 1] == 13)
-					line.pop_back();
-
-				hashes.push_back(hash);
-				filenames.push_back(filename);
-				originalLineNumbers.push_back(originalLineNumber);
-				rawLines.push_back(line);
-				--numberOfSubsequentLines;
-			}
-		}
-		pos = lineEnd + 1;
-	}
+	// reset detected and applied encoding
+	m_encode = -1;
+	m_Utf8Lines.clear();
+}
 
+bool CTortoiseGitBlameData::AddHunks(const std::vector<BlameHunk>& hunks, CGitHashMap& HashToRev, DWORD dateFormat, bool bRelativeTimes)
+{
+	const size_t oldNumberOfCommits = m_Commits.size();
 	auto mailmap{ GitRevLoglist::s_Mailmap.load() };
-	for (const auto& hash2 : hashes)
+	const auto numberOfLines = static_cast<int>(m_LineSpans.size());
+	for (const auto& hunk : hunks)
 	{
-		CString err;
-		auto pRev = GetRevForHash(HashToRev, hash2, mailmap.get(), &err);
-		if (pRev)
-		{
-			authors.push_back(pRev->GetAuthorName());
-			dates.push_back(CLoglistUtils::FormatDateAndTime(pRev->GetAuthorDate(), dateFormat, true, bRelativeTimes));
-		}
-		else
-		{
-			MessageBox(nullptr, err, L"TortoiseGit", MB_ICONERROR);
-			authors.emplace_back();
-			dates.emplace_back();
-		}
+		const int firstLine = hunk.finalLine - 1;
+		// git might see different content than we do (e.g. if a textconv filter is configured), ignore what does not fit
+		if (firstLine < 0 || firstLine >= numberOfLines || hunk.numberOfLines <= 0)
+			continue;
+		const int lastLine = std::min(firstLine + hunk.numberOfLines, numberOfLines);
+
+		Span span;
+		span.commit = GetCommitIndex(hunk.hash, HashToRev, mailmap.get(), dateFormat, bRelativeTimes);
+		span.filename = GetFilenameIndex(hunk.filename);
+		span.firstLine = firstLine;
+		span.originalLine = hunk.originalLine;
+		const auto spanIndex = static_cast<int>(m_Spans.size());
+		m_Spans.push_back(span);
+		std::fill(m_LineSpans.begin() + firstLine, m_LineSpans.begin() + lastLine, spanIndex);
 	}
+	return m_Commits.size() != oldNumberOfCommits;
+}
 
-	m_Hash.swap(hashes);
-	m_OriginalLineNumbers.swap(originalLineNumbers);
-	m_Filenames.swap(filenames);
-	m_RawLines.swap(rawLines);
+bool CTortoiseGitBlameData::GetHunks(std::vector<BlameHunk>& hunks) const
+{
+	hunks.clear();
+	const auto numberOfLines = static_cast<int>(m_LineSpans.size());
+	for (int line = 0; line < numberOfLines;)
+	{
+		const int spanIndex = m_LineSpans[line];
+		if (spanIndex < 0)
+			return false;
+		int end = line + 1;
+		while (end < numberOfLines && m_LineSpans[end] == spanIndex)
+			++end;
+
+		const auto& span = m_Spans[spanIndex];
+		BlameHunk hunk;
+		hunk.hash = m_Commits[span.commit].hash;
+		hunk.originalLine = span.originalLine + line - span.firstLine;
+		hunk.finalLine = line + 1;
+		hunk.numberOfLines = end - line;
+		hunk.filename = m_Filenames[span.filename];
+		hunks.push_back(hunk);
+		line = end;
+	}
+	return true;
+}
 
-	m_Authors.swap(authors);
-	m_Dates.swap(dates);
-	// reset detected and applied encoding
-	m_encode = -1;
-	m_Utf8Lines.clear();
+int CTortoiseGitBlameData::GetCommitIndex(const CGitHash& hash, CGitHashMap& HashToRev, const CGitMailmap* mailmap, DWORD dateFormat, bool bRelativeTimes)
+{
+	if (auto it = m_CommitIndex.find(hash); it != m_CommitIndex.end())
+		return it->second;
+
+	BlameCommit commit;
+	commit.hash = hash;
+	CString err;
+	auto pRev = GetRevForHash(HashToRev, hash, mailmap, &err);
+	if (pRev)
+	{
+		commit.author = pRev->GetAuthorName();
+		commit.date = CLoglistUtils::FormatDateAndTime(pRev->GetAuthorDate(), dateFormat, true, bRelativeTimes);
+	}
+	else
+		MessageBox(nullptr, err, L"TortoiseGit", MB_ICONERROR);
+
+	const auto index = static_cast<int>(m_Commits.size());
+	m_Commits.push_back(std::move(commit));
+	m_CommitIndex.emplace(hash, index);
+	return index;
+}
+
+int CTortoiseGitBlameData::GetFilenameIndex(const CString& filename)
+{
+	// there are only a few different filenames, usually just one
+	for (auto i = static_cast<int>(m_Filenames.size()); i-- > 0;)
+	{
+		if (m_Filenames[i] == filename)
+			return i;
+	}
+	m_Filenames.push_back(filename);
+	return static_cast<int>(m_Filenames.size()) - 1;
+}
+
+int CTortoiseGitBlameData::GetMaxOriginalLineNumber() const
+{
+	int maxLineNumber = 0;
+	for (size_t i = 0; i < m_Spans.size(); ++i)
+	{
+		// the span ends where the next span of the same lines starts, at the latest at the end of the file
+		const auto& span = m_Spans[i];
+		int lastLine = span.firstLine;
+		while (lastLine + 1 < static_cast<int>(m_LineSpans.size()) && m_LineSpans[lastLine + 1] == static_cast<int>(i))
+			++lastLine;
+		maxLineNumber = std::max(maxLineNumber, span.originalLine + lastLine - span.firstLine);
+	}
+	return maxLineNumber;
 }
 
 int CTortoiseGitBlameData::UpdateEncoding(int encoding)
 {
 	int bomoffset = 0;
 	if (encoding==0)
-	{
-		BYTE_VECTOR all;
-		for (const auto& rawLine : m_RawLines)
-		{
-			if (!rawLine.empty())
-				all.append(rawLine);
-		}
-		encoding = GetEncode(all.data(), SafeSizeToInt(all.size()), &bomoffset);
-	}
+		encoding = GetEncode(m_RawData.data(), SafeSizeToInt(m_RawData.size()), &bomoffset);
 
 	if (encoding != m_encode)
 	{
 		m_encode = encoding;
 
-		m_Utf8Lines.resize(m_RawLines.size());
-		for (size_t i_Lines = 0; i_Lines < m_RawLines.size(); ++i_Lines)
+		const size_t numberOfLines = m_LineSpans.size();
+		m_Utf8Lines.resize(numberOfLines);
+		for (size_t i_Lines = 0; i_Lines < numberOfLines; ++i_Lines)
 		{
-			const BYTE_VECTOR& rawLine = m_RawLines[i_Lines];
+			const char* rawLine = m_RawData.data() + m_LineOffsets[i_Lines];
+			size_t rawLineSize = m_LineOffsets[i_Lines + 1] - m_LineOffsets[i_Lines];
+			if (rawLineSize > 0 && rawLine[rawLineSize - 1] == '\n')
+				--rawLineSize;
+			while (rawLineSize > 0 && rawLine[rawLineSize - 1] == 13)
+				--rawLineSize;
 
 			int linebomoffset = 0;
 			CStringA lineUtf8;
-			if (!rawLine.empty())
+			if (rawLineSize > 0)
 			{
 				if (encoding == 1201)
 				{
 					CString line;
-					int size = SafeSizeToInt((rawLine.size() - linebomoffset) / 2);
+					int size = SafeSizeToInt((rawLineSize - linebomoffset) / 2);
 					wchar_t* buffer = line.GetBuffer(size);
 					memcpy(buffer, &rawLine[linebomoffset], sizeof(wchar_t) * size);
 					// swap the bytes to little-endian order to get proper strings in wchar_t format
@@ -284,16 +254,16 @@ int CTortoiseGitBlameData::UpdateEncoding(int encoding)
 					{
 						linebomoffset = 1;
 					}
-					int size = SafeSizeToInt((rawLine.size() - linebomoffset) / 2);
+					int size = SafeSizeToInt((rawLineSize - linebomoffset) / 2);
 					memcpy(CStrBuf(line, size, 0), &rawLine[linebomoffset], sizeof(wchar_t) * size);
 
 					lineUtf8 = CUnicodeUtils::GetUTF8(line);
 				}
 				else if (encoding == CP_UTF8)
-					lineUtf8 = CStringA(reinterpret_cast<LPCSTR>(&rawLine[linebomoffset]), SafeSizeToInt(rawLine.size() - linebomoffset));
+					lineUtf8 = CStringA(&rawLine[linebomoffset], SafeSizeToInt(rawLineSize - linebomoffset));
 				else
 				{
-					CString line = CUnicodeUtils::GetUnicodeLength(reinterpret_cast<LPCSTR>(&rawLine[linebomoffset]), SafeSizeToInt(rawLine.size() - linebomoffset), encoding);
+					CString line = CUnicodeUtils::GetUnicodeLength(&rawLine[linebomoffset], SafeSizeToInt(rawLineSize - linebomoffset), encoding);
 					lineUtf8 = CUnicodeUtils::GetUTF8(line);
 				}
 			}
@@ -309,9 +279,9 @@ int CTortoiseGitBlameData::FindNextLine(const std::unordered_set<CGitHash>& comm
 {
 	int startline = line;
 	bool findNoMatch = false;
-	while (line >= 0 && line < static_cast<int>(m_Hash.size()))
+	while (line >= 0 && line < static_cast<int>(GetNumberOfLines()))
 	{
-		bool matches = commitHashes.contains(m_Hash[line]);
+		bool matches = commitHashes.contains(GetHash(line));
 		if (!matches)
 			findNoMatch = true;
 
@@ -322,7 +292,7 @@ int CTortoiseGitBlameData::FindNextLine(const std::unordered_set<CGitHash>& comm
 			else
 			{
 				if (bUpOrDown)
-					line = FindFirstLineInBlock(m_Hash[line], line);
+					line = FindFirstLineInBlock(GetHash(line), line);
 				return line;
 			}
 		}
@@ -409,14 +379,14 @@ int CTortoiseGitBlameData::FindFirstLineWrapAround(SearchDirection direction, co
 	{
 		if (bCaseSensitive)
 		{
-			if (m_Authors[i].Find(whatNormalized) >= 0)
+			if (GetAuthor(i).Find(whatNormalized) >= 0)
 				return i;
 			else if (m_Utf8Lines[i].Find(whatNormalizedUtf8) >=0)
 				return i;
 		}
 		else
 		{
-			if (CString(m_Authors[i]).MakeLower().Find(whatNormalized) >= 0)
+			if (CString(GetAuthor(i)).MakeLower().Find(whatNormalized) >= 0)
 				return i;
 			else if (FindUtf8Lower(m_Utf8Lines[i], allAscii, whatNormalized, whatNormalizedUtf8) >= 0)
 				return i;
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2013, 2015-2021, 2023 - TortoiseGit
+// Copyright (C) 2008-2013, 2015-2021, 2023, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -23,10 +23,29 @@
 
 #include "GitHash.h"
 #include "gitlogcache.h"
+#include <unordered_map>
 #include <unordered_set>
 
 class CTortoiseGitBlameData
 {
+public:
+	/// a block of lines as reported by "git blame --incremental", line numbers are 1-based
+	struct BlameHunk
+	{
+		CGitHash	hash;
+		int			originalLine = 0;
+		int			finalLine = 0;
+		int			numberOfLines = 0;
+		CString		filename;
+	};
+
+	struct BlameCommit
+	{
+		CGitHash	hash;
+		CString		author;
+		CString		date;
+	};
+
 // Implementation
 public:
 	CTortoiseGitBlameData();
@@ -34,13 +53,18 @@ public:
 
 public:
 	int GetEncode(const char* buffer, int size, int* bomoffset);
-	void ParseBlameOutput(BYTE_VECTOR &data, CGitHashMap & HashToRev, DWORD dateFormat, bool bRelativeTimes);
+	// sets the blamed file content, all lines are unblamed until AddHunks() is called for them
+	void SetContent(BYTE_VECTOR&& content);
+	// assigns the hunks to their lines, returns true if the hunks introduced new commits
+	bool AddHunks(const std::vector<BlameHunk>& hunks, CGitHashMap& HashToRev, DWORD dateFormat, bool bRelativeTimes);
+	// returns the hunks in line order, false if not all lines are blamed
+	bool GetHunks(std::vector<BlameHunk>& hunks) const;
 	// updates sourcecode lines to the given encoding, encode==0 detects the encoding, returns the used encoding
 	int UpdateEncoding(int encode = 0);
 
-	BOOL IsValidLine(int line)
+	BOOL IsValidLine(int line) const
 	{
-		return line >= 0 && line < static_cast<int>(m_Hash.size());
+		return line >= 0 && line < static_cast<int>(m_LineSpans.size()) && m_LineSpans[line] >= 0;
 	}
 	int FindNextLine(const std::unordered_set<CGitHash>& commitHashes, int line, bool bUpOrDown = false);
 	// find first line with the given hash starting with given "line"
@@ -49,7 +73,7 @@ public:
 		int numberOfLines = static_cast<int>(GetNumberOfLines());
 		for (int i = (line >= 0 ? line : 0); i < numberOfLines; ++i)
 		{
-			if (m_Hash[i] == commithash)
+			if (GetHash(i) == commithash)
 				return i;
 		}
 		return -1;
@@ -59,7 +83,7 @@ public:
 	{
 		while (line >= 0)
 		{
-			if (m_Hash[line] != commithash)
+			if (GetHash(line) != commithash)
 				return line++;
 			--line;
 		}
@@ -70,41 +94,49 @@ public:
 
 	size_t GetNumberOfLines() const
 	{
-		return m_Hash.size();
+		return m_LineSpans.size();
 	}
 
-	CGitHash& GetHash(size_t line)
+	const CGitHash& GetHash(size_t line) const
 	{
-		return m_Hash[line];
+		static const CGitHash emptyHash;
+		const int span = m_LineSpans[line];
+		return span >= 0 ? m_Commits[m_Spans[span].commit].hash : emptyHash;
 	}
 
-	void GetHashes(std::unordered_set<CGitHash>& hashes)
+	void GetHashes(std::unordered_set<CGitHash>& hashes) const
 	{
 		hashes.clear();
-		for (const auto& hash : m_Hash)
+		for (const auto& commit : m_Commits)
 		{
-			hashes.insert(hash);
+			hashes.insert(commit.hash);
 		}
 	}
 
 	const CString& GetDate(size_t line) const
 	{
-		return m_Dates[line];
+		const int span = m_LineSpans[line];
+		return span >= 0 ? m_Commits[m_Spans[span].commit].date : m_sEmpty;
 	}
 
 	const CString& GetAuthor(size_t line) const
 	{
-		return m_Authors[line];
+		const int span = m_LineSpans[line];
+		return span >= 0 ? m_Commits[m_Spans[span].commit].author : m_sEmpty;
 	}
 
 	const CString& GetFilename(size_t line) const
 	{
-		return m_Filenames[line];
+		const int span = m_LineSpans[line];
+		return span >= 0 ? m_Filenames[m_Spans[span].filename] : m_sEmpty;
 	}
 
 	int GetOriginalLineNumber(size_t line) const
 	{
-		return m_OriginalLineNumbers[line];
+		const int span = m_LineSpans[line];
+		if (span < 0)
+			return 0;
+		return m_Spans[span].originalLine + static_cast<int>(line) - m_Spans[span].firstLine;
 	}
 
 	const CStringA& GetUtf8Line(size_t line) const
@@ -112,23 +144,46 @@ public:
 		return m_Utf8Lines[line];
 	}
 
+	// all commits and file names which occur in the blame so far, each only once
+	const std::vector<BlameCommit>& GetCommits() const { return m_Commits; }
+	const std::vector<CString>& GetFilenames() const { return m_Filenames; }
+	int GetMaxOriginalLineNumber() const;
+
 	bool ContainsOnlyFilename(const CString &filename) const;
 
 	GitRevLoglist* GetRev(int line, CGitHashMap& hashToRev)
 	{
+		if (!IsValidLine(line))
+			return nullptr;
 		return GetRevForHash(hashToRev, GetHash(line), GitRevLoglist::s_Mailmap.load().get());
 	}
 
+	static CString UnquoteFilename(const CStringA& s);
+
 private:
 	static GitRevLoglist* GetRevForHash(CGitHashMap& HashToRev, const CGitHash& hash, const CGitMailmap* mailmap, CString* err = nullptr);
-	static CString UnquoteFilename(const CStringA& s);
+	int GetCommitIndex(const CGitHash& hash, CGitHashMap& HashToRev, const CGitMailmap* mailmap, DWORD dateFormat, bool bRelativeTimes);
+	int GetFilenameIndex(const CString& filename);
 
-	std::vector<CGitHash>		m_Hash;
-	std::vector<CString>		m_Dates;
-	std::vector<CString>		m_Authors;
-	std::vector<CString>		m_Filenames;
-	std::vector<int>			m_OriginalLineNumbers;
-	std::vector<BYTE_VECTOR>	m_RawLines;
+	// a run of consecutive lines blamed on the same commit
+	struct Span
+	{
+		int commit;			// index into m_Commits
+		int filename;		// index into m_Filenames
+		int firstLine;		// zero-based
+		int originalLine;	// original line number of firstLine
+	};
+
+	std::vector<BlameCommit>			m_Commits;
+	std::unordered_map<CGitHash, int>	m_CommitIndex;
+	std::vector<CString>				m_Filenames;
+	std::vector<Span>					m_Spans;
+	std::vector<int>					m_LineSpans;	// span per line, -1 for lines which are not blamed (yet)
+	const CString						m_sEmpty;
+
+	// the raw file content, line i starts at m_LineOffsets[i] and ends before m_LineOffsets[i + 1] (including its line ending)
+	BYTE_VECTOR				m_RawData;
+	std::vector<size_t>		m_LineOffsets;
 
 	int m_encode = -1;
 	std::vector<CStringA> m_Utf8Lines;
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2017, 2019-2021, 2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2017, 2019-2021, 2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -40,6 +40,37 @@
 #define new DEBUG_NEW
 #endif
 
+namespace
+{
+// the configuration which changes the diffs git blame computes and therefore which commit a line is attributed to
+CString GetBlameCacheConfig(git_repository* repo, const CString& path)
+{
+	CString config;
+	for (const auto& name : { L"diff.algorithm", L"diff.indentHeuristic" })
+		config.AppendFormat(L"\n%s=%s", name, static_cast<LPCWSTR>(g_Git.GetConfigValue(name)));
+
+	// git blame diffs the output of a textconv filter instead of the content
+	const char* driver = nullptr;
+	if (repo && !git_attr_get(&driver, repo, GIT_ATTR_CHECK_FILE_THEN_INDEX, CUnicodeUtils::GetUTF8(path), "diff") && git_attr_value(driver) == GIT_ATTR_VALUE_STRING)
+	{
+		const CString driverName = CUnicodeUtils::GetUnicode(driver);
+		config.AppendFormat(L"\ndiff=%s\ntextconv=%s", static_cast<LPCWSTR>(driverName), static_cast<LPCWSTR>(g_Git.GetConfigValue(L"diff." + driverName + L".textconv")));
+	}
+	return config;
+}
+
+// git blame reports the lines of the textconv output, filters are checked as well to be on the safe side
+bool HasConvertedContent(git_repository* repo, const CString& path)
+{
+	const CStringA pathA = CUnicodeUtils::GetUTF8(path);
+	const char* value = nullptr;
+	if (!git_attr_get(&value, repo, GIT_ATTR_CHECK_FILE_THEN_INDEX, pathA, "diff") && git_attr_value(value) == GIT_ATTR_VALUE_STRING && !g_Git.GetConfigValue(L"diff." + CUnicodeUtils::GetUnicode(value) + L".textconv").IsEmpty())
+		return true;
+	value = nullptr;
+	return !git_attr_get(&value, repo, GIT_ATTR_CHECK_FILE_THEN_INDEX, pathA, "filter") && git_attr_value(value) == GIT_ATTR_VALUE_STRING;
+}
+}
+
 
 // CTortoiseGitBlameDoc
 
@@ -174,6 +205,10 @@ BOOL CTortoiseGitBlameDoc::OnOpenDocument(LPCWSTR lpszPathName, CString Rev)
 			option += L" -w";
 
 		bool onlyFirstParent = theApp.GetInt(L"OnlyFirstParent", 0) == 1;
+		// must not contain the name of the temp file
+		CString cacheOptions = option;
+		if (onlyFirstParent)
+			cacheOptions += L" --first-parent";
 		if (onlyFirstParent)
 		{
 			CString tmpfile = CTempFiles::Instance().GetTempFilePath(true).GetWinPathString();
@@ -200,15 +235,52 @@ BOOL CTortoiseGitBlameDoc::OnOpenDocument(LPCWSTR lpszPathName, CString Rev)
 			option.AppendFormat(L" -S \"%s\"", static_cast<LPCWSTR>(tmpfile));
 		}
 
-		cmd.Format(L"git.exe blame -p %s %s -- \"%s\"", static_cast<LPCWSTR>(option), static_cast<LPCWSTR>(Rev), static_cast<LPCWSTR>(path.GetGitPathString()));
-		m_BlameData.clear();
-		BYTE_VECTOR err;
-		if(g_Git.Run(cmd, &m_BlameData, &err))
+		// the content is shown right away, the lines get blamed while git reports them
+		BYTE_VECTOR content;
+		CAutoRepository repo(g_Git.GetGitRepository());
+		// the hunks only match the lines git blamed, so the converted content has to be shown and there is nothing to show before git is done
+		const bool bConverted = repo && HasConvertedContent(repo, path.GetGitPathString());
+		if (bConverted)
 		{
-			MessageBox(nullptr, CString(MAKEINTRESOURCE(IDS_BLAMEERROR)) + L"\n\n" + err, L"TortoiseGitBlame", MB_OK | MB_ICONERROR);
-			return FALSE;
+			cmd.Format(L"git.exe cat-file --textconv %s:\"%s\"", static_cast<LPCWSTR>(Rev), static_cast<LPCWSTR>(path.GetGitPathString()));
+			BYTE_VECTOR err;
+			if (g_Git.Run(cmd, &content, &err))
+			{
+				CString str;
+				str.Format(IDS_CHECKOUTFAILED, static_cast<LPCWSTR>(path.GetGitPathString()));
+				str += L'\n';
+				err.push_back(0);
+				CGit::StringAppend(str, err.data());
+				MessageBox(nullptr, CString(MAKEINTRESOURCE(IDS_BLAMEERROR)) + L"\n\n" + str, L"TortoiseGitBlame", MB_OK | MB_ICONERROR);
+				return FALSE;
+			}
+		}
+		else
+		{
+			CAutoObject obj;
+			if (!repo || git_revparse_single(obj.GetPointer(), repo, CUnicodeUtils::GetUTF8(Rev + L':' + path.GetGitPathString())) || git_object_type(obj) != GIT_OBJECT_BLOB)
+			{
+				CString str;
+				str.Format(IDS_CHECKOUTFAILED, static_cast<LPCWSTR>(path.GetGitPathString()));
+				MessageBox(nullptr, CString(MAKEINTRESOURCE(IDS_BLAMEERROR)) + L"\n\n" + CGit::GetLibGit2LastErr(str), L"TortoiseGitBlame", MB_OK | MB_ICONERROR);
+				return FALSE;
+			}
+			const auto blob = reinterpret_cast<git_blob*>(static_cast<git_object*>(obj));
+			content.append(static_cast<const char*>(git_blob_rawcontent(blob)), static_cast<size_t>(git_blob_rawsize(blob)));
 		}
 
+		// the blame only depends on the commit, the path, the options and the diff configuration; ignored revisions are configurable, so don't cache then
+		CGitHash commitHash;
+		if (g_Git.GetConfigValue(L"blame.ignoreRevsFile").IsEmpty())
+		{
+			CAutoObject commit;
+			if (!git_revparse_single(commit.GetPointer(), repo, CUnicodeUtils::GetUTF8(Rev + L"^{commit}")))
+				commitHash = git_object_id(commit);
+		}
+		m_BlameCache.SetKey(commitHash, path.GetGitPathString(), cacheOptions + GetBlameCacheConfig(repo, path.GetGitPathString()));
+
+		cmd.Format(L"git.exe blame --incremental %s %s -- \"%s\"", static_cast<LPCWSTR>(option), static_cast<LPCWSTR>(Rev), static_cast<LPCWSTR>(path.GetGitPathString()));
+
 #ifdef USE_TEMPFILENAME
 		m_TempFileName = CTempFiles::Instance().GetTempFilePath(true).GetWinPathString();
 
@@ -238,23 +310,39 @@ BOOL CTortoiseGitBlameDoc::OnOpenDocument(LPCWSTR lpszPathName, CString Rev)
 			else
 				return FALSE;
 		}
-		pView->ParseBlame();
-
-		BOOL bShowCompleteLog = (theApp.GetInt(L"ShowCompleteLog", 1) == 1);
-		if (bShowCompleteLog && BlameIsLimitedToOneFilename(dwDetectMovedOrCopiedLines) && !onlyFirstParent)
+		std::vector<CTortoiseGitBlameData::BlameHunk> cachedHunks;
+		CGitHash ancestor;
+		m_bBlameFromCache = m_BlameCache.Load(cachedHunks);
+		if (m_bBlameFromCache)
 		{
-			if (GetMainFrame()->m_wndOutput.LoadHistory(path.GetGitPathString(), m_Rev, (theApp.GetInt(L"FollowRenames", 0) == 1)))
+			if (!pView->StartBlame(std::move(content), std::move(cachedHunks)))
 				return FALSE;
 		}
-		else
+		else if (!onlyFirstParent && m_BlameCache.LoadAncestor(repo, ancestor, cachedHunks))
+		{
+			// git only needs to walk the commits after the ancestor
+			auto pAncestor = std::make_unique<CBlameRunner::Ancestor>();
+			pAncestor->hash = ancestor;
+			pAncestor->path = path.GetGitPathString();
+			pAncestor->hunks = std::move(cachedHunks);
+			pAncestor->fullCmd = cmd;
+			CString rangeCmd;
+			rangeCmd.Format(L"git.exe blame --incremental %s %s ^%s -- \"%s\"", static_cast<LPCWSTR>(option), static_cast<LPCWSTR>(Rev), static_cast<LPCWSTR>(ancestor.ToString()), static_cast<LPCWSTR>(path.GetGitPathString()));
+			if (!pView->StartBlame(std::move(content), rangeCmd, std::move(pAncestor), !bConverted))
+				return FALSE;
+		}
+		else if (!pView->StartBlame(std::move(content), cmd, nullptr, !bConverted))
+			return FALSE;
+
+		// the complete log does not depend on the blame, so it can be loaded while git is still working
+		BOOL bShowCompleteLog = (theApp.GetInt(L"ShowCompleteLog", 1) == 1);
+		m_bLoadHistoryOfBlamedCommits = !(bShowCompleteLog && BlameIsLimitedToOneFilename(dwDetectMovedOrCopiedLines) && !onlyFirstParent);
+		if (!m_bLoadHistoryOfBlamedCommits)
 		{
-			std::unordered_set<CGitHash> hashes;
-			pView->m_data.GetHashes(hashes);
-			if (GetMainFrame()->m_wndOutput.LoadHistory(hashes))
+			if (GetMainFrame()->m_wndOutput.LoadHistory(path.GetGitPathString(), m_Rev, (theApp.GetInt(L"FollowRenames", 0) == 1)))
 				return FALSE;
 		}
 
-		pView->MapLineToLogIndex();
 		pView->UpdateInfo();
 		if (m_lLine > 0)
 			pView->GotoLine(m_lLine);
@@ -265,6 +353,23 @@ BOOL CTortoiseGitBlameDoc::OnOpenDocument(LPCWSTR lpszPathName, CString Rev)
 	return TRUE;
 }
 
+void CTortoiseGitBlameDoc::OnBlameFinished(const CTortoiseGitBlameData& data, bool bSucceeded)
+{
+	if (bSucceeded && !m_bBlameFromCache)
+	{
+		std::vector<CTortoiseGitBlameData::BlameHunk> hunks;
+		if (data.GetHunks(hunks))
+			m_BlameCache.Save(hunks);
+	}
+
+	if (!m_bLoadHistoryOfBlamedCommits)
+		return;
+
+	std::unordered_set<CGitHash> hashes;
+	data.GetHashes(hashes);
+	GetMainFrame()->m_wndOutput.LoadHistory(hashes);
+}
+
 void CTortoiseGitBlameDoc::SetPathName(LPCWSTR lpszPathName, BOOL bAddToMRU)
 {
 	CDocument::SetPathName(lpszPathName, bAddToMRU && (m_Rev == L"HEAD"));
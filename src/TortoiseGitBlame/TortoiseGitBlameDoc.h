@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2011, 2013, 2016-2017, 2023 - TortoiseGit
+// Copyright (C) 2008-2011, 2013, 2016-2017, 2023, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -23,6 +23,7 @@
 
 #pragma once
 #include "TGitPath.h"
+#include "BlameCache.h"
 
 class CMainFrame ;
 
@@ -35,13 +36,15 @@ protected: // create from serialization only
 
 // Attributes
 public:
-	BYTE_VECTOR m_BlameData;
 	CString m_CurrentFileName;
 #ifdef USE_TEMPFILENAME
 	CString m_TempFileName;
 #endif
 	CString m_Rev;
 	int		m_lLine = 1;
+	bool	m_bLoadHistoryOfBlamedCommits = false;
+	CBlameCache	m_BlameCache;
+	bool	m_bBlameFromCache = false;
 
 // Operations
 	CTGitPath m_GitPath;
@@ -51,6 +54,8 @@ public:
 	BOOL OnOpenDocument(LPCWSTR lpszPathName) override;
 	BOOL OnOpenDocument(LPCWSTR lpszPathName, CString Rev);
 	void SetPathName(LPCWSTR lpszPathName, BOOL bAddToMRU = TRUE) override;
+	// stores the blame in the cache and loads the history of the blamed commits, if the complete history is not shown
+	void OnBlameFinished(const CTortoiseGitBlameData& data, bool bSucceeded);
 
 // Implementation
 	virtual ~CTortoiseGitBlameDoc();
@@ -1,6 +1,6 @@
 ﻿// TortoiseGitBlame - a Viewer for Git Blames
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2014 - TortoiseSVN
 
 // Copyright (C)2003 Don HO <donho@altern.org>
@@ -116,6 +116,7 @@ BEGIN_MESSAGE_MAP(CTortoiseGitBlameView, CView)
 	ON_NOTIFY(SCN_GETBKCOLOR, IDC_SCINTILLA, OnSciGetBkColor)
 	ON_NOTIFY(SCN_ZOOM, IDC_SCINTILLA, OnSciZoom)
 	ON_REGISTERED_MESSAGE(m_FindDialogMessage, OnFindDialogMessage)
+	ON_MESSAGE(WM_BLAMEPROGRESS, OnBlameProgress)
 END_MESSAGE_MAP()
 
 
@@ -786,10 +787,9 @@ LONG CTortoiseGitBlameView::GetBlameWidth()
 	{
 		SIZE maxwidth = {0};
 
-		const auto numberOfLines = m_data.GetNumberOfLines();
-		for (size_t i = 0; i < numberOfLines; ++i)
+		for (const auto& commit : m_data.GetCommits())
 		{
-			::GetTextExtentPoint32(hDC, m_data.GetDate(i), m_data.GetDate(i).GetLength(), &width);
+			::GetTextExtentPoint32(hDC, commit.date, commit.date.GetLength(), &width);
 			if (width.cx > maxwidth.cx)
 				maxwidth = width;
 		}
@@ -800,10 +800,9 @@ LONG CTortoiseGitBlameView::GetBlameWidth()
 	{
 		SIZE maxwidth = {0};
 
-		const size_t numberOfLines = m_data.GetNumberOfLines();
-		for (size_t i = 0; i < numberOfLines; ++i)
+		for (const auto& commit : m_data.GetCommits())
 		{
-			::GetTextExtentPoint32(hDC,m_data.GetAuthor(i) , m_data.GetAuthor(i).GetLength(), &width);
+			::GetTextExtentPoint32(hDC, commit.author, commit.author.GetLength(), &width);
 			if (width.cx > maxwidth.cx)
 				maxwidth = width;
 		}
@@ -814,10 +813,9 @@ LONG CTortoiseGitBlameView::GetBlameWidth()
 	{
 		SIZE maxwidth = {0};
 
-		const size_t numberOfLines = m_data.GetNumberOfLines();
-		for (size_t i = 0; i < numberOfLines; ++i)
+		for (const auto& filename : m_data.GetFilenames())
 		{
-			::GetTextExtentPoint32(hDC, m_data.GetFilename(i), m_data.GetFilename(i).GetLength(), &width);
+			::GetTextExtentPoint32(hDC, filename, filename.GetLength(), &width);
 			if (width.cx > maxwidth.cx)
 				maxwidth = width;
 		}
@@ -826,17 +824,10 @@ LONG CTortoiseGitBlameView::GetBlameWidth()
 	}
 	if (m_bShowOriginalLineNumber)
 	{
-		SIZE maxwidth = {0};
-
-		const size_t numberOfLines = m_data.GetNumberOfLines();
 		CString str;
-		for (size_t i = 0; i < numberOfLines; ++i)
-		{
-			str.Format(L"%5d", m_data.GetOriginalLineNumber(i));
-			::GetTextExtentPoint32(hDC, str, str.GetLength(), &width);
-			if (width.cx > maxwidth.cx)
-				maxwidth = width;
-		}
+		str.Format(L"%5d", m_data.GetMaxOriginalLineNumber());
+		SIZE maxwidth = {0};
+		::GetTextExtentPoint32(hDC, str, str.GetLength(), &maxwidth);
 		m_originalLineNumberWidth = maxwidth.cx + CDPIAware::Instance().ScaleX(GetSafeHwnd(), BLAMESPACE);
 		blamewidth += m_originalLineNumberWidth;
 	}
@@ -932,7 +923,8 @@ void CTortoiseGitBlameView::DrawBlame(HDC hDC)
 		}
 
 		CString file = m_data.GetFilename(i);
-		if (oldHash != hash || (m_bShowFilename && oldFile != file) || m_bShowOriginalLineNumber)
+		// lines which are not blamed yet stay empty
+		if (!hash.IsEmpty() && (oldHash != hash || (m_bShowFilename && oldFile != file) || m_bShowOriginalLineNumber))
 		{
 			RECT rc;
 			rc.top = static_cast<LONG>(Y);
@@ -989,6 +981,8 @@ void CTortoiseGitBlameView::DrawBlame(HDC hDC)
 			oldHash = hash;
 			oldFile = file;
 		}
+		else if (hash.IsEmpty())
+			oldHash.Empty();
 		if (i == m_SelectedLine && m_pFindDialog)
 		{
 			LOGBRUSH brush;
@@ -1503,35 +1497,84 @@ int CTortoiseGitBlameView::GetEncode(unsigned char *buff, int size, int *bomoffs
 	return GetACP();
 }
 
-void CTortoiseGitBlameView::ParseBlame()
+void CTortoiseGitBlameView::SetContent(BYTE_VECTOR&& content)
+{
+	m_data.SetContent(std::move(content));
+	m_lineToLogIndex.assign(m_data.GetNumberOfLines(), -2);
+	m_bBlameOutputContainsOtherFilenames = FALSE;
+}
+
+bool CTortoiseGitBlameView::StartBlame(BYTE_VECTOR&& content, const CString& cmd, std::unique_ptr<CBlameRunner::Ancestor> pAncestor, bool bStream)
+{
+	SetContent(std::move(content));
+	if (!m_BlameRunner.Start(GetSafeHwnd(), cmd, std::move(pAncestor), bStream))
+	{
+		MessageBox(CString(MAKEINTRESOURCE(IDS_BLAMEERROR)), L"TortoiseGitBlame", MB_OK | MB_ICONERROR);
+		return false;
+	}
+	return true;
+}
+
+bool CTortoiseGitBlameView::StartBlame(BYTE_VECTOR&& content, std::vector<CTortoiseGitBlameData::BlameHunk>&& hunks)
 {
-	m_data.ParseBlameOutput(GetDocument()->m_BlameData, GetLogData()->m_pLogCache->m_HashMap, m_DateFormat, m_bRelativeTimes);
-	CString filename = GetDocument()->m_GitPath.GetGitPathString();
-	m_bBlameOutputContainsOtherFilenames = m_data.ContainsOnlyFilename(filename) ? FALSE : TRUE;
+	SetContent(std::move(content));
+	// processed like the last batch of a running blame, i.e. after the document is set up
+	return m_BlameRunner.StartCached(GetSafeHwnd(), std::move(hunks));
+}
+
+LRESULT CTortoiseGitBlameView::OnBlameProgress(WPARAM, LPARAM)
+{
+	// an earlier notification might already have taken all batches
+	const auto results = m_BlameRunner.TakeResults();
+	if (results.empty())
+		return 0;
+
+	for (const auto& pResult : results)
+	{
+		const bool bNewCommits = m_data.AddHunks(pResult->hunks, GetLogData()->m_pLogCache->m_HashMap, m_DateFormat, m_bRelativeTimes);
+		if (pResult->bDone)
+		{
+			if (pResult->exitCode)
+				MessageBox(CString(MAKEINTRESOURCE(IDS_BLAMEERROR)) + L"\n\n" + pResult->error, L"TortoiseGitBlame", MB_OK | MB_ICONERROR);
+
+			CString filename = GetDocument()->m_GitPath.GetGitPathString();
+			m_bBlameOutputContainsOtherFilenames = m_data.ContainsOnlyFilename(filename) ? FALSE : TRUE;
+			GetDocument()->OnBlameFinished(m_data, pResult->exitCode == 0);
+			MapLineToLogIndex();
+			UpdateBlameWidth();
+		}
+		else if (bNewCommits || m_bShowOriginalLineNumber)
+			UpdateBlameWidth();
+	}
+
+	Invalidate();
+	return 0;
 }
 
 void CTortoiseGitBlameView::MapLineToLogIndex()
 {
-	std::vector<int> lineToLogIndex;
+	const auto& commits = m_data.GetCommits();
+	std::unordered_map<CGitHash, int> hashToCommit;
+	for (size_t i = 0; i < commits.size(); ++i)
+		hashToCommit.emplace(commits[i].hash, static_cast<int>(i));
 
+	// map each commit only once instead of every line
+	std::vector<int> commitToLogIndex(commits.size(), -2);
+	const size_t logSize = this->GetLogData()->size();
+	for (size_t i = 0; i < logSize; ++i)
+	{
+		auto it = hashToCommit.find((*GetLogData())[i]);
+		if (it != hashToCommit.end() && commitToLogIndex[it->second] == -2)
+			commitToLogIndex[it->second] = static_cast<int>(i);
+	}
 
 	const size_t numberOfLines = m_data.GetNumberOfLines();
-	lineToLogIndex.reserve(numberOfLines);
-	const size_t logSize = this->GetLogData()->size();
+	std::vector<int> lineToLogIndex(numberOfLines, -2);
 	for (size_t j = 0; j < numberOfLines; ++j)
 	{
-		CGitHash& hash = m_data.GetHash(j);
-
-		int index = -2;
-		for (size_t i = 0; i < logSize; ++i)
-		{
-			if (hash == (*GetLogData())[i])
-			{
-				index = static_cast<int>(i);
-				break;
-			}
-		}
-		lineToLogIndex.push_back(index);
+		if (!m_data.IsValidLine(static_cast<int>(j)))
+			continue;
+		lineToLogIndex[j] = commitToLogIndex[hashToCommit[m_data.GetHash(j)]];
 	}
 	this->m_lineToLogIndex.swap(lineToLogIndex);
 }
@@ -1640,6 +1683,13 @@ void CTortoiseGitBlameView::UpdateInfo(int Encode)
 	SendEditor(SCI_SETSCROLLWIDTHTRACKING, TRUE);
 	m_TextView.SetReadOnly(true);
 
+	UpdateBlameWidth();
+
+	this->Invalidate();
+}
+
+void CTortoiseGitBlameView::UpdateBlameWidth()
+{
 	GetBlameWidth();
 	CRect rect;
 	this->GetClientRect(rect);
@@ -1647,8 +1697,6 @@ void CTortoiseGitBlameView::UpdateInfo(int Encode)
 	//this->m_TextView.ScreenToClient(rect);
 	rect.left=this->m_blamewidth;
 	this->m_TextView.MoveWindow(rect);
-
-	this->Invalidate();
 }
 
 CString CTortoiseGitBlameView::ResolveCommitFile(int line)
@@ -1726,7 +1774,7 @@ void CTortoiseGitBlameView::OnSciPainted(NMHDR *,LRESULT *)
 void CTortoiseGitBlameView::OnLButtonDown(UINT nFlags,CPoint point)
 {
 	const int line = GetLineUnderCursor(point);
-	if (static_cast<size_t>(line) < m_data.GetNumberOfLines())
+	if (m_data.IsValidLine(line))
 	{
 		SetSelectedLine(line);
 		bool found = m_selectedHashes.contains(m_data.GetHash(line));
@@ -2315,6 +2363,7 @@ void CTortoiseGitBlameView::OnUpdateViewCopyToClipboard(CCmdUI *pCmdUI)
 
 void CTortoiseGitBlameView::OnDestroy()
 {
+	m_BlameRunner.Cancel();
 	CTheme::Instance().SetThemeForDialog(GetSafeHwnd(), false);
 	__super::OnDestroy();
 	CTheme::Instance().RemoveRegisteredCallback(m_themeCallbackId);
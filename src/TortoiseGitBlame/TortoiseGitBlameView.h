@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2013, 2015-2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2013, 2015-2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2014 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -29,6 +29,7 @@
 #include "SciEdit.h"
 #include "GitBlameLogList.h"
 #include "TortoiseGitBlameData.h"
+#include "BlameRunner.h"
 #include "Tooltip.h"
 
 const COLORREF black = RGB(0,0,0);
@@ -124,6 +125,7 @@ protected:
 	afx_msg void OnMouseMove(UINT nFlags, CPoint point);
 	afx_msg void OnMouseLeave();
 	afx_msg LRESULT OnFindDialogMessage(WPARAM wParam, LPARAM lParam);
+	afx_msg LRESULT OnBlameProgress(WPARAM wParam, LPARAM lParam);
 	afx_msg void OnViewNext();
 	afx_msg void OnViewPrev();
 	afx_msg void OnViewToggleLogID();
@@ -171,7 +173,10 @@ protected:
 
 	static UINT m_FindDialogMessage;
 public:
-	void ParseBlame();
+	// shows the content unblamed and starts blaming it in the background
+	bool StartBlame(BYTE_VECTOR&& content, const CString& cmd, std::unique_ptr<CBlameRunner::Ancestor> pAncestor = nullptr, bool bStream = true);
+	// shows the content with an already known blame
+	bool StartBlame(BYTE_VECTOR&& content, std::vector<CTortoiseGitBlameData::BlameHunk>&& hunks);
 	void MapLineToLogIndex();
 	void UpdateInfo(int encode = 0);
 	CString ResolveCommitFile(int line);
@@ -208,6 +213,7 @@ public:
 
 	void InitialiseEditor();
 	LONG GetBlameWidth();
+	void UpdateBlameWidth();
 	void DrawBlame(HDC hDC);
 	void DrawLocatorBar(HDC hDC);
 	void SetTheme(bool bDark);
@@ -226,12 +232,14 @@ public:
 
 	CTortoiseGitBlameData	m_data;
 	std::vector<int>		m_lineToLogIndex;
+	CBlameRunner			m_BlameRunner;
 
 	CLogDataVector *		GetLogData();
 
 	BOOL m_bShowLine = TRUE;
 
 protected:
+	void SetContent(BYTE_VECTOR&& content);
 	void CreateFont();
 	void CreateNewFont(bool resize);
 	void SetupColoring();
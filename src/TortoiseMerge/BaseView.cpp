@@ -1,7 +1,7 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
 // Copyright (C) 2003-2021 - TortoiseSVN
-// Copyright (C) 2011-2012, 2017-2025 TortoiseGit
+// Copyright (C) 2011-2012, 2017-2026 TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -1422,6 +1422,7 @@ void CBaseView::OnDraw(CDC * pDC)
 	CRect rcClient;
 	GetClientRect(rcClient);
 
+	m_Screen2View.EnsureExactLayout(m_nTopLine, m_nTopLine + GetScreenLines());
 	int nLineCount = GetLineCount();
 	int nLineHeight = GetLineHeight();
 
@@ -4076,7 +4077,8 @@ void CBaseView::AddEmptyViewLine(int nViewLineIndex)
 		newLine.sLine = sPartLine;
 	}
 	m_pViewData->InsertData(viewLine+1, newLine);
-	BuildAllScreen2ViewVector();
+	m_Screen2View.ScheduleLineShift(m_pViewData, viewLine + 1, 1);
+	BuildAllScreen2ViewVector(viewLine, viewLine + 1);
 }
 
 void CBaseView::RemoveSelectedText()
@@ -4932,6 +4934,31 @@ int CBaseView::CountMultiLines( int nViewLine )
 	return CountMultiLines(nViewLine);
 }
 
+int CBaseView::EstimateMultiLines(int nViewLine)
+{
+	if (m_ScreenedViewLine.empty())
+		return 0;   // in case the view is completely empty
+
+	ASSERT(nViewLine < static_cast<int>(m_ScreenedViewLine.size()));
+
+	if (m_ScreenedViewLine[nViewLine].bSublinesSet)
+		return static_cast<int>(m_ScreenedViewLine[nViewLine].SubLines.size());
+
+	// wrapping needs the text extents of the line, which is way too slow to do for
+	// all lines of big files. Assume every tab expands fully, the exact count is
+	// computed as soon as the line gets visible.
+	const CString& sLine = m_pViewData->GetLine(nViewLine);
+	int nTabs = 0;
+	for (int i = 0; i < sLine.GetLength(); ++i)
+	{
+		if (sLine[i] == L'\t')
+			++nTabs;
+	}
+	const int nChars = sLine.GetLength() + nTabs * std::max(GetTabSize() - 1, 0);
+	const int nWrapWidth = std::max(GetScreenChars() - 1, 1);
+	return std::max((nChars + nWrapWidth - 1) / nWrapWidth, 1);
+}
+
 /// prepare inline diff cache
 LineColors & CBaseView::GetLineColors(int nViewLine)
 {
@@ -5121,11 +5148,30 @@ void CBaseView::SaveUndoStep()
 {
 	if (!m_AllState.IsEmpty())
 	{
-		CUndo::GetInstance().AddState(m_AllState, GetCaretViewPosition());
+		m_AllState.Commit();
+		int nFirstViewLine = INT_MAX;
+		int nLastViewLine = -1;
+		if ((m_AllState.left.modifies || m_AllState.right.modifies) && m_AllState.GetLineRange(nFirstViewLine, nLastViewLine))
+			m_pMainFrame->ScheduleIncrementalDiff(nFirstViewLine, nLastViewLine);
+		CUndo::GetInstance().AddState(std::move(m_AllState), GetCaretViewPosition());
 	}
 	ResetUndoStep();
 }
 
+void CBaseView::SaveUndoSnapshot()
+{
+	// lines which were recorded before could not be undone after the snapshot was restored
+	if (m_pViewData && m_pState->IsEmpty())
+		m_pState->snapshot = std::make_unique<CViewData>(*m_pViewData);
+}
+
+void CBaseView::SaveUndoStepToLast()
+{
+	if (!m_AllState.IsEmpty())
+		CUndo::GetInstance().AddStateToLastStep(std::move(m_AllState));
+	ResetUndoStep();
+}
+
 void CBaseView::SetTheme(bool bDark)
 {
 	m_bDark = bDark || CTheme::Instance().IsHighContrastModeDark();
@@ -5152,37 +5198,61 @@ void CBaseView::SetTheme(bool bDark)
 
 void CBaseView::InsertViewData(int index, const CString& sLine, DiffState state, int linenumber, EOL ending, HideState hide, int movedline)
 {
-	m_pState->addedlines.push_back(index);
+	if (!m_pState->snapshot)
+		m_pState->addedlines.push_back(index);
 	m_pViewData->InsertData(index, sLine, state, linenumber, ending, hide, movedline);
+	m_Screen2View.ScheduleLineShift(m_pViewData, index, 1);
 }
 
 void CBaseView::InsertViewData( int index, const viewdata& data )
 {
-	m_pState->addedlines.push_back(index);
+	if (!m_pState->snapshot)
+		m_pState->addedlines.push_back(index);
 	m_pViewData->InsertData(index, data);
+	m_Screen2View.ScheduleLineShift(m_pViewData, index, 1);
+}
+
+void CBaseView::ReplaceViewData(int nFirstViewLine, int nLastViewLine, const std::vector<viewdata>& lines)
+{
+	int index = nFirstViewLine;
+	for (const auto& line : lines)
+	{
+		if (index <= nLastViewLine)
+			SetViewData(index, line);
+		else
+			InsertViewData(index, line);
+		++index;
+	}
+	for (int nViewLine = nLastViewLine; nViewLine >= index; --nViewLine)
+		RemoveViewData(nViewLine);
 }
 
 void CBaseView::RemoveViewData( int index )
 {
-	m_pState->removedlines[index] = m_pViewData->GetData(index);
+	if (!m_pState->snapshot)
+		m_pState->removedlines[index] = m_pViewData->GetData(index);
 	m_pViewData->RemoveData(index);
+	m_Screen2View.ScheduleLineShift(m_pViewData, index, -1);
 }
 
 void CBaseView::SetViewData( int index, const viewdata& data )
 {
-	m_pState->replacedlines[index] = m_pViewData->GetData(index);
+	if (!m_pState->snapshot)
+		m_pState->replacedlines[index] = m_pViewData->GetData(index);
 	m_pViewData->SetData(index, data);
 }
 
 void CBaseView::SetViewState(int index, DiffState state)
 {
-	m_pState->linestates[index] = m_pViewData->GetState(index);
+	if (!m_pState->snapshot)
+		m_pState->linestates[index] = m_pViewData->GetState(index);
 	m_pViewData->SetState(index, state);
 }
 
 void CBaseView::SetViewLine( int index, const CString& sLine )
 {
-	m_pState->difflines[index] = m_pViewData->GetLine(index);
+	if (!m_pState->snapshot)
+		m_pState->difflines[index] = m_pViewData->GetLine(index);
 	m_pViewData->SetLine(index, sLine);
 }
 
@@ -5190,20 +5260,23 @@ void CBaseView::SetViewLineNumber( int index, int linenumber )
 {
 	int oldLineNumber = m_pViewData->GetLineNumber(index);
 	if (oldLineNumber != linenumber) {
-		m_pState->linelines[index] = oldLineNumber;
+		if (!m_pState->snapshot)
+			m_pState->linelines[index] = oldLineNumber;
 		m_pViewData->SetLineNumber(index, linenumber);
 	}
 }
 
 void CBaseView::SetViewLineEnding( int index, EOL ending )
 {
-	m_pState->linesEOL[index] = m_pViewData->GetLineEnding(index);
+	if (!m_pState->snapshot)
+		m_pState->linesEOL[index] = m_pViewData->GetLineEnding(index);
 	m_pViewData->SetLineEnding(index, ending);
 }
 
 void CBaseView::SetViewMarked( int index, bool marked )
 {
-	m_pState->markedlines[index] = m_pViewData->GetMarked(index);
+	if (!m_pState->snapshot)
+		m_pState->markedlines[index] = m_pViewData->GetMarked(index);
 	m_pViewData->SetMarked(index, marked);
 }
 
@@ -5222,27 +5295,48 @@ BOOL CBaseView::GetViewSelection( int& start, int& end ) const
 int CBaseView::Screen2View::GetViewLineForScreen( int screenLine )
 {
 	RebuildIfNecessary();
-	if ((size() <= screenLine) || (screenLine < 0))
+	const int nViewLine = m_Index.FindIndex(screenLine);
+	if (nViewLine < 0)
 		return 0;
-	return m_Screen2View[screenLine].nViewLine;
+	return nViewLine;
 }
 
 int CBaseView::Screen2View::size()
 {
 	RebuildIfNecessary();
-	return static_cast<int>(m_Screen2View.size());
+	return m_Index.GetTotal();
 }
 
 int CBaseView::Screen2View::GetSubLineOffset( int screenLine )
 {
 	RebuildIfNecessary();
-	if (size() <= screenLine)
+	const int nViewLine = m_Index.FindIndex(screenLine);
+	if (nViewLine < 0)
 		return 0;
-	return m_Screen2View[screenLine].nViewSubLine;
+	if (!m_pMainFrame->m_bWrapLines || IsViewLineHidden(m_pLayoutViewData, nViewLine))
+		return -1; // no wrap
+	return screenLine - m_Index.GetStart(nViewLine);
+}
+
+int CBaseView::Screen2View::GetScreenLineCount(int nViewLine, bool bExact) const
+{
+	if (m_pMainFrame->m_bCollapsed && m_pLayoutViewData->GetHideState(nViewLine) == HideState::Hidden)
+		return 0;
+	if (!m_pMainFrame->m_bWrapLines || IsViewLineHidden(m_pLayoutViewData, nViewLine))
+		return 1;
+	int nMaxLines = 0;
+	if (IsLeftViewGood())
+		nMaxLines = std::max<int>(nMaxLines, bExact ? m_pwndLeft->CountMultiLines(nViewLine) : m_pwndLeft->EstimateMultiLines(nViewLine));
+	if (IsRightViewGood())
+		nMaxLines = std::max<int>(nMaxLines, bExact ? m_pwndRight->CountMultiLines(nViewLine) : m_pwndRight->EstimateMultiLines(nViewLine));
+	if (IsBottomViewGood())
+		nMaxLines = std::max<int>(nMaxLines, bExact ? m_pwndBottom->CountMultiLines(nViewLine) : m_pwndBottom->EstimateMultiLines(nViewLine));
+	return std::max<int>(nMaxLines, 1);
 }
 
 /**
-	doing partial rebuild, whole screen2view vector is built, but uses ScreenedViewLine cache to do it faster
+	doing partial rebuild, only the screen line counts of the scheduled ranges and of inserted view lines are updated
+	if the changes of the number of view lines are known
 */
 void CBaseView::Screen2View::RebuildIfNecessary()
 {
@@ -5267,42 +5361,37 @@ void CBaseView::Screen2View::RebuildIfNecessary()
 		ResetScreenedViewLineCache(m_pwndRight);
 		ResetScreenedViewLineCache(m_pwndBottom);
 	}
-	m_RebuildRanges.clear();
-	m_bFull = false;
 
-	size_t OldSize = m_Screen2View.size();
-	m_Screen2View.clear();
-	m_Screen2View.reserve(OldSize); // guess same size
-	for (int i = 0; i < m_pViewData->GetCount(); ++i)
+	const int nViewCount = m_pViewData->GetCount();
+	if (!m_bFull && m_Index.GetCount() != nViewCount)
 	{
-		if (m_pMainFrame->m_bCollapsed)
+		// the cached screen data of the following lines belongs to other view lines now
+		ResetScreenedViewLineCache(m_pwndLeft);
+		ResetScreenedViewLineCache(m_pwndRight);
+		ResetScreenedViewLineCache(m_pwndBottom);
+		if (m_pLayoutViewData == m_pViewData)
+			ApplyLineShifts(nViewCount);
+	}
+	m_LineShifts.clear();
+	m_bLineShiftsOverflow = false;
+	if (m_bFull || m_pLayoutViewData != m_pViewData || m_Index.GetCount() != nViewCount)
+	{
+		m_pLayoutViewData = m_pViewData;
+		std::vector<int> counts(nViewCount);
+		for (int i = 0; i < nViewCount; ++i)
+			counts[i] = GetScreenLineCount(i, false);
+		m_Index.Assign(std::move(counts));
+	}
+	else
+	{
+		for (const auto& range : m_RebuildRanges)
 		{
-			while ((i < m_pViewData->GetCount())&&(m_pViewData->GetHideState(i) == HideState::Hidden))
-				++i;
-			if (!(i < m_pViewData->GetCount()))
-				break;
-		}
-		TScreenLineInfo oLineInfo;
-		oLineInfo.nViewLine = i;
-		oLineInfo.nViewSubLine = -1; // no wrap
-		if (m_pMainFrame->m_bWrapLines && !IsViewLineHidden(m_pViewData, i))
-		{
-			int nMaxLines = 0;
-			if (IsLeftViewGood())
-				nMaxLines = std::max<int>(nMaxLines, m_pwndLeft->CountMultiLines(i));
-			if (IsRightViewGood())
-				nMaxLines = std::max<int>(nMaxLines, m_pwndRight->CountMultiLines(i));
-			if (IsBottomViewGood())
-				nMaxLines = std::max<int>(nMaxLines, m_pwndBottom->CountMultiLines(i));
-			for (int l = 0; l < (nMaxLines-1); ++l)
-			{
-				oLineInfo.nViewSubLine++;
-				m_Screen2View.push_back(oLineInfo);
-			}
-			oLineInfo.nViewSubLine++;
+			for (int i = std::max(range.FirstViewLine, 0); i <= std::min(range.LastViewLine, nViewCount - 1); ++i)
+				m_Index.SetLineCount(i, GetScreenLineCount(i, false));
 		}
-		m_Screen2View.push_back(oLineInfo);
 	}
+	m_RebuildRanges.clear();
+	m_bFull = false;
 	m_pViewData = nullptr;
 
 	if (IsLeftViewGood())
@@ -5316,48 +5405,51 @@ void CBaseView::Screen2View::RebuildIfNecessary()
 	RecalcAllHorzScrollBars();
 }
 
-int CBaseView::Screen2View::FindScreenLineForViewLine( int viewLine )
+void CBaseView::Screen2View::ApplyLineShifts(int nViewCount)
 {
-	RebuildIfNecessary();
-
-	int nScreenLineCount = static_cast<int>(m_Screen2View.size());
-
-	int nPos = 0;
-	if (nScreenLineCount>16)
+	if (m_bLineShiftsOverflow || m_LineShifts.empty())
+		return;
+	// lines might have been inserted or removed without being recorded, the caller rebuilds the index then
+	CScreenLineIndex index = m_Index;
+	if (!index.Shift(m_LineShifts, -1) || index.GetCount() != nViewCount)
+		return;
+	for (int i = 0; i < nViewCount; ++i)
 	{
-		// for enough long data search for last screen
-		// with viewline less than one we are looking for
-		// use approximate method (based on) binary search using asymmetric start point
-		// in form 2**n (determined as MSB of length) to go around division and rounding;
-		// this effectively looks for bit values from MSB to LSB
+		if (index.GetLineCount(i) < 0)
+			index.SetLineCount(i, GetScreenLineCount(i, false));
+	}
+	m_Index = std::move(index);
+}
 
-		int nTestBit;
-		//GetMostSignificantBitValue
-		// note _BitScanReverse(&nTestBit, nScreenLineCount); can be used instead
-		nTestBit = nScreenLineCount;
-		nTestBit |= nTestBit>>1;
-		nTestBit |= nTestBit>>2;
-		nTestBit |= nTestBit>>4;
-		nTestBit |= nTestBit>>8;
-		nTestBit |= nTestBit>>16;
-		nTestBit ^= (nTestBit>>1);
+bool CBaseView::Screen2View::EnsureExactLayout(int nFirstScreenLine, int nLastScreenLine)
+{
+	RebuildIfNecessary();
+	if (!m_pMainFrame->m_bWrapLines || !m_pLayoutViewData || m_Index.GetTotal() == 0)
+		return false;
 
-		while (nTestBit)
+	bool bChanged = false;
+	int nViewLine = m_Index.FindIndex(std::max(nFirstScreenLine, 0));
+	if (nViewLine < 0)
+		nViewLine = m_Index.GetCount() - 1;
+	// the screen lines of the following view lines move while the counts get exact, so check the range on every line
+	for (; nViewLine < m_Index.GetCount() && m_Index.GetStart(nViewLine) <= nLastScreenLine; ++nViewLine)
+	{
+		const int nCount = GetScreenLineCount(nViewLine, true);
+		if (nCount != m_Index.GetLineCount(nViewLine))
 		{
-			int nTestPos = nPos | nTestBit;
-			if (nTestPos < nScreenLineCount && m_Screen2View[nTestPos].nViewLine < viewLine)
-			{
-				nPos = nTestPos;
-			}
-			nTestBit >>= 1;
+			m_Index.SetLineCount(nViewLine, nCount);
+			bChanged = true;
 		}
 	}
-	while (nPos < nScreenLineCount && m_Screen2View[nPos].nViewLine < viewLine)
-	{
-		nPos++;
-	}
+	if (bChanged)
+		RecalcAllVertScrollBars();
+	return bChanged;
+}
 
-	return nPos;
+int CBaseView::Screen2View::FindScreenLineForViewLine( int viewLine )
+{
+	RebuildIfNecessary();
+	return m_Index.GetStart(std::clamp(viewLine, 0, m_Index.GetCount()));
 }
 
 void CBaseView::Screen2View::ScheduleFullRebuild(CViewData * pViewData) {
@@ -5366,6 +5458,38 @@ void CBaseView::Screen2View::ScheduleFullRebuild(CViewData * pViewData) {
 	m_pViewData = pViewData;
 }
 
+void CBaseView::Screen2View::ScheduleLineShift(const CViewData * pViewData, int nViewLine, int nCount)
+{
+	// the index only follows the view data it was built for, the other views are aligned to it
+	if (pViewData != m_pLayoutViewData || m_bLineShiftsOverflow)
+		return;
+
+	// lines are usually inserted one after the other and removed at the same or the preceding position
+	if (!m_LineShifts.empty())
+	{
+		auto& last = m_LineShifts.back();
+		if (nCount > 0 && last.count > 0 && nViewLine >= last.index && nViewLine <= last.index + last.count)
+		{
+			last.count += nCount;
+			return;
+		}
+		if (nCount < 0 && last.count < 0 && (nViewLine == last.index || nViewLine - nCount == last.index))
+		{
+			last.index = nViewLine;
+			last.count += nCount;
+			return;
+		}
+	}
+	// every shift moves the whole index, rebuild it from scratch instead
+	if (m_LineShifts.size() >= 64)
+	{
+		m_bLineShiftsOverflow = true;
+		m_LineShifts.clear();
+		return;
+	}
+	m_LineShifts.push_back({ nViewLine, nCount });
+}
+
 void CBaseView::Screen2View::ScheduleRangeRebuild(CViewData * pViewData, int nFirstViewLine, int nLastViewLine)
 {
 	if (m_bFull)
@@ -6108,6 +6232,8 @@ void CBaseView::UseViewBlock(CBaseView * pwndView, int nFirstViewLine, int nLast
 	if (!IsWritable())
 		return;
 	CUndo::GetInstance().BeginGrouping();
+	if (nFirstViewLine == 0 && nLastViewLine == GetViewCount() - 1)
+		SaveUndoSnapshot();
 
 	for (int viewLine = nFirstViewLine; viewLine <= nLastViewLine; viewLine++)
 	{
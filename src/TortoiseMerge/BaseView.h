@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2020, 2022-2025 - TortoiseGit
+// Copyright (C) 2020, 2022-2026 - TortoiseGit
 // Copyright (C) 2003-2015, 2017-2020 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -29,6 +29,7 @@
 #include "TripleClick.h"
 #include "IconMenu.h"
 #include "FindDlg.h"
+#include "ScreenLineIndex.h"
 
 struct inlineDiffPos
 {
@@ -125,6 +126,7 @@ public: // methods
 	int				FindScreenLineForViewLine(int viewLine);
 	// TODO: find better consistent names for Multiline(line with sublines) and Subline, Count.. or Get..Count ?
 	int				CountMultiLines(int nViewLine);
+	int				EstimateMultiLines(int nViewLine);	///< like CountMultiLines, but does not wrap lines which were not wrapped yet
 	int				GetSubLineOffset(int index);
 	LineColors &	GetLineColors(int nViewLine);
 	static void		UpdateLocator() { if (m_pwndLocator) m_pwndLocator->DocumentUpdated(); }
@@ -198,8 +200,16 @@ public: // methods
 	void			InsertViewData(int index, const CString& sLine, DiffState state, int linenumber, EOL ending, HideState hide, int movedline);
 	void			InsertViewData(int index, const viewdata& data);
 	void			RemoveViewData(int index);
+	/// replaces the view lines [nFirstViewLine, nLastViewLine] by \a lines, which may have a different count
+	void			ReplaceViewData(int nFirstViewLine, int nLastViewLine, const std::vector<viewdata>& lines);
+	void			SaveUndoStep();
+	/// records the pending changes as part of the last undo step instead of a new one
+	void			SaveUndoStepToLast();
+	/// the next undo step of this view stores the current view data as a whole instead of every changed line, for replacing the whole view
+	void			SaveUndoSnapshot();
+	static bool		HasPendingUndoStep() { return !m_AllState.IsEmpty(); }
 
-	const viewdata&	GetViewData(int index) const {return m_pViewData->GetData(index); }
+	viewdata		GetViewData(int index) const {return m_pViewData->GetData(index); }
 	const CString&	GetViewLine(int index) const {return m_pViewData->GetLine(index); }
 	DiffState		GetViewState(int index) const {return m_pViewData->GetState(index); }
 	HideState		GetViewHideState(int index) {return m_pViewData->GetHideState(index); }
@@ -469,7 +479,6 @@ protected:  // methods
 	int				GetButtonEventLineIndex(const POINT& point);
 
 	static void		ResetUndoStep();
-	void			SaveUndoStep();
 
 	void			SetTheme(bool bDark);
 protected:  // variables
@@ -577,11 +586,6 @@ protected:  // variables
 	static CBaseView * m_pwndRight;		///< Pointer to the right view. Must be set by the CRightView parent class.
 	static CBaseView * m_pwndBottom;	///< Pointer to the bottom view. Must be set by the CBottomView parent class.
 
-	struct TScreenLineInfo
-	{
-		int nViewLine;
-		int nViewSubLine;
-	};
 	class TScreenedViewLine
 	{
 	 public:
@@ -657,6 +661,13 @@ protected:  // variables
 		POPUPCOMMAND__LAST,
 	};
 
+	/**
+	 * Maps screen lines to view lines (and sub lines if lines are wrapped).
+	 * The number of screen lines of every view line is kept in a prefix sum
+	 * index. When wrapping, lines whose wrapping was not computed yet get
+	 * an estimated count based on their length, the exact count is computed
+	 * lazily for the lines which get painted (see EnsureExactLayout).
+	 */
 	class Screen2View
 	{
 	public:
@@ -669,7 +680,11 @@ protected:  // variables
 		int				FindScreenLineForViewLine(int viewLine);
 		void			ScheduleFullRebuild(CViewData * ViewData);
 		void			ScheduleRangeRebuild(CViewData * ViewData, int FirstViewLine, int LastViewLine);
+		/// records that view lines were inserted (Count > 0) or removed (Count < 0), so that the index can be shifted instead of rebuilt
+		void			ScheduleLineShift(const CViewData * ViewData, int ViewLine, int Count);
 		int				size();
+		/// computes the exact wrapping of the view lines shown on the given screen lines, returns true if the layout changed
+		bool			EnsureExactLayout(int FirstScreenLine, int LastScreenLine);
 
 	private:
 		struct TRebuildRange
@@ -682,11 +697,16 @@ protected:  // variables
 		void			RebuildIfNecessary();
 		bool			ResetScreenedViewLineCache(CBaseView* View) const;
 		bool			ResetScreenedViewLineCache(CBaseView* View, const TRebuildRange& Range) const;
+		int				GetScreenLineCount(int ViewLine, bool bExact) const;
+		void			ApplyLineShifts(int ViewCount);
 
 		CViewData *						m_pViewData;
+		CViewData *						m_pLayoutViewData = nullptr;	///< the view data the index was built for
 		bool							m_bFull;
-		std::vector<TScreenLineInfo>	m_Screen2View;
+		CScreenLineIndex				m_Index;
 		std::vector<TRebuildRange>		m_RebuildRanges;
+		std::vector<CScreenLineIndex::LineShift>	m_LineShifts;
+		bool							m_bLineShiftsOverflow = false;	///< too many shifts to apply them one by one
 	};
 
 	static Screen2View m_Screen2View;
@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2019, 2023, 2025 - TortoiseGit
+// Copyright (C) 2019, 2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2006-2013 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -56,6 +56,8 @@ void CBottomView::UseBlock(CBaseView * pwndView, int nFirstViewLine, int nLastVi
 	if (!IsViewGood(pwndView))
 		return;
 	CUndo::GetInstance().BeginGrouping(); // start group undo
+	if (nFirstViewLine == 0 && nLastViewLine == GetViewCount() - 1)
+		SaveUndoSnapshot();
 
 	for (int viewLine = nFirstViewLine; viewLine <= nLastViewLine; viewLine++)
 	{
@@ -359,6 +359,20 @@ BOOL CDiffData::Load()
 	return TRUE;
 }
 
+bool CDiffData::CanDiffIncrementally(bool& bIgnoreEOL) const
+{
+	if (m_bBlame || m_bViewMovedBlocks || !m_rx._Empty())
+		return false;
+	if (static_cast<IgnoreWS>(static_cast<DWORD>(CRegDWORD(L"Software\\TortoiseGitMerge\\IgnoreWS"))) != IgnoreWS::None)
+		return false;
+	if (static_cast<DWORD>(CRegDWORD(L"Software\\TortoiseGitMerge\\CaseInsensitive", FALSE)) != 0)
+		return false;
+	if (static_cast<DWORD>(CRegDWORD(L"Software\\TortoiseGitMerge\\IgnoreComments", FALSE)) != 0)
+		return false;
+	bIgnoreEOL = static_cast<DWORD>(CRegDWORD(L"Software\\TortoiseGitMerge\\IgnoreEOL", TRUE)) != 0;
+	return true;
+}
+
 bool CDiffData::DoTwoWayDiff(const CString& sBaseFilename, const CString& sYourFilename, IgnoreWS ignoreWs, bool bIgnoreEOL, bool bIgnoreCase, bool bIgnoreComments, apr_pool_t* pool)
 {
 	svn_diff_file_options_t* options = CreateDiffFileOptions(ignoreWs, bIgnoreEOL, pool);
@@ -57,6 +57,9 @@ public:
 	void						SetCommentTokens(const CString& sLineStart, const CString& sBlockStart, const CString& sBlockEnd);
 	void						SetRegexTokens(const std::wregex& rx, const std::wstring& replacement);
 
+	/// returns true if the current diff options allow re-diffing parts of the two-pane view by comparing the line texts
+	bool						CanDiffIncrementally(bool& bIgnoreEOL) const;
+
 	bool	IsBaseFileInUse() const		{ return m_baseFile.InUse(); }
 	bool	IsTheirFileInUse() const	{ return m_theirFile.InUse(); }
 	bool	IsYourFileInUse() const		{ return m_yourFile.InUse(); }
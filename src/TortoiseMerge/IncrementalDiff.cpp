@@ -0,0 +1,197 @@
+// TortoiseGitMerge - a Diff/Patch program
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "IncrementalDiff.h"
+#include "svn_diff.h"
+#include "diff.h"
+
+struct CIncrementalDiff::DiffThreadData
+{
+	HWND							hNotifyWnd = nullptr;
+	std::unique_ptr<Result>			pResult;
+	std::shared_ptr<ResultQueue>	pResults;
+	bool							bIgnoreEOL = true;
+};
+
+namespace
+{
+struct WindowDiffBaton
+{
+	const std::vector<viewdata>*	lines[2];
+	size_t							pos[2] = { 0, 0 };
+	bool							bIgnoreEOL = true;
+};
+
+int DatasourceIndex(svn_diff_datasource_e datasource)
+{
+	return datasource == svn_diff_datasource_original ? 0 : 1;
+}
+
+svn_error_t* datasources_open(void* /*baton*/, apr_off_t* prefix_lines, apr_off_t* /*suffix_lines*/, const svn_diff_datasource_e* /*datasources*/, apr_size_t /*datasource_len*/)
+{
+	// Don't claim any prefix matches, the window is small compared to the whole file
+	*prefix_lines = 0;
+	return SVN_NO_ERROR;
+}
+
+svn_error_t* datasource_close(void* /*baton*/, svn_diff_datasource_e /*datasource*/)
+{
+	return SVN_NO_ERROR;
+}
+
+svn_error_t* next_token(apr_uint32_t* hash, void** token, void* baton, svn_diff_datasource_e datasource)
+{
+	auto diffBaton = static_cast<WindowDiffBaton*>(baton);
+	const int index = DatasourceIndex(datasource);
+	*token = nullptr;
+	if (diffBaton->pos[index] < diffBaton->lines[index]->size())
+	{
+		const viewdata& line = (*diffBaton->lines[index])[diffBaton->pos[index]++];
+		*token = const_cast<viewdata*>(&line);
+		*hash = static_cast<apr_uint32_t>(std::hash<std::wstring_view>{}(std::wstring_view(line.sLine, line.sLine.GetLength())));
+	}
+	return SVN_NO_ERROR;
+}
+
+svn_error_t* compare_token(void* baton, void* token1, void* token2, int* compare)
+{
+	auto diffBaton = static_cast<WindowDiffBaton*>(baton);
+	auto line1 = static_cast<const viewdata*>(token1);
+	auto line2 = static_cast<const viewdata*>(token2);
+	*compare = line1->sLine.Compare(line2->sLine);
+	if (*compare == 0 && !diffBaton->bIgnoreEOL && line1->ending != line2->ending)
+		*compare = line1->ending < line2->ending ? -1 : 1;
+	return SVN_NO_ERROR;
+}
+
+void discard_token(void* /*baton*/, void* /*token*/)
+{
+}
+
+void discard_all_token(void* /*baton*/)
+{
+}
+
+const svn_diff_fns2_t WindowDiff_vtable =
+{
+	datasources_open,
+	datasource_close,
+	next_token,
+	compare_token,
+	discard_token,
+	discard_all_token
+};
+}
+
+bool CIncrementalDiff::Start(HWND hNotifyWnd, const CViewData& left, const CViewData& right, int first, int last, bool bIgnoreEOL)
+{
+	if (left.GetCount() != right.GetCount() || left.GetCount() == 0)
+		return false;
+
+	GetAnchoredWindow(left, right, first, last);
+
+	auto pResult = std::make_unique<Result>();
+	pResult->generation = ++m_generation;
+	pResult->firstViewLine = first;
+	pResult->lastViewLine = last;
+	pResult->oldLeft.reserve(last - first + 1);
+	pResult->oldRight.reserve(last - first + 1);
+	for (int row = first; row <= last; ++row)
+	{
+		pResult->oldLeft.push_back(left.GetData(row));
+		pResult->oldRight.push_back(right.GetData(row));
+	}
+
+	auto pData = new DiffThreadData;
+	pData->hNotifyWnd = hNotifyWnd;
+	pData->pResult = std::move(pResult);
+	pData->pResults = m_pResults;
+	pData->bIgnoreEOL = bIgnoreEOL;
+	if (!AfxBeginThread(DiffThreadEntry, pData, THREAD_PRIORITY_BELOW_NORMAL))
+	{
+		delete pData;
+		return false;
+	}
+	return true;
+}
+
+UINT CIncrementalDiff::DiffThreadEntry(LPVOID pVoid)
+{
+	std::unique_ptr<DiffThreadData> pData(static_cast<DiffThreadData*>(pVoid));
+	if (!DiffWindow(*pData->pResult, pData->bIgnoreEOL))
+		return 1;
+	{
+		CComCritSecLock<CComCriticalSection> lock(pData->pResults->critSec);
+		pData->pResults->results.push_back(std::move(pData->pResult));
+	}
+	// the result stays in the queue if the window is gone, it is freed with the queue then
+	if (!::PostMessage(pData->hNotifyWnd, WM_INCREMENTALDIFFDONE, 0, 0))
+		return 1;
+	return 0;
+}
+
+std::unique_ptr<CIncrementalDiff::Result> CIncrementalDiff::TakeResult()
+{
+	CComCritSecLock<CComCriticalSection> lock(m_pResults->critSec);
+	std::unique_ptr<Result> pResult;
+	for (auto& result : m_pResults->results)
+	{
+		if (IsCurrent(*result))
+			pResult = std::move(result);
+	}
+	m_pResults->results.clear();
+	return pResult;
+}
+
+bool CIncrementalDiff::DiffWindow(Result& result, bool bIgnoreEOL)
+{
+	// only real lines take part in the diff, the empty rows are just padding
+	const std::vector<viewdata> leftLines = GetRealLines(result.oldLeft);
+	const std::vector<viewdata> rightLines = GetRealLines(result.oldRight);
+
+	apr_pool_t* pool = svn_pool_create(nullptr);
+	if (!pool)
+		return false;
+	SCOPE_EXIT { svn_pool_destroy(pool); };
+
+	WindowDiffBaton baton;
+	baton.lines[0] = &leftLines;
+	baton.lines[1] = &rightLines;
+	baton.bIgnoreEOL = bIgnoreEOL;
+	svn_diff_t* diff = nullptr;
+	if (svn_error_t* err = svn_diff_diff_2(&diff, &baton, &WindowDiff_vtable, pool))
+	{
+		svn_error_clear(err);
+		return false;
+	}
+
+	std::vector<DiffBlock> blocks;
+	for (svn_diff_t* tempdiff = diff; tempdiff; tempdiff = tempdiff->next)
+	{
+		if (tempdiff->type != svn_diff__type_common && tempdiff->type != svn_diff__type_diff_modified)
+			continue;
+		DiffBlock block;
+		block.bCommon = tempdiff->type == svn_diff__type_common;
+		block.leftLines = static_cast<size_t>(tempdiff->original_length);
+		block.rightLines = static_cast<size_t>(tempdiff->modified_length);
+		blocks.push_back(block);
+	}
+	LayoutWindow(result, blocks);
+	return true;
+}
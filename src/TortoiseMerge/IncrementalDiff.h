@@ -0,0 +1,101 @@
+// TortoiseGitMerge - a Diff/Patch program
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include "ViewData.h"
+#include <atomic>
+#include <memory>
+
+/// posted to the notification window when a re-diff finished, the receiver gets the result with CIncrementalDiff::TakeResult()
+#define WM_INCREMENTALDIFFDONE (WM_APP + 1)
+
+/**
+ * \ingroup TortoiseMerge
+ * Re-diffs a window of rows of the two-pane view on a background thread.
+ *
+ * The window around the edited rows is widened until it is bordered by
+ * unchanged rows in both views (or the start/end of the views), so that
+ * its rows can be replaced without changing the alignment of the rest of
+ * the views. Every started re-diff gets a generation number; results which
+ * do not belong to the latest generation are dropped by TakeResult().
+ * The results are kept in a queue which is shared with the worker threads,
+ * so a result is freed even if the receiver is gone before it arrives.
+ */
+class CIncrementalDiff
+{
+public:
+	struct Result
+	{
+		LONG					generation = 0;
+		int						firstViewLine = 0;	///< first row of the re-diffed window
+		int						lastViewLine = -1;	///< last row (inclusive) of the re-diffed window
+		std::vector<viewdata>	oldLeft;			///< the rows of the window at the time the re-diff was started
+		std::vector<viewdata>	oldRight;
+		std::vector<viewdata>	left;				///< the new rows for the left view
+		std::vector<viewdata>	right;				///< the new rows for the right view
+
+		/// checks whether the window still contains the rows the re-diff was started with
+		bool					MatchesViews(const CViewData& leftData, const CViewData& rightData) const;
+	};
+
+	/// a run of lines in the diff of the real lines of a window
+	struct DiffBlock
+	{
+		bool	bCommon = true;
+		size_t	leftLines = 0;
+		size_t	rightLines = 0;
+	};
+
+	CIncrementalDiff() = default;
+	~CIncrementalDiff() = default;
+
+	/// widens [first, last] until it is bordered by unchanged rows in both views
+	static void		GetAnchoredWindow(const CViewData& left, const CViewData& right, int& first, int& last);
+
+	/**
+	 * Starts re-diffing the window [first, last] of the two views on a worker thread.
+	 * WM_INCREMENTALDIFFDONE is posted to \a hNotifyWnd when done.
+	 * \return false if the thread could not be started
+	 */
+	bool			Start(HWND hNotifyWnd, const CViewData& left, const CViewData& right, int first, int last, bool bIgnoreEOL);
+	/// drops the results of all re-diffs started so far
+	void			Invalidate() { ++m_generation; }
+	bool			IsCurrent(const Result& result) const { return result.generation == m_generation; }
+	/// returns the result of the latest re-diff if it arrived, drops all outdated results
+	std::unique_ptr<Result>	TakeResult();
+
+	/// diffs the rows in \a result.oldLeft and \a result.oldRight and fills \a result.left and \a result.right
+	static bool		DiffWindow(Result& result, bool bIgnoreEOL);
+	/// the real lines of \a rows, without the empty rows used for padding
+	static std::vector<viewdata>	GetRealLines(const std::vector<viewdata>& rows);
+	/// fills \a result.left and \a result.right from the \a blocks of the diff of the real lines of \a result.oldLeft and \a result.oldRight
+	static void		LayoutWindow(Result& result, const std::vector<DiffBlock>& blocks);
+
+private:
+	struct DiffThreadData;
+	struct ResultQueue
+	{
+		CComAutoCriticalSection					critSec;
+		std::vector<std::unique_ptr<Result>>	results;
+	};
+
+	static UINT		DiffThreadEntry(LPVOID pVoid);
+
+	std::atomic<LONG>				m_generation = 0;
+	std::shared_ptr<ResultQueue>	m_pResults = std::make_shared<ResultQueue>();
+};
@@ -0,0 +1,142 @@
+// TortoiseGitMerge - a Diff/Patch program
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "IncrementalDiff.h"
+
+namespace
+{
+bool IsAnchorRow(const CViewData& left, const CViewData& right, int row)
+{
+	return left.GetState(row) == DiffState::Normal && right.GetState(row) == DiffState::Normal;
+}
+
+bool IsRealLine(const viewdata& row)
+{
+	switch (row.state)
+	{
+	case DiffState::ConflictEmpty:
+	case DiffState::Unknown:
+	case DiffState::Empty:
+		return false;
+	}
+	return true;
+}
+
+viewdata MakeRow(const viewdata& line, DiffState state)
+{
+	viewdata row(line);
+	// keep the collapse state of lines which were already unchanged
+	if (state != DiffState::Normal || line.state != DiffState::Normal)
+		row.hidestate = HideState::Shown;
+	row.state = state;
+	row.movedIndex = -1;
+	row.movedFrom = true;
+	return row;
+}
+
+viewdata MakeEmptyRow()
+{
+	return viewdata(CString(), DiffState::Empty, -1, EOL::NoEnding, HideState::Shown);
+}
+}
+
+bool CIncrementalDiff::Result::MatchesViews(const CViewData& leftData, const CViewData& rightData) const
+{
+	if (lastViewLine >= leftData.GetCount() || lastViewLine >= rightData.GetCount())
+		return false;
+	for (int row = firstViewLine; row <= lastViewLine; ++row)
+	{
+		const viewdata& oldLeftRow = oldLeft[row - firstViewLine];
+		const viewdata& oldRightRow = oldRight[row - firstViewLine];
+		if (leftData.GetState(row) != oldLeftRow.state || leftData.GetLine(row) != oldLeftRow.sLine)
+			return false;
+		if (rightData.GetState(row) != oldRightRow.state || rightData.GetLine(row) != oldRightRow.sLine)
+			return false;
+	}
+	return true;
+}
+
+void CIncrementalDiff::GetAnchoredWindow(const CViewData& left, const CViewData& right, int& first, int& last)
+{
+	const int count = min(left.GetCount(), right.GetCount());
+	first = max(0, min(first, count - 1));
+	last = max(first, min(last, count - 1));
+	while (first > 0 && !IsAnchorRow(left, right, first - 1))
+		--first;
+	while (last < count - 1 && !IsAnchorRow(left, right, last + 1))
+		++last;
+}
+
+std::vector<viewdata> CIncrementalDiff::GetRealLines(const std::vector<viewdata>& rows)
+{
+	std::vector<viewdata> lines;
+	lines.reserve(rows.size());
+	std::copy_if(rows.cbegin(), rows.cend(), std::back_inserter(lines), IsRealLine);
+	return lines;
+}
+
+void CIncrementalDiff::LayoutWindow(Result& result, const std::vector<DiffBlock>& blocks)
+{
+	const std::vector<viewdata> leftLines = GetRealLines(result.oldLeft);
+	const std::vector<viewdata> rightLines = GetRealLines(result.oldRight);
+
+	result.left.clear();
+	result.right.clear();
+	size_t leftPos = 0;
+	size_t rightPos = 0;
+	for (const auto& block : blocks)
+	{
+		if (block.bCommon)
+		{
+			for (size_t i = 0; i < block.leftLines && leftPos < leftLines.size() && rightPos < rightLines.size(); ++i)
+			{
+				result.left.push_back(MakeRow(leftLines[leftPos++], DiffState::Normal));
+				result.right.push_back(MakeRow(rightLines[rightPos++], DiffState::Normal));
+			}
+		}
+		else
+		{
+			// same layout as CDiffData::DoTwoWayDiff: removed and added lines side by side, padded with empty rows
+			for (size_t i = 0; i < block.rightLines && rightPos < rightLines.size(); ++i)
+			{
+				result.right.push_back(MakeRow(rightLines[rightPos++], DiffState::Added));
+				if (i >= block.leftLines || leftPos >= leftLines.size())
+					result.left.push_back(MakeEmptyRow());
+				else
+					result.left.push_back(MakeRow(leftLines[leftPos++], DiffState::Removed));
+			}
+			for (size_t i = block.rightLines; i < block.leftLines && leftPos < leftLines.size(); ++i)
+			{
+				result.left.push_back(MakeRow(leftLines[leftPos++], DiffState::Removed));
+				result.right.push_back(MakeEmptyRow());
+			}
+		}
+	}
+	// the diff does not report lines it could not tokenize, keep them as changes
+	while (leftPos < leftLines.size())
+	{
+		result.left.push_back(MakeRow(leftLines[leftPos++], DiffState::Removed));
+		result.right.push_back(MakeEmptyRow());
+	}
+	while (rightPos < rightLines.size())
+	{
+		result.left.push_back(MakeEmptyRow());
+		result.right.push_back(MakeRow(rightLines[rightPos++], DiffState::Added));
+	}
+}
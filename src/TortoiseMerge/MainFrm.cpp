@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2004-2018, 2020 - TortoiseSVN
 // Copyright (C) 2012-2014 - Sven Strickroth <email@cs-ware.de>
 
@@ -49,6 +49,7 @@
 
 // CMainFrame
 #define IDT_RELOADCHECKTIMER 123
+#define IDT_INCREMENTALDIFFTIMER 124
 
 IMPLEMENT_DYNCREATE(CMainFrame, CFrameWndEx)
 
@@ -190,6 +191,7 @@ BEGIN_MESSAGE_MAP(CMainFrame, CFrameWndEx)
 	ON_WM_SETTINGCHANGE()
 	ON_WM_SYSCOLORCHANGE()
 	ON_MESSAGE(WM_DPICHANGED, OnDPIChanged)
+	ON_MESSAGE(WM_INCREMENTALDIFFDONE, OnIncrementalDiffDone)
 END_MESSAGE_MAP()
 
 static UINT indicators[] =
@@ -754,6 +756,7 @@ void CMainFrame::ClearViewNamesAndPaths()
 
 bool CMainFrame::LoadViews(int line)
 {
+	CancelIncrementalDiff();
 	LoadIgnoreCommentData();
 	m_Data.SetBlame(m_bBlame);
 	m_Data.SetMovedBlocks(m_bViewMovedBlocks);
@@ -2457,6 +2460,7 @@ void CMainFrame::OnEditUndo()
 {
 	if (CUndo::GetInstance().CanUndo())
 	{
+		CancelIncrementalDiff();
 		CUndo::GetInstance().Undo(m_pwndLeftView, m_pwndRightView, m_pwndBottomView);
 	}
 }
@@ -2470,6 +2474,7 @@ void CMainFrame::OnEditRedo()
 {
 	if (CUndo::GetInstance().CanRedo())
 	{
+		CancelIncrementalDiff();
 		CUndo::GetInstance().Redo(m_pwndLeftView, m_pwndRightView, m_pwndBottomView);
 	}
 }
@@ -3162,11 +3167,93 @@ void CMainFrame::OnTimer(UINT_PTR nIDEvent)
 		KillTimer(nIDEvent);
 		CheckForReload();
 		break;
+	case IDT_INCREMENTALDIFFTIMER:
+		KillTimer(nIDEvent);
+		StartIncrementalDiff();
+		break;
 	}
 
 	__super::OnTimer(nIDEvent);
 }
 
+void CMainFrame::ScheduleIncrementalDiff(int nFirstViewLine, int nLastViewLine)
+{
+	// only the two-pane view can be re-diffed partially
+	if (m_bOneWay || !IsViewGood(m_pwndLeftView) || !IsViewGood(m_pwndRightView) || IsViewGood(m_pwndBottomView))
+		return;
+	if (m_pwndLeftView->m_pViewData != &m_Data.m_YourBaseLeft || m_pwndRightView->m_pViewData != &m_Data.m_YourBaseRight)
+		return;
+
+	// a running re-diff is outdated now
+	m_IncrementalDiff.Invalidate();
+	if (m_nIncrementalDiffFirst < 0)
+	{
+		m_nIncrementalDiffFirst = nFirstViewLine;
+		m_nIncrementalDiffLast = nLastViewLine;
+	}
+	else
+	{
+		m_nIncrementalDiffFirst = min(m_nIncrementalDiffFirst, nFirstViewLine);
+		m_nIncrementalDiffLast = max(m_nIncrementalDiffLast, nLastViewLine);
+	}
+	// wait until the user stops typing
+	SetTimer(IDT_INCREMENTALDIFFTIMER, 500, nullptr);
+}
+
+void CMainFrame::CancelIncrementalDiff()
+{
+	KillTimer(IDT_INCREMENTALDIFFTIMER);
+	m_IncrementalDiff.Invalidate();
+	m_nIncrementalDiffFirst = -1;
+	m_nIncrementalDiffLast = -1;
+}
+
+void CMainFrame::StartIncrementalDiff()
+{
+	int nFirstViewLine = m_nIncrementalDiffFirst;
+	int nLastViewLine = m_nIncrementalDiffLast;
+	m_nIncrementalDiffFirst = -1;
+	m_nIncrementalDiffLast = -1;
+	if (nFirstViewLine < 0)
+		return;
+	if (!IsViewGood(m_pwndLeftView) || !IsViewGood(m_pwndRightView) || !m_pwndLeftView->m_pViewData || !m_pwndRightView->m_pViewData)
+		return;
+	bool bIgnoreEOL = true;
+	if (!m_Data.CanDiffIncrementally(bIgnoreEOL))
+		return;
+	m_IncrementalDiff.Start(GetSafeHwnd(), *m_pwndLeftView->m_pViewData, *m_pwndRightView->m_pViewData, nFirstViewLine, nLastViewLine, bIgnoreEOL);
+}
+
+LRESULT CMainFrame::OnIncrementalDiffDone(WPARAM /*wParam*/, LPARAM /*lParam*/)
+{
+	std::unique_ptr<CIncrementalDiff::Result> pResult = m_IncrementalDiff.TakeResult();
+	if (!pResult)
+		return 0;
+	if (!IsViewGood(m_pwndLeftView) || !IsViewGood(m_pwndRightView) || IsViewGood(m_pwndBottomView))
+		return 0;
+	if (m_pwndLeftView->m_pViewData != &m_Data.m_YourBaseLeft || m_pwndRightView->m_pViewData != &m_Data.m_YourBaseRight)
+		return 0;
+	// the views might have been changed by an undo/redo in the meantime
+	if (!pResult->MatchesViews(m_Data.m_YourBaseLeft, m_Data.m_YourBaseRight))
+		return 0;
+	// the new alignment belongs to the edit which triggered it: it must not be a step of its own
+	// (undoing it alone would restore an outdated alignment) and it must not clear the redo steps
+	CUndo& undo = CUndo::GetInstance();
+	if (!undo.CanUndo() || undo.CanRedo() || undo.IsGrouping() || CBaseView::HasPendingUndoStep())
+		return 0;
+
+	m_pwndLeftView->ReplaceViewData(pResult->firstViewLine, pResult->lastViewLine, pResult->left);
+	m_pwndRightView->ReplaceViewData(pResult->firstViewLine, pResult->lastViewLine, pResult->right);
+	m_pwndRightView->SaveUndoStepToLast();
+
+	CBaseView::BuildAllScreen2ViewVector();
+	CBaseView::RecalcAllVertScrollBars();
+	m_wndLocatorBar.DocumentUpdated();
+	m_wndLineDiffBar.DocumentUpdated();
+	m_pwndRightView->RefreshViews();
+	return 0;
+}
+
 void CMainFrame::LoadIgnoreCommentData()
 {
 	static bool bLoaded = false;
@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2013, 2021-2025 - TortoiseGit
+// Copyright (C) 2013, 2021-2026 - TortoiseGit
 // Copyright (C) 2006-2015, 2017, 2020 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -28,6 +28,7 @@
 #include "../../ext/SimpleIni/SimpleIni.h"
 #include "CustomMFCRibbonStatusBar.h"
 #include "NativeRibbonApp.h"
+#include "IncrementalDiff.h"
 
 class CLeftView;
 class CRightView;
@@ -63,6 +64,8 @@ public:
 	void			DiffLeftToBase();
 	void			DiffRightToBase();
 	int				CheckResolved();
+	/// re-diffs the two-pane view around the given (edited) view lines in the background after a short delay
+	void			ScheduleIncrementalDiff(int nFirstViewLine, int nLastViewLine);
 
 #ifdef _DEBUG
 	virtual void	AssertValid() const;
@@ -86,6 +89,7 @@ protected:
 	afx_msg LRESULT	OnTaskbarButtonCreated(WPARAM wParam, LPARAM lParam);
 	afx_msg LRESULT	OnIdleUpdateCmdUI(WPARAM wParam, LPARAM);
 	afx_msg LRESULT	OnDPIChanged(WPARAM wParam, LPARAM);
+	afx_msg LRESULT	OnIncrementalDiffDone(WPARAM wParam, LPARAM lParam);
 
 	afx_msg void	OnFileSave();
 	afx_msg void	OnFileSaveAs();
@@ -302,6 +306,12 @@ protected:
 	std::map<CString, std::tuple<CString, CString, CString>>	m_IgnoreCommentsMap;
 	CSimpleIni		m_regexIni;
 	int				m_regexIndex = -1;
+
+	CIncrementalDiff	m_IncrementalDiff;
+	int				m_nIncrementalDiffFirst = -1;
+	int				m_nIncrementalDiffLast = -1;
+	void			StartIncrementalDiff();
+	void			CancelIncrementalDiff();
 public:
 	CLeftView*		m_pwndLeftView = nullptr;
 	CRightView*		m_pwndRightView = nullptr;
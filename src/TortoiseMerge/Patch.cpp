@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2009-2013, 2015-2023, 2025 - TortoiseGit
+// Copyright (C) 2009-2013, 2015-2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2012-2013 - Sven Strickroth <email@cs-ware.de>
 // Copyright (C) 2004-2009,2011-2014 - TortoiseSVN
 
@@ -44,27 +44,30 @@ CPatch::~CPatch()
 void CPatch::FreeMemory()
 {
 	m_arFileDiffs.clear();
+	m_nLoadedChunks = -1;
+	m_sPatchFile.Empty();
+	m_PatchFileStamp = CPatchBuffer::Stamp();
 }
 
-BOOL CPatch::ParsePatchFile(CFileTextLines &PatchLines)
+BOOL CPatch::ParsePatchFile()
 {
 	CString sLine;
-	EOL ending = EOL::NoEnding;
 
 	int state = 0;
 	int nIndex = 0;
 	std::unique_ptr<Chunks> chunks;
-	std::unique_ptr<Chunk> chunk;
-	int nAddLineCount = 0;
-	int nRemoveLineCount = 0;
-	int nContextLineCount = 0;
 	std::map<CString, int> filenamesToPatch;
-	for ( ; nIndex < PatchLines.GetCount(); ++nIndex)
+	CPatchBuffer::Line line;
+	for (size_t pos = 0; m_PatchBuffer.ReadLine(pos, line); pos = line.next, ++nIndex)
 	{
-		sLine = PatchLines.GetAt(nIndex);
-		ending = PatchLines.GetLineEnding(nIndex);
-		if (ending != EOL::NoEnding)
-			ending = EOL::AutoLine;
+		if (state <= 1)
+		{
+			// only convert lines which might be interesting, there's usually a lot of text between file diffs
+			const wchar_t firstChar = m_PatchBuffer.GetFirstChar(line);
+			if (firstChar != L'd' && firstChar != L'i' && firstChar != L'-' && firstChar != L'@')
+				continue;
+		}
+		sLine = m_PatchBuffer.GetText(line);
 
 		switch (state)
 		{
@@ -157,6 +160,8 @@ BOOL CPatch::ParsePatchFile(CFileTextLines &PatchLines)
 					{
 						if (chunks)
 						{
+							// parse this line again
+							line.next = line.start;
 							nIndex--;
 							state = 4;
 						}
@@ -217,7 +222,6 @@ BOOL CPatch::ParsePatchFile(CFileTextLines &PatchLines)
 					//chunk doesn't start with "@@"
 					//so there's garbage in between two file diffs
 					state = 0;
-					chunk.reset();
 					chunks.reset();
 					break;		//skip the garbage
 				}
@@ -225,7 +229,7 @@ BOOL CPatch::ParsePatchFile(CFileTextLines &PatchLines)
 				//@@ -xxx,xxx +xxx,xxx @@
 				sLine = sLine.Mid(static_cast<int>(wcslen(L"@@")));
 				sLine = sLine.Trim();
-				chunk = std::make_unique<Chunk>();
+				auto chunk = std::make_unique<Chunk>();
 				CString sRemove = sLine.Left(sLine.Find(' '));
 				CString sAdd = sLine.Mid(sLine.Find(' '));
 				chunk->lRemoveStart = abs(_wtol(sRemove));
@@ -250,96 +254,26 @@ BOOL CPatch::ParsePatchFile(CFileTextLines &PatchLines)
 					chunk->lAddStart = 1;
 					chunk->lAddLength = _wtol(sAdd);
 				}
-				++state;
-			}
-			break;
 
-			case 5: //[ |+|-] <sourceline>
-			{
-				//this line is either a context line (with a ' ' in front)
-				//a line added (with a '+' in front)
-				//or a removed line (with a '-' in front)
-				wchar_t type;
-				if (sLine.IsEmpty())
-					type = ' ';
-				else
-					type = sLine.GetAt(0);
-				if (type == ' ')
-				{
-					//it's a context line - we don't use them here right now
-					//but maybe in the future the patch algorithm can be
-					//extended to use those in case the file to patch has
-					//already changed and no base file is around...
-					chunk->arLines.Add(RemoveUnicodeBOM(sLine.Mid(static_cast<int>(wcslen(L" ")))));
-					chunk->arLinesStates.Add(PATCHSTATE_CONTEXT);
-					chunk->arEOLs.push_back(ending);
-					++nContextLineCount;
-				}
-				else if (type == '\\')
-				{
-					//it's a context line (sort of):
-					//warnings start with a '\' char (e.g. "\ No newline at end of file")
-					//so just ignore this...
-				}
-				else if (type == '-')
-				{
-					//a removed line
-					chunk->arLines.Add(RemoveUnicodeBOM(sLine.Mid(static_cast<int>(wcslen(L"-")))));
-					if (chunk->lRemoveStart == 1 && nRemoveLineCount == 0)
-					{
-						if (HasUnicodeBOM(sLine.Mid(static_cast<int>(wcslen(L"-")))))
-							chunks->oldHasBom = 1;
-						else
-							chunks->oldHasBom = 0;
-					}
-					chunk->arLinesStates.Add(PATCHSTATE_REMOVED);
-					chunk->arEOLs.push_back(ending);
-					++nRemoveLineCount;
-				}
-				else if (type == '+')
-				{
-					//an added line
-					chunk->arLines.Add(RemoveUnicodeBOM(sLine.Mid(static_cast<int>(wcslen(L"+")))));
-					if (chunk->lAddStart == 1 && nAddLineCount == 0)
-					{
-						if (HasUnicodeBOM(sLine.Mid(static_cast<int>(wcslen(L"-")))))
-							chunks->newHasBom = 1;
-						else
-							chunks->newHasBom = 0;
-					}
-					chunk->arLinesStates.Add(PATCHSTATE_ADDED);
-					chunk->arEOLs.push_back(ending);
-					++nAddLineCount;
-				}
-				else
-				{
-					//none of those lines! what the hell happened here?
-					m_sErrorMessage.Format(IDS_ERR_PATCH_UNKNOWNLINETYPE, nIndex);
+				// only check the lines of the chunk for now, they are read again when the file gets patched
+				chunk->nBodyStart = line.next;
+				chunk->nBodyLine = nIndex + 1;
+				size_t nBodyEnd = chunk->nBodyStart;
+				int nLine = chunk->nBodyLine;
+				if (!ReadChunkLines(*chunks, *chunk, nBodyEnd, nLine, false))
 					goto errorcleanup;
-				}
-				if ((chunk->lAddLength == (nAddLineCount + nContextLineCount)) &&
-					chunk->lRemoveLength == (nRemoveLineCount + nContextLineCount))
-				{
-					//chunk is finished
-					if (chunks)
-						chunks->chunks.emplace_back(std::move(chunk));
-					chunk.reset();
-					nAddLineCount = 0;
-					nContextLineCount = 0;
-					nRemoveLineCount = 0;
-					state = 0;
-				}
+				chunks->chunks.emplace_back(std::move(chunk));
+				// continue behind the chunk
+				line.next = nBodyEnd;
+				nIndex = nLine - 1;
+				state = 0;
 			}
-		break;
+			break;
+
 		default:
 			ASSERT(FALSE);
 		} // switch (state)
-	} // for ( ;nIndex<m_PatchLines.GetCount(); nIndex++)
-	if (chunk)
-	{
-		m_sErrorMessage.LoadString(IDS_ERR_PATCH_CHUNKMISMATCH);
-		goto errorcleanup;
-	}
+	} // for (size_t pos = 0; m_PatchBuffer.ReadLine(pos, line); pos = line.next, ++nIndex)
 	if (chunks)
 		m_arFileDiffs.emplace_back(chunks.release());
 
@@ -371,23 +305,149 @@ errorcleanup:
 	return FALSE;
 }
 
+bool CPatch::ReadChunkLines(Chunks& chunks, Chunk& chunk, size_t& pos, int& nLine, bool bStoreLines)
+{
+	int nAddLineCount = 0;
+	int nRemoveLineCount = 0;
+	int nContextLineCount = 0;
+	CPatchBuffer::Line line;
+	for (; m_PatchBuffer.ReadLine(pos, line); pos = line.next, ++nLine)
+	{
+		//this line is either a context line (with a ' ' in front)
+		//a line added (with a '+' in front)
+		//or a removed line (with a '-' in front)
+		const wchar_t type = line.length ? m_PatchBuffer.GetFirstChar(line) : L' ';
+		DWORD nPatchState;
+		if (type == ' ')
+		{
+			//it's a context line - we don't use them here right now
+			//but maybe in the future the patch algorithm can be
+			//extended to use those in case the file to patch has
+			//already changed and no base file is around...
+			nPatchState = PATCHSTATE_CONTEXT;
+			++nContextLineCount;
+		}
+		else if (type == '\\')
+		{
+			//it's a context line (sort of):
+			//warnings start with a '\' char (e.g. "\ No newline at end of file")
+			//so just ignore this...
+			nPatchState = static_cast<DWORD>(-1);
+		}
+		else if (type == '-')
+		{
+			//a removed line
+			if (chunk.lRemoveStart == 1 && nRemoveLineCount == 0)
+				chunks.oldHasBom = HasUnicodeBOM(m_PatchBuffer.GetText(line, wcslen(L"-"))) ? 1 : 0;
+			nPatchState = PATCHSTATE_REMOVED;
+			++nRemoveLineCount;
+		}
+		else if (type == '+')
+		{
+			//an added line
+			if (chunk.lAddStart == 1 && nAddLineCount == 0)
+				chunks.newHasBom = HasUnicodeBOM(m_PatchBuffer.GetText(line, wcslen(L"+"))) ? 1 : 0;
+			nPatchState = PATCHSTATE_ADDED;
+			++nAddLineCount;
+		}
+		else
+		{
+			//none of those lines! what the hell happened here?
+			m_sErrorMessage.Format(IDS_ERR_PATCH_UNKNOWNLINETYPE, nLine);
+			return false;
+		}
+		if (bStoreLines && nPatchState != static_cast<DWORD>(-1))
+		{
+			chunk.arLines.Add(RemoveUnicodeBOM(m_PatchBuffer.GetText(line, 1)));
+			chunk.arLinesStates.Add(nPatchState);
+			chunk.arEOLs.push_back(line.bHasEnding ? EOL::AutoLine : EOL::NoEnding);
+		}
+		if ((chunk.lAddLength == (nAddLineCount + nContextLineCount)) &&
+			chunk.lRemoveLength == (nRemoveLineCount + nContextLineCount))
+		{
+			//chunk is finished
+			pos = line.next;
+			++nLine;
+			return true;
+		}
+	}
+	m_sErrorMessage.LoadString(IDS_ERR_PATCH_CHUNKMISMATCH);
+	return false;
+}
+
+bool CPatch::LoadChunks(int nIndex)
+{
+	if (nIndex == m_nLoadedChunks)
+		return true;
+	UnloadChunks();
+
+	if (!m_PatchBuffer.Open(m_sPatchFile))
+	{
+		m_sErrorMessage = m_PatchBuffer.GetErrorString();
+		return false;
+	}
+	SCOPE_EXIT { m_PatchBuffer.Close(); };
+	// the chunk positions are only valid for the file which was parsed
+	if (m_PatchBuffer.GetStamp() != m_PatchFileStamp)
+	{
+		m_sErrorMessage.LoadString(IDS_ERR_PATCH_FILECHANGED);
+		return false;
+	}
+
+	auto chunks = m_arFileDiffs[nIndex].get();
+	for (const auto& chunk : chunks->chunks)
+	{
+		size_t pos = chunk->nBodyStart;
+		int nLine = chunk->nBodyLine;
+		if (!ReadChunkLines(*chunks, *chunk, pos, nLine, true))
+		{
+			m_nLoadedChunks = nIndex;
+			UnloadChunks();
+			return false;
+		}
+	}
+	m_nLoadedChunks = nIndex;
+	return true;
+}
+
+void CPatch::UnloadChunks()
+{
+	if (m_nLoadedChunks < 0 || m_nLoadedChunks >= static_cast<int>(m_arFileDiffs.size()))
+	{
+		m_nLoadedChunks = -1;
+		return;
+	}
+	for (const auto& chunk : m_arFileDiffs[m_nLoadedChunks]->chunks)
+	{
+		chunk->arLines.RemoveAll();
+		chunk->arLinesStates.RemoveAll();
+		chunk->arEOLs.clear();
+		chunk->arEOLs.shrink_to_fit();
+	}
+	m_nLoadedChunks = -1;
+}
+
 BOOL CPatch::OpenUnifiedDiffFile(const CString& filename)
 {
 #ifndef GOOGLETEST_INCLUDE_GTEST_GTEST_H_
 	CCrashReport::Instance().AddFile2(filename, nullptr, L"unified diff file", CR_AF_MAKE_FILE_COPY);
 #endif
 
-	CFileTextLines PatchLines;
-	if (!PatchLines.Load(filename))
+	FreeMemory();
+	if (!m_PatchBuffer.Open(filename))
 	{
-		m_sErrorMessage = PatchLines.GetErrorString();
+		m_sErrorMessage = m_PatchBuffer.GetErrorString();
 		return FALSE;
 	}
-	FreeMemory();
 
-	//now we got all the lines of the patch file
-	//in our array - parsing can start...
-	return ParsePatchFile(PatchLines);
+	//only the file headers and the positions of the chunks
+	//are read here, the chunk lines are read when needed
+	SCOPE_EXIT { m_PatchBuffer.Close(); };
+	if (!ParsePatchFile())
+		return FALSE;
+	m_sPatchFile = filename;
+	m_PatchFileStamp = m_PatchBuffer.GetStamp();
+	return TRUE;
 }
 
 CString CPatch::GetFilename(int nIndex)
@@ -457,6 +517,8 @@ int CPatch::PatchFile(const int strip, int nIndex, const CString& sPatchPath, co
 	PatchLinesResult = PatchLines;  //.Copy(PatchLines);
 	PatchLines.CopySettings(&PatchLinesResult);
 
+	if (!LoadChunks(nIndex))
+		return FALSE;
 	auto chunks = m_arFileDiffs[nIndex].get();
 
 	for (size_t i = 0; i < chunks->chunks.size(); ++i)
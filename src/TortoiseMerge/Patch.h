@@ -1,5 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
+// Copyright (C) 2026 - TortoiseGit
 // Copyright (C) 2006-2008, 2014 - TortoiseSVN
 // Copyright (C) 2012-2013, 2018-2019, 2021-2023 - Sven Strickroth <email@cs-ware.de>
 
@@ -19,6 +20,7 @@
 //
 #pragma once
 #include "FileTextLines.h"
+#include "PatchBuffer.h"
 
 
 #define PATCHSTATE_REMOVED	0
@@ -30,6 +32,11 @@
  *
  * Handles unified diff files, parses them and also is able to
  * apply those diff files.
+ *
+ * When opening a diff file only the file headers and the positions
+ * of the hunks are read, the lines of the hunks are read from the
+ * (memory mapped) diff file when a file gets patched. The diff file
+ * is only mapped while it is read, so it is not locked in between.
  */
 class CPatch
 {
@@ -56,7 +63,7 @@ protected:
 	CString		RemoveUnicodeBOM(const CString& str) const;
 	bool		HasUnicodeBOM(const CString& str) const;
 
-	BOOL		ParsePatchFile(CFileTextLines &PatchLines);
+	BOOL		ParsePatchFile();
 
 	/**
 	 * Strips the filename by removing m_nStrip prefixes.
@@ -68,6 +75,9 @@ protected:
 		LONG					lRemoveLength = 0;
 		LONG					lAddStart = 0;
 		LONG					lAddLength = 0;
+		size_t					nBodyStart = 0;		///< position of the first line of the chunk in the diff file
+		int						nBodyLine = 0;		///< line number of the first line of the chunk
+		// the lines are only available between LoadChunks() and UnloadChunks()
 		CStringArray			arLines;
 		CStdDWORDArray			arLinesStates;
 		std::vector<EOL>		arEOLs;
@@ -84,7 +94,20 @@ protected:
 		int						newHasBom = -1;
 	};
 
+	/**
+	 * Reads the lines of a chunk starting at \a pos, which is moved behind the chunk.
+	 * If \a bStoreLines is false, the lines are only checked and counted.
+	 */
+	bool		ReadChunkLines(Chunks& chunks, Chunk& chunk, size_t& pos, int& nLine, bool bStoreLines);
+	/// reads the lines of all chunks of a file diff, the lines of the previously loaded file diff are released
+	bool		LoadChunks(int nIndex);
+	void		UnloadChunks();
+
 	std::vector<std::unique_ptr<Chunks>>	m_arFileDiffs;
+	CPatchBuffer				m_PatchBuffer;
+	CString						m_sPatchFile;
+	CPatchBuffer::Stamp			m_PatchFileStamp;		///< the version of the diff file the chunk positions belong to
+	int							m_nLoadedChunks = -1;	///< index of the file diff whose chunk lines are loaded
 	CString						m_sErrorMessage;
 	CFileTextLines::UnicodeType m_UnicodeType = CFileTextLines::UnicodeType::AUTOTYPE;
 
@@ -99,6 +122,6 @@ protected:
 
 #ifdef GOOGLETEST_INCLUDE_GTEST_GTEST_H_
 public:
-	const auto& GetChunks(int index) const { return m_arFileDiffs[index]->chunks; };
+	const auto& GetChunks(int index) { LoadChunks(index); return m_arFileDiffs[index]->chunks; };
 #endif
 };
@@ -0,0 +1,272 @@
+// TortoiseGitMerge - a Diff/Patch program
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#include "stdafx.h"
+#include "resource.h"
+#include "PatchBuffer.h"
+#include "FileTextLines.h"
+#include "FormatMessageWrapper.h"
+
+CPatchBuffer::~CPatchBuffer()
+{
+	Close();
+}
+
+void CPatchBuffer::Close()
+{
+	if (m_pView)
+		UnmapViewOfFile(m_pView);
+	m_pView = nullptr;
+	m_pChars = nullptr;
+	m_pWideChars = nullptr;
+	m_nSize = 0;
+	m_sConverted.clear();
+	m_sConverted.shrink_to_fit();
+	m_stamp = Stamp();
+	m_hMapping.CloseHandle();
+	m_hFile.CloseHandle();
+}
+
+BOOL CPatchBuffer::Open(const CString& sFilePath)
+{
+	Close();
+	m_sErrorString.Empty();
+
+	if (PathIsDirectory(sFilePath))
+	{
+		m_sErrorString.Format(IDS_ERR_FILE_NOTAFILE, static_cast<LPCWSTR>(sFilePath));
+		return FALSE;
+	}
+
+	m_hFile = CreateFile(sFilePath, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_DELETE | FILE_SHARE_WRITE, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (!m_hFile)
+	{
+		if (GetLastError() == ERROR_FILE_NOT_FOUND || GetLastError() == ERROR_PATH_NOT_FOUND)
+			return TRUE; // same as CFileTextLines::Load(): a missing file has no lines
+		m_sErrorString = static_cast<LPCWSTR>(CFormatMessageWrapper());
+		return FALSE;
+	}
+
+	LARGE_INTEGER fsize;
+	FILETIME lastWriteTime;
+	if (!GetFileSizeEx(m_hFile, &fsize) || !GetFileTime(m_hFile, nullptr, nullptr, &lastWriteTime))
+	{
+		m_sErrorString = static_cast<LPCWSTR>(CFormatMessageWrapper());
+		Close();
+		return FALSE;
+	}
+	m_stamp.size = static_cast<ULONGLONG>(fsize.QuadPart);
+	m_stamp.lastWriteTime = static_cast<ULONGLONG>(lastWriteTime.dwHighDateTime) << 32 | lastWriteTime.dwLowDateTime;
+	if (fsize.QuadPart == 0)
+		return TRUE; // empty files cannot be mapped
+	if (static_cast<ULONGLONG>(fsize.QuadPart) > SIZE_MAX)
+	{
+		m_sErrorString.LoadString(IDS_ERR_FILE_TOOBIG);
+		Close();
+		return FALSE;
+	}
+
+	m_hMapping = CreateFileMapping(m_hFile, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (m_hMapping)
+		m_pView = static_cast<const BYTE*>(MapViewOfFile(m_hMapping, FILE_MAP_READ, 0, 0, 0));
+	if (!m_pView)
+	{
+		m_sErrorString = static_cast<LPCWSTR>(CFormatMessageWrapper());
+		Close();
+		return FALSE;
+	}
+	const size_t nBytes = static_cast<size_t>(fsize.QuadPart);
+
+	CFileTextLines detector;
+	const auto type = detector.CheckUnicodeType(m_pView, static_cast<int>(std::min<size_t>(nBytes, INT_MAX)));
+	switch (type)
+	{
+	case CFileTextLines::UnicodeType::BINARY:
+		m_sErrorString.Format(IDS_ERR_FILE_BINARY, static_cast<LPCWSTR>(sFilePath));
+		Close();
+		return FALSE;
+	case CFileTextLines::UnicodeType::UTF8BOM:
+		m_nCodePage = CP_UTF8;
+		m_pChars = reinterpret_cast<const char*>(m_pView) + 3;
+		m_nSize = nBytes - 3;
+		break;
+	case CFileTextLines::UnicodeType::UTF8:
+		m_nCodePage = CP_UTF8;
+		m_pChars = reinterpret_cast<const char*>(m_pView);
+		m_nSize = nBytes;
+		break;
+	default:
+	case CFileTextLines::UnicodeType::ASCII:
+		m_nCodePage = CP_ACP;
+		m_pChars = reinterpret_cast<const char*>(m_pView);
+		m_nSize = nBytes;
+		break;
+	case CFileTextLines::UnicodeType::UTF16_LEBOM:
+		m_pWideChars = reinterpret_cast<const wchar_t*>(m_pView) + 1;
+		m_nSize = nBytes / sizeof(wchar_t) - 1;
+		break;
+	case CFileTextLines::UnicodeType::UTF16_LE:
+		m_pWideChars = reinterpret_cast<const wchar_t*>(m_pView);
+		m_nSize = nBytes / sizeof(wchar_t);
+		break;
+	case CFileTextLines::UnicodeType::UTF16_BE:
+	case CFileTextLines::UnicodeType::UTF16_BEBOM:
+	case CFileTextLines::UnicodeType::UTF32_LE:
+	case CFileTextLines::UnicodeType::UTF32_BE:
+		{
+			// rare encodings, convert the whole file
+			if (nBytes >= INT_MAX)
+			{
+				m_sErrorString.LoadString(IDS_ERR_FILE_TOOBIG);
+				Close();
+				return FALSE;
+			}
+			std::unique_ptr<CDecodeFilter> pFilter;
+			if (type == CFileTextLines::UnicodeType::UTF32_LE)
+				pFilter = std::make_unique<CUtf32leFilter>(nullptr);
+			else if (type == CFileTextLines::UnicodeType::UTF32_BE)
+				pFilter = std::make_unique<CUtf32beFilter>(nullptr);
+			else
+				pFilter = std::make_unique<CUtf16beFilter>(nullptr);
+			auto data = std::unique_ptr<BYTE[]>(new BYTE[nBytes]);
+			memcpy(data.get(), m_pView, nBytes);
+			if (!pFilter->Decode(std::move(data), static_cast<int>(nBytes)))
+			{
+				m_sErrorString = static_cast<LPCWSTR>(CFormatMessageWrapper());
+				Close();
+				return FALSE;
+			}
+			m_sConverted = pFilter->GetStringView();
+			UnmapViewOfFile(m_pView);
+			m_pView = nullptr;
+			m_hMapping.CloseHandle();
+			m_hFile.CloseHandle();
+			m_pWideChars = m_sConverted.c_str();
+			m_nSize = m_sConverted.size();
+			if (type != CFileTextLines::UnicodeType::UTF16_BE && m_nSize)
+			{
+				// ignore the BOM
+				++m_pWideChars;
+				--m_nSize;
+			}
+		}
+		break;
+	}
+	return TRUE;
+}
+
+template <typename T>
+bool CPatchBuffer::FindLineEnd(const T* pBuffer, size_t pos, Line& line) const
+{
+	line.start = pos;
+	line.bHasEnding = false;
+	for (size_t i = pos; i < m_nSize; ++i)
+	{
+		size_t nEndingLength = 0;
+		switch (static_cast<UINT>(pBuffer[i]))
+		{
+		case '\r':
+			nEndingLength = (i + 1 < m_nSize && pBuffer[i + 1] == '\n') ? 2 : 1;
+			break;
+		case '\n':
+			// LFCR, unless it is just a LF followed by CRLF
+			nEndingLength = (i + 1 < m_nSize && pBuffer[i + 1] == '\r' && !(i + 2 < m_nSize && pBuffer[i + 2] == '\n')) ? 2 : 1;
+			break;
+		case 0x000b:
+		case 0x000c:
+			nEndingLength = 1;
+			break;
+		case 0x0085:
+		case 0x2028:
+		case 0x2029:
+			if constexpr (sizeof(T) == sizeof(wchar_t))
+				nEndingLength = 1;
+			break;
+		case 0xc2:
+			// UTF-8 encoded NEL
+			if constexpr (sizeof(T) == sizeof(char))
+			{
+				if (m_nCodePage == CP_UTF8 && i + 1 < m_nSize && pBuffer[i + 1] == 0x85)
+					nEndingLength = 2;
+			}
+			break;
+		case 0xe2:
+			// UTF-8 encoded LS and PS
+			if constexpr (sizeof(T) == sizeof(char))
+			{
+				if (m_nCodePage == CP_UTF8 && i + 2 < m_nSize && pBuffer[i + 1] == 0x80 && (pBuffer[i + 2] == 0xa8 || pBuffer[i + 2] == 0xa9))
+					nEndingLength = 3;
+			}
+			break;
+		}
+		if (nEndingLength)
+		{
+			line.length = i - pos;
+			line.next = i + nEndingLength;
+			line.bHasEnding = true;
+			return true;
+		}
+	}
+	line.length = m_nSize - pos;
+	// mark the last line as read
+	line.next = m_nSize + 1;
+	return true;
+}
+
+bool CPatchBuffer::ReadLine(size_t pos, Line& line) const
+{
+	// the last line has no line ending and might be empty, but an empty file has no lines at all
+	if (m_nSize == 0 || pos > m_nSize)
+		return false;
+	if (m_pChars)
+		return FindLineEnd(reinterpret_cast<const BYTE*>(m_pChars), pos, line);
+	return FindLineEnd(m_pWideChars, pos, line);
+}
+
+wchar_t CPatchBuffer::GetFirstChar(const Line& line) const
+{
+	if (line.length == 0)
+		return 0;
+	if (m_pChars)
+	{
+		const BYTE c = static_cast<BYTE>(m_pChars[line.start]);
+		// only ASCII characters are of interest for the callers
+		return c < 0x80 ? static_cast<wchar_t>(c) : 0xFFFD;
+	}
+	return m_pWideChars[line.start];
+}
+
+CString CPatchBuffer::GetText(const Line& line, size_t skip) const
+{
+	if (line.length <= skip)
+		return CString();
+	const size_t start = line.start + skip;
+	const int length = static_cast<int>(line.length - skip);
+	if (m_pWideChars)
+		return CString(m_pWideChars + start, length);
+
+	const int nFlags = (m_nCodePage == CP_ACP) ? MB_PRECOMPOSED : 0;
+	const int nChars = MultiByteToWideChar(m_nCodePage, nFlags, m_pChars + start, length, nullptr, 0);
+	CString sText;
+	if (nChars > 0)
+	{
+		MultiByteToWideChar(m_nCodePage, nFlags, m_pChars + start, length, sText.GetBuffer(nChars), nChars);
+		sText.ReleaseBuffer(nChars);
+	}
+	return sText;
+}
@@ -0,0 +1,86 @@
+// TortoiseGitMerge - a Diff/Patch program
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+
+/**
+ * \ingroup TortoiseMerge
+ * Read-only, line based access to a (possibly huge) patch file.
+ *
+ * UTF-8, ANSI and UTF-16LE files are memory mapped and a line is only
+ * converted to a CString when its text is requested. Files in other
+ * encodings are converted as a whole when opened.
+ * Lines are split the same way CFileTextLines::Load() does, including
+ * the last line without a line ending.
+ */
+class CPatchBuffer
+{
+public:
+	struct Line
+	{
+		size_t	start = 0;			///< offset of the first unit of the line
+		size_t	length = 0;			///< number of units without the line ending
+		size_t	next = 0;			///< offset of the following line
+		bool	bHasEnding = false;
+	};
+
+	CPatchBuffer() = default;
+	~CPatchBuffer();
+	CPatchBuffer(const CPatchBuffer&) = delete;
+	CPatchBuffer& operator=(const CPatchBuffer&) = delete;
+
+	/// identifies the version of the opened file, to detect changes between two Open() calls
+	struct Stamp
+	{
+		ULONGLONG	size = 0;
+		ULONGLONG	lastWriteTime = 0;
+
+		bool operator==(const Stamp& other) const { return size == other.size && lastWriteTime == other.lastWriteTime; }
+		bool operator!=(const Stamp& other) const { return !(*this == other); }
+	};
+
+	BOOL			Open(const CString& sFilePath);
+	void			Close();
+	CString			GetErrorString() const { return m_sErrorString; }
+	Stamp			GetStamp() const { return m_stamp; }
+
+	/**
+	 * Reads the line starting at offset \a pos.
+	 * \return false if there are no more lines
+	 */
+	bool			ReadLine(size_t pos, Line& line) const;
+	/// returns the first character of the line, 0 for empty lines
+	wchar_t			GetFirstChar(const Line& line) const;
+	/// converts the line, skipping the first \a skip characters (which have to be ASCII)
+	CString			GetText(const Line& line, size_t skip = 0) const;
+
+private:
+	template <typename T>
+	bool			FindLineEnd(const T* pBuffer, size_t pos, Line& line) const;
+
+	CAutoFile			m_hFile;
+	CAutoGeneralHandle	m_hMapping;
+	const BYTE*			m_pView = nullptr;
+	const char*			m_pChars = nullptr;		///< set for UTF-8 and ANSI files
+	const wchar_t*		m_pWideChars = nullptr;	///< set for all other files
+	std::wstring		m_sConverted;			///< the converted content for files which cannot be used directly
+	size_t				m_nSize = 0;			///< in units of m_pChars or m_pWideChars
+	UINT				m_nCodePage = CP_UTF8;
+	Stamp				m_stamp;
+	CString				m_sErrorString;
+};
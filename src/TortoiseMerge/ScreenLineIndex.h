@@ -0,0 +1,143 @@
+// TortoiseGitMerge - a Diff/Patch program
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+#pragma once
+#include <vector>
+
+/**
+ * \ingroup TortoiseMerge
+ * Maps view lines to screen lines and back.
+ *
+ * Every view line occupies a number of screen lines (0 for collapsed lines,
+ * more than 1 for wrapped lines). The counts are kept in a Fenwick tree, so
+ * changing the count of a single line as well as looking up the first screen
+ * line of a view line or the view line of a screen line are O(log n).
+ */
+class CScreenLineIndex
+{
+public:
+	/// replaces all counts, O(n)
+	void Assign(std::vector<int>&& counts)
+	{
+		m_counts = std::move(counts);
+		m_tree.assign(m_counts.size() + 1, 0);
+		m_total = 0;
+		for (size_t i = 1; i <= m_counts.size(); ++i)
+		{
+			m_tree[i] += m_counts[i - 1];
+			m_total += m_counts[i - 1];
+			size_t parent = i + (i & (~i + 1));
+			if (parent <= m_counts.size())
+				m_tree[parent] += m_tree[i];
+		}
+	}
+
+	/// a change of the number of view lines: count > 0 lines were inserted before index, count < 0 lines were removed from index on
+	struct LineShift
+	{
+		int index;
+		int count;
+	};
+
+	/**
+	 * Applies \a shifts in the order they happened and rebuilds the tree once, O(n).
+	 * The inserted lines get \a insertedCount screen lines, e.g. -1 to find them afterwards.
+	 * \return false if a shift does not fit, the index is unchanged then
+	 */
+	bool Shift(const std::vector<LineShift>& shifts, int insertedCount)
+	{
+		std::vector<int> counts = m_counts;
+		for (const auto& shift : shifts)
+		{
+			if (shift.index < 0 || shift.index > static_cast<int>(counts.size()))
+				return false;
+			if (shift.count >= 0)
+				counts.insert(counts.begin() + shift.index, shift.count, insertedCount);
+			else
+			{
+				if (shift.index - shift.count > static_cast<int>(counts.size()))
+					return false;
+				counts.erase(counts.begin() + shift.index, counts.begin() + (shift.index - shift.count));
+			}
+		}
+		Assign(std::move(counts));
+		return true;
+	}
+
+	void Clear()
+	{
+		m_counts.clear();
+		m_tree.assign(1, 0);
+		m_total = 0;
+	}
+
+	/// number of view lines
+	int GetCount() const { return static_cast<int>(m_counts.size()); }
+	/// total number of screen lines
+	int GetTotal() const { return m_total; }
+	/// number of screen lines of view line \a index
+	int GetLineCount(int index) const { return m_counts[index]; }
+
+	void SetLineCount(int index, int count)
+	{
+		const int delta = count - m_counts[index];
+		if (delta == 0)
+			return;
+		m_counts[index] = count;
+		m_total += delta;
+		for (size_t i = index + 1; i < m_tree.size(); i += i & (~i + 1))
+			m_tree[i] += delta;
+	}
+
+	/// returns the first screen line of view line \a index (which is the total for index == GetCount())
+	int GetStart(int index) const
+	{
+		int sum = 0;
+		for (size_t i = index; i > 0; i -= i & (~i + 1))
+			sum += m_tree[i];
+		return sum;
+	}
+
+	/// returns the view line which contains \a screenLine, or -1 if \a screenLine is out of range
+	int FindIndex(int screenLine) const
+	{
+		if (screenLine < 0 || screenLine >= m_total)
+			return -1;
+		// find the largest position whose prefix sum is <= screenLine
+		size_t pos = 0;
+		size_t bit = 1;
+		while ((bit << 1) < m_tree.size())
+			bit <<= 1;
+		int remaining = screenLine;
+		for (; bit; bit >>= 1)
+		{
+			if (pos + bit < m_tree.size() && m_tree[pos + bit] <= remaining)
+			{
+				pos += bit;
+				remaining -= m_tree[pos];
+			}
+		}
+		// pos view lines end before screenLine; collapsed lines (count 0) are skipped that way
+		return static_cast<int>(pos);
+	}
+
+private:
+	std::vector<int>	m_counts;
+	std::vector<int>	m_tree = std::vector<int>(1, 0); ///< 1-based Fenwick tree
+	int					m_total = 0;
+};
@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2023 - TortoiseGit
+// Copyright (C) 2023, 2026 - TortoiseGit
 // Copyright (C) 2006-2007, 2010-2011, 2013,2015, 2021-2022 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -28,10 +28,12 @@ void viewstate::AddViewLineFromView(CBaseView *pView, int nViewLine, bool bAddEm
 	// is undo good place for this ?
 	if (!pView || !pView->m_pViewData)
 		return;
-	replacedlines[nViewLine] = pView->m_pViewData->GetData(nViewLine);
+	if (!snapshot)
+		replacedlines[nViewLine] = pView->m_pViewData->GetData(nViewLine);
 	if (bAddEmptyLine)
 	{
-		addedlines.push_back(nViewLine + 1);
+		if (!snapshot)
+			addedlines.push_back(nViewLine + 1);
 		pView->AddEmptyViewLine(nViewLine);
 	}
 }
@@ -47,9 +49,56 @@ void viewstate::Clear()
 
 	removedlines.clear();
 	replacedlines.clear();
+	snapshot.reset();
 	modifies = false;
 }
 
+void viewstate::Commit()
+{
+	difflines.Commit();
+	linestates.Commit();
+	linelines.Commit();
+	linesEOL.Commit();
+	markedlines.Commit();
+	removedlines.Commit();
+	replacedlines.Commit();
+}
+
+bool viewstate::GetLineRange(int& first, int& last) const
+{
+	bool bFound = false;
+	auto extend = [&](int line)
+	{
+		first = min(first, line);
+		last = max(last, line);
+		bFound = true;
+	};
+	auto extendMap = [&](const auto& lines)
+	{
+		if (!lines.empty())
+		{
+			extend(lines.cbegin()->first);
+			extend((lines.cend() - 1)->first);
+		}
+	};
+	if (snapshot)
+	{
+		// the whole view, the receivers clamp the range to the line count
+		extend(0);
+		extend(INT_MAX);
+	}
+	for (int line : addedlines)
+		extend(line);
+	extendMap(difflines);
+	extendMap(linestates);
+	extendMap(linelines);
+	extendMap(linesEOL);
+	extendMap(markedlines);
+	extendMap(removedlines);
+	extendMap(replacedlines);
+	return bFound;
+}
+
 void CUndo::MarkAsOriginalState(bool bLeft, bool bRight, bool bBottom)
 {
 	// find highest index of changing step
@@ -75,7 +124,7 @@ CUndo::~CUndo()
 {
 }
 
-void CUndo::AddState(const allviewstate& allstate, POINT pt)
+void CUndo::AddState(allviewstate&& allstate, POINT pt)
 {
 	if (allstate.left.modifies)
 		++m_originalstateLeft;
@@ -84,7 +133,8 @@ void CUndo::AddState(const allviewstate& allstate, POINT pt)
 	if (allstate.bottom.modifies)
 		++m_originalstateBottom;
 
-	m_viewstates.push_back(allstate);
+	allstate.Commit();
+	m_viewstates.push_back(std::move(allstate));
 	m_caretpoints.push_back(pt);
 	// a new action that can be undone clears the redo since
 	// after this there is nothing to redo anymore
@@ -93,6 +143,35 @@ void CUndo::AddState(const allviewstate& allstate, POINT pt)
 	m_redogroups.clear();
 }
 
+void CUndo::AddStateToLastStep(allviewstate&& allstate)
+{
+	ASSERT(CanUndo() && !IsGrouping());
+	if (allstate.left.modifies)
+		++m_originalstateLeft;
+	if (allstate.right.modifies)
+		++m_originalstateRight;
+	if (allstate.bottom.modifies)
+		++m_originalstateBottom;
+
+	// an empty group at the end would separate the new state from the last step
+	if (m_groups.size() >= 2 && m_groups.back() == m_caretpoints.size() && *std::prev(m_groups.cend(), 2) == m_groups.back())
+	{
+		m_groups.pop_back();
+		m_groups.pop_back();
+	}
+	if (m_groups.empty() || m_groups.back() != m_caretpoints.size())
+	{
+		// turn the last step into a group
+		m_groups.push_back(m_caretpoints.size() - 1);
+		m_groups.push_back(m_caretpoints.size());
+	}
+
+	allstate.Commit();
+	m_viewstates.push_back(std::move(allstate));
+	m_caretpoints.push_back(m_caretpoints.back());
+	++m_groups.back();
+}
+
 bool CUndo::Undo(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom)
 {
 	if (!CanUndo())
@@ -118,7 +197,7 @@ bool CUndo::Undo(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom)
 
 void CUndo::UndoOne(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom)
 {
-	allviewstate allstate = m_viewstates.back();
+	allviewstate allstate = std::move(m_viewstates.back());
 	POINT pt = m_caretpoints.back();
 
 	if (pLeft->IsTarget())
@@ -139,7 +218,7 @@ void CUndo::UndoOne(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom)
 	allstate.right  = Do(allstate.right, pRight, pt);
 	allstate.bottom = Do(allstate.bottom, pBottom, pt);
 
-	m_redoviewstates.push_back(allstate);
+	m_redoviewstates.push_back(std::move(allstate));
 
 	m_viewstates.pop_back();
 	m_caretpoints.pop_back();
@@ -170,7 +249,7 @@ bool CUndo::Redo(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom)
 
 void CUndo::RedoOne(CBaseView* pLeft, CBaseView* pRight, CBaseView* pBottom)
 {
-	allviewstate allstate = m_redoviewstates.back();
+	allviewstate allstate = std::move(m_redoviewstates.back());
 	POINT pt = m_redocaretpoints.back();
 
 	if (pLeft->IsTarget())
@@ -191,7 +270,7 @@ void CUndo::RedoOne(CBaseView* pLeft, CBaseView* pRight, CBaseView* pBottom)
 	allstate.right = Do(allstate.right, pRight, pt);
 	allstate.bottom = Do(allstate.bottom, pBottom, pt);
 
-	m_viewstates.push_back(allstate);
+	m_viewstates.push_back(std::move(allstate));
 
 	m_redoviewstates.pop_back();
 	m_redocaretpoints.pop_back();
@@ -242,24 +321,38 @@ void CUndo::updateActiveView(CBaseView* pLeft, CBaseView* pRight, CBaseView* pBo
 		pActiveView->RefreshViews();
 	}
 }
-viewstate CUndo::Do(const viewstate& state, CBaseView * pView, const POINT& pt)
+viewstate CUndo::Do(viewstate& state, CBaseView * pView, const POINT& pt)
 {
 	if (!pView)
-		return state;
+		return std::move(state);
 
 	CViewData* viewData = pView->m_pViewData;
 	if (!viewData)
-		return state;
+		return std::move(state);
 
 	viewstate revstate; // the reversed viewstate
 	revstate.modifies = state.modifies;
 
-	for (std::list<int>::const_reverse_iterator it = state.addedlines.rbegin(); it != state.addedlines.rend(); ++it)
+	// a step with a snapshot does not record any lines of the view
+	if (state.snapshot)
+	{
+		viewData->Swap(*state.snapshot);
+		revstate.snapshot = std::move(state.snapshot);
+	}
+
+	if (!state.addedlines.empty())
 	{
-		revstate.removedlines[*it] = viewData->GetData(*it);
-		viewData->RemoveData(*it);
+		// lines are removed in descending order, collect them first so that they don't have to be inserted at the front one by one
+		std::vector<std::pair<int, viewdata>> removedlines;
+		removedlines.reserve(state.addedlines.size());
+		for (auto it = state.addedlines.rbegin(); it != state.addedlines.rend(); ++it)
+		{
+			removedlines.emplace_back(*it, viewData->GetData(*it));
+			viewData->RemoveData(*it);
+		}
+		revstate.removedlines.Assign(std::move(removedlines));
 	}
-	for (std::map<int, DWORD>::const_iterator it = state.linelines.begin(); it != state.linelines.end(); ++it)
+	for (auto it = state.linelines.cbegin(); it != state.linelines.cend(); ++it)
 	{
 		revstate.linelines[it->first] = viewData->GetLineNumber(it->first);
 		viewData->SetLineNumber(it->first, it->second);
@@ -269,27 +362,27 @@ viewstate CUndo::Do(const viewstate& state, CBaseView * pView, const POINT& pt)
 		revstate.linestates[it->first] = viewData->GetState(it->first);
 		viewData->SetState(it->first, it->second);
 	}
-	for (std::map<int, EOL>::const_iterator it = state.linesEOL.begin(); it != state.linesEOL.end(); ++it)
+	for (auto it = state.linesEOL.cbegin(); it != state.linesEOL.cend(); ++it)
 	{
 		revstate.linesEOL[it->first] = viewData->GetLineEnding(it->first);
 		viewData->SetLineEnding(it->first, it->second);
 	}
-	for (std::map<int, bool>::const_iterator it = state.markedlines.begin(); it != state.markedlines.end(); ++it)
+	for (auto it = state.markedlines.cbegin(); it != state.markedlines.cend(); ++it)
 	{
 		revstate.markedlines[it->first] = viewData->GetMarked(it->first);
 		viewData->SetMarked(it->first, it->second);
 	}
-	for (std::map<int, CString>::const_iterator it = state.difflines.begin(); it != state.difflines.end(); ++it)
+	for (auto it = state.difflines.cbegin(); it != state.difflines.cend(); ++it)
 	{
 		revstate.difflines[it->first] = viewData->GetLine(it->first);
 		viewData->SetLine(it->first, it->second);
 	}
-	for (std::map<int, viewdata>::const_iterator it = state.removedlines.begin(); it != state.removedlines.end(); ++it)
+	for (auto it = state.removedlines.cbegin(); it != state.removedlines.cend(); ++it)
 	{
 		revstate.addedlines.push_back(it->first);
 		viewData->InsertData(it->first, it->second);
 	}
-	for (std::map<int, viewdata>::const_iterator it = state.replacedlines.begin(); it != state.replacedlines.end(); ++it)
+	for (auto it = state.replacedlines.cbegin(); it != state.replacedlines.cend(); ++it)
 	{
 		revstate.replacedlines[it->first] = viewData->GetData(it->first);
 		viewData->SetData(it->first, it->second);
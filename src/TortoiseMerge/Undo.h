@@ -1,5 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
+// Copyright (C) 2026 - TortoiseGit
 // Copyright (C) 2006-2007,2009-2015 - TortoiseSVN
 // Copyright (C) 2011, 2023 Sven Strickroth <email@cs-ware.de>
 
@@ -19,11 +20,78 @@
 //
 #pragma once
 #include "ViewData.h"
-#include <map>
+#include <algorithm>
 #include <list>
+#include <memory>
+#include <vector>
 
 class CBaseView;
 
+/**
+ * \ingroup TortoiseMerge
+ * A compact map from a view line index to a value, stored as a vector.
+ * Entries are appended while an undo step is recorded and sorted once by
+ * Commit() when the step is complete, so recording is linear even if the
+ * lines are not touched in ascending order. Compared to std::map there is
+ * no per entry allocation and an empty map does not allocate at all.
+ */
+template <typename T>
+class CUndoLineMap
+{
+public:
+	using value_type = std::pair<int, T>;
+	using const_iterator = typename std::vector<value_type>::const_iterator;
+
+	/// for writing only: an index which is not the last one gets a new entry, which replaces the older one on Commit()
+	T& operator[](int index)
+	{
+		if (!m_entries.empty() && m_entries.back().first >= index)
+		{
+			if (m_entries.back().first == index)
+				return m_entries.back().second;
+			m_bSorted = false;
+		}
+		m_entries.emplace_back(index, T());
+		return m_entries.back().second;
+	}
+
+	/// replaces the content with \a entries (in any order), for duplicate indexes the latter entry wins
+	void Assign(std::vector<value_type>&& entries)
+	{
+		Sort(entries);
+		m_entries = std::move(entries);
+		m_bSorted = true;
+	}
+
+	/// sorts the entries by index, needed before the entries are read
+	void Commit()
+	{
+		if (m_bSorted)
+			return;
+		Sort(m_entries);
+		m_bSorted = true;
+	}
+
+	const_iterator	begin() const { ASSERT(m_bSorted); return m_entries.cbegin(); }
+	const_iterator	end() const { return m_entries.cend(); }
+	const_iterator	cbegin() const { ASSERT(m_bSorted); return m_entries.cbegin(); }
+	const_iterator	cend() const { return m_entries.cend(); }
+	bool			empty() const { return m_entries.empty(); }
+	size_t			size() const { ASSERT(m_bSorted); return m_entries.size(); }
+	void			clear() { m_entries.clear(); m_entries.shrink_to_fit(); m_bSorted = true; }
+
+private:
+	static void Sort(std::vector<value_type>& entries)
+	{
+		std::stable_sort(entries.begin(), entries.end(), [](const value_type& a, const value_type& b) { return a.first < b.first; });
+		auto last = std::unique(entries.rbegin(), entries.rend(), [](const value_type& a, const value_type& b) { return a.first == b.first; });
+		entries.erase(entries.begin(), last.base());
+	}
+
+	std::vector<value_type> m_entries;
+	bool					m_bSorted = true;
+};
+
 /**
  * \ingroup TortoiseMerge
  * this struct holds all the information of a single change in TortoiseMerge.
@@ -34,20 +102,26 @@ public:
 	viewstate()
 	{}
 
-	std::map<int, CString>	difflines;
-	std::map<int, DiffState>	linestates;
-	std::map<int, DWORD>	linelines;
-	std::map<int, EOL>		linesEOL;
-	std::map<int, bool>		markedlines;
-	std::list<int>			addedlines;
-
-	std::map<int, viewdata> removedlines;
-	std::map<int, viewdata> replacedlines;
+	CUndoLineMap<CString>	difflines;
+	CUndoLineMap<DiffState>	linestates;
+	CUndoLineMap<DWORD>		linelines;
+	CUndoLineMap<EOL>		linesEOL;
+	CUndoLineMap<bool>		markedlines;
+	std::vector<int>		addedlines;
+
+	CUndoLineMap<viewdata>	removedlines;
+	CUndoLineMap<viewdata>	replacedlines;
+	/// the complete view data before a step which replaces the whole view, no single lines are recorded then
+	std::unique_ptr<CViewData>	snapshot;
 	bool					modifies = false; ///< this step modifies view (save before and after save differs)
 
 	void	AddViewLineFromView(CBaseView *pView, int nViewLine, bool bAddEmptyLine);
 	void	Clear();
-	bool	IsEmpty() const { return difflines.empty() && linestates.empty() && linelines.empty() && linesEOL.empty() && markedlines.empty() && addedlines.empty() && removedlines.empty() && replacedlines.empty(); }
+	/// sorts the recorded lines, called once the step is complete
+	void	Commit();
+	/// extends [first, last] by the view lines touched by this step (start with INT_MAX, -1), returns false if no line was touched
+	bool	GetLineRange(int& first, int& last) const;
+	bool	IsEmpty() const { return difflines.empty() && linestates.empty() && linelines.empty() && linesEOL.empty() && markedlines.empty() && addedlines.empty() && removedlines.empty() && replacedlines.empty() && !snapshot; }
 };
 
 /**
@@ -61,6 +135,14 @@ struct allviewstate
 	viewstate left;
 
 	void	Clear() { right.Clear(); bottom.Clear(); left.Clear(); }
+	void	Commit() { right.Commit(); bottom.Commit(); left.Commit(); }
+	bool	GetLineRange(int& first, int& last) const
+	{
+		bool bRight = right.GetLineRange(first, last);
+		bool bBottom = bottom.GetLineRange(first, last);
+		bool bLeft = left.GetLineRange(first, last);
+		return bRight || bBottom || bLeft;
+	}
 	bool	IsEmpty() const { return right.IsEmpty() && bottom.IsEmpty() && left.IsEmpty(); }
 };
 
@@ -76,7 +158,9 @@ public:
 
 	bool Undo(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom);
 	bool Redo(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom);
-	void AddState(const allviewstate& allstate, POINT pt);
+	void AddState(allviewstate&& allstate, POINT pt);
+	/// records \a allstate as part of the last step, so that both are undone and redone together, keeps the redo steps
+	void AddStateToLastStep(allviewstate&& allstate);
 	bool CanUndo() const {return !m_viewstates.empty();}
 	bool CanRedo() const { return !m_redoviewstates.empty(); }
 
@@ -88,7 +172,7 @@ public:
 	void MarkAllAsOriginalState() { MarkAsOriginalState(true, true, true); }
 	void MarkAsOriginalState(bool Left, bool Right, bool Bottom);
 protected:
-	viewstate Do(const viewstate& state, CBaseView * pView, const POINT& pt);
+	viewstate Do(viewstate& state, CBaseView * pView, const POINT& pt);
 	void UndoOne(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom);
 	void RedoOne(CBaseView * pLeft, CBaseView * pRight, CBaseView * pBottom);
 	void updateActiveView(CBaseView* pLeft, CBaseView* pRight, CBaseView* pBottom) const;
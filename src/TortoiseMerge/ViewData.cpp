@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2023 - TortoiseGit
+// Copyright (C) 2023, 2026 - TortoiseGit
 // Copyright (C) 2007,2009-2010, 2014 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -42,7 +42,10 @@ void CViewData::AddData(const CString& sLine, DiffState state, int linenumber, E
 
 void CViewData::AddData(const viewdata& data)
 {
-	return m_data.push_back(data);
+	m_lines.push_back(data.sLine);
+	m_linenumbers.push_back(data.linenumber);
+	m_movedIndexes.push_back(data.movedIndex);
+	m_attributes.push_back(PackAttributes(data));
 }
 
 void CViewData::InsertData(int index, const CString& sLine, DiffState state, int linenumber, EOL ending, HideState hide, int movedIndex)
@@ -59,13 +62,87 @@ void CViewData::InsertData(int index, const CString& sLine, DiffState state, int
 
 void CViewData::InsertData(int index, const viewdata& data)
 {
-	m_data.insert(m_data.begin()+index, data);
+	m_lines.insert(m_lines.begin() + index, data.sLine);
+	m_linenumbers.insert(m_linenumbers.begin() + index, data.linenumber);
+	m_movedIndexes.insert(m_movedIndexes.begin() + index, data.movedIndex);
+	m_attributes.insert(m_attributes.begin() + index, PackAttributes(data));
+}
+
+void CViewData::RemoveData(int index)
+{
+	m_lines.erase(m_lines.begin() + index);
+	m_linenumbers.erase(m_linenumbers.begin() + index);
+	m_movedIndexes.erase(m_movedIndexes.begin() + index);
+	m_attributes.erase(m_attributes.begin() + index);
+}
+
+viewdata CViewData::GetData(int index) const
+{
+	const auto& attributes = m_attributes[index];
+	viewdata data(m_lines[index], static_cast<DiffState>(attributes.state), m_linenumbers[index], static_cast<EOL>(attributes.ending), static_cast<HideState>(attributes.hidestate), attributes.marked);
+	data.movedIndex = m_movedIndexes[index];
+	data.movedFrom = attributes.movedFrom;
+	return data;
+}
+
+void CViewData::SetData(int index, const viewdata& data)
+{
+	SetMarked(index, data.marked);
+	m_lines[index] = data.sLine;
+	m_linenumbers[index] = data.linenumber;
+	m_movedIndexes[index] = data.movedIndex;
+	m_attributes[index] = PackAttributes(data);
+}
+
+void CViewData::Clear()
+{
+	m_lines.clear();
+	m_linenumbers.clear();
+	m_movedIndexes.clear();
+	m_attributes.clear();
+	m_nMarkedBlocks = 0;
+}
+
+void CViewData::Reserve(int length)
+{
+	m_lines.reserve(length);
+	m_linenumbers.reserve(length);
+	m_movedIndexes.reserve(length);
+	m_attributes.reserve(length);
+}
+
+void CViewData::Swap(CViewData& other) noexcept
+{
+	m_lines.swap(other.m_lines);
+	m_linenumbers.swap(other.m_linenumbers);
+	m_movedIndexes.swap(other.m_movedIndexes);
+	m_attributes.swap(other.m_attributes);
+	std::swap(m_nMarkedBlocks, other.m_nMarkedBlocks);
+}
+
+size_t CViewData::GetMemoryUsage() const
+{
+	return m_lines.capacity() * sizeof(CString)
+		+ m_linenumbers.capacity() * sizeof(int)
+		+ m_movedIndexes.capacity() * sizeof(int)
+		+ m_attributes.capacity() * sizeof(lineattributes);
+}
+
+CViewData::lineattributes CViewData::PackAttributes(const viewdata& data)
+{
+	lineattributes attributes;
+	attributes.state = static_cast<BYTE>(data.state);
+	attributes.ending = static_cast<BYTE>(data.ending);
+	attributes.hidestate = static_cast<BYTE>(data.hidestate);
+	attributes.marked = data.marked ? 1 : 0;
+	attributes.movedFrom = data.movedFrom ? 1 : 0;
+	return attributes;
 }
 
 int CViewData::FindLineNumber(int number) const
 {
-	for(size_t i = 0; i < m_data.size(); ++i)
-		if (m_data[i].linenumber >= number)
+	for (size_t i = 0; i < m_linenumbers.size(); ++i)
+		if (m_linenumbers[i] >= number)
 			return static_cast<int>(i);
 	return -1;
 }
@@ -1,6 +1,6 @@
 ﻿// TortoiseGitMerge - a Diff/Patch program
 
-// Copyright (C) 2023 - TortoiseGit
+// Copyright (C) 2023, 2026 - TortoiseGit
 // Copyright (C) 2007-2011, 2013-2014 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -68,6 +68,12 @@ public:
 /**
  * \ingroup TortoiseMerge
  * Handles the view and diff data a TortoiseMerge view needs.
+ *
+ * The data is stored as struct-of-arrays: the text, the line numbers, the
+ * moved indexes and the packed per line attributes (state, EOL, hide state
+ * and flags) each live in their own vector. The text column stores CStrings
+ * which share their (reference counted) buffers with the CFileTextLines the
+ * view was filled from, so no line text gets duplicated.
  */
 class CViewData
 {
@@ -80,53 +86,67 @@ public:
 	void			AddEmpty() {AddData(CString(), DiffState::Empty, -1, EOL::NoEnding, HideState::Shown, -1);}
 	void			InsertData(int index, const CString& sLine, DiffState state, int linenumber, EOL ending, HideState hide, int movedline);
 	void			InsertData(int index, const viewdata& data);
-	void			RemoveData(int index) {m_data.erase(m_data.begin() + index);}
-
-	const viewdata&	GetData(int index) const {return m_data[index];}
-	const CString&	GetLine(int index) const {return m_data[index].sLine;}
-	DiffState		GetState(int index) const {return m_data[index].state;}
-	HideState		GetHideState(int index) const {return m_data[index].hidestate;}
-	int				GetLineNumber(int index) const {return m_data.size() ? m_data[index].linenumber : 0;}
-	int				GetMovedIndex(int index) const {return m_data.size() ? m_data[index].movedIndex: 0;}
-	bool			IsMoved(int index) const {return m_data.size() ? m_data[index].movedIndex >= 0 : false;}
-	bool			IsMovedFrom(int index) const {return m_data.size() ? m_data[index].movedFrom : true;}
+	void			RemoveData(int index);
+
+	viewdata		GetData(int index) const;
+	const CString&	GetLine(int index) const {return m_lines[index];}
+	DiffState		GetState(int index) const {return static_cast<DiffState>(m_attributes[index].state);}
+	HideState		GetHideState(int index) const {return static_cast<HideState>(m_attributes[index].hidestate);}
+	int				GetLineNumber(int index) const {return m_linenumbers.size() ? m_linenumbers[index] : 0;}
+	int				GetMovedIndex(int index) const {return m_movedIndexes.size() ? m_movedIndexes[index] : 0;}
+	bool			IsMoved(int index) const {return m_movedIndexes.size() ? m_movedIndexes[index] >= 0 : false;}
+	bool			IsMovedFrom(int index) const {return m_attributes.size() ? m_attributes[index].movedFrom : true;}
 	int				FindLineNumber(int number) const;
-	EOL				GetLineEnding(int index) const {return m_data[index].ending;}
-	bool			GetMarked(int index) const {return m_data[index].marked;}
-
-	int				GetCount() const { return static_cast<int>(m_data.size()); }
-
-	void			SetData(int index, const viewdata& data)
-	{
-		bool oldmarked = m_data[index].marked;
-		bool marked = data.marked;
-		if (oldmarked && !marked && m_nMarkedBlocks > 0)
-			m_nMarkedBlocks--;
-		else if (!oldmarked && marked)
-			m_nMarkedBlocks++;
-		m_data[index] = data;
-	}
-	void			SetState(int index, DiffState state) {m_data[index].state = state;}
-	void			SetLine(int index, const CString& sLine) {m_data[index].sLine = sLine;}
-	void			SetLineNumber(int index, int linenumber) {m_data[index].linenumber = linenumber;}
-	void			SetLineEnding(int index, EOL ending) {m_data[index].ending = ending;}
-	void			SetMovedIndex(int index, int movedIndex, bool movedFrom) {m_data[index].movedIndex = movedIndex; m_data[index].movedFrom = movedFrom;}
-	void			SetLineHideState(int index, HideState state) {m_data[index].hidestate = state;}
+	EOL				GetLineEnding(int index) const {return static_cast<EOL>(m_attributes[index].ending);}
+	bool			GetMarked(int index) const {return m_attributes[index].marked;}
+
+	int				GetCount() const { return static_cast<int>(m_lines.size()); }
+
+	void			SetData(int index, const viewdata& data);
+	void			SetState(int index, DiffState state) {m_attributes[index].state = static_cast<BYTE>(state);}
+	void			SetLine(int index, const CString& sLine) {m_lines[index] = sLine;}
+	void			SetLineNumber(int index, int linenumber) {m_linenumbers[index] = linenumber;}
+	void			SetLineEnding(int index, EOL ending) {m_attributes[index].ending = static_cast<BYTE>(ending);}
+	void			SetMovedIndex(int index, int movedIndex, bool movedFrom) {m_movedIndexes[index] = movedIndex; m_attributes[index].movedFrom = movedFrom;}
+	void			SetLineHideState(int index, HideState state) {m_attributes[index].hidestate = static_cast<BYTE>(state);}
 	void			SetMarked(int index, bool marked)
 	{
-		bool oldmarked = m_data[index].marked;
+		bool oldmarked = m_attributes[index].marked;
 		if (oldmarked && !marked && m_nMarkedBlocks > 0)
 			m_nMarkedBlocks--;
 		else if (!oldmarked && marked)
 			m_nMarkedBlocks++;
-		m_data[index].marked = marked;
+		m_attributes[index].marked = marked;
 	}
 	bool			HasMarkedBlocks() const { return m_nMarkedBlocks > 0; }
 
-	void			Clear() { m_data.clear(); m_nMarkedBlocks = 0; }
-	void			Reserve(int length) {m_data.reserve(length);}
+	void			Clear();
+	void			Reserve(int length);
+	/// exchanges the content with \a other without copying any line
+	void			Swap(CViewData& other) noexcept;
+
+	/// returns the number of bytes used by the per line bookkeeping (excluding the text buffers)
+	size_t			GetMemoryUsage() const;
 
 protected:
-	std::vector<viewdata>		m_data;
+	/// packed per line attributes, see viewdata for the meaning of the members
+	struct lineattributes
+	{
+		BYTE		state;
+		BYTE		ending;
+		BYTE		hidestate : 2;
+		BYTE		marked : 1;
+		BYTE		movedFrom : 1;
+	};
+	static_assert(static_cast<int>(DiffState::End) <= UCHAR_MAX, "DiffState does not fit into a byte");
+	static_assert(static_cast<int>(EOL::_COUNT) <= UCHAR_MAX, "EOL does not fit into a byte");
+	static_assert(sizeof(lineattributes) <= 4, "lineattributes should be packed");
+
+	static lineattributes	PackAttributes(const viewdata& data);
+
+	std::vector<CString>		m_lines;
+	std::vector<int>			m_linenumbers;
+	std::vector<int>			m_movedIndexes;
+	std::vector<lineattributes>	m_attributes;
 	int							m_nMarkedBlocks = 0;
 };
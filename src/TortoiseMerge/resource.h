@@ -136,6 +136,7 @@
 #define IDS_ERR_FILE_BINARY             1101
 #define IDS_ERR_FILE_NOTAFILE           1102
 #define IDS_ERR_FILE_TOOBIG             1103
+#define IDS_ERR_PATCH_FILECHANGED       1104
 #define IDS_ERR_PATCHPATHS              1111
 #define IDS_ERR_ERROR                   1112
 #define IDS_ERR_INVALIDREGEX            1113
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2009-2021, 2023-2025 - TortoiseGit
+// Copyright (C) 2009-2021, 2023-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -483,6 +483,11 @@ void CBrowseRefsDlg::Refresh(CString selectRef)
 		CGit::GetShortName(treeLeaf.m_csUpstream, treeLeaf.m_csUpstream, L"remotes/");
 		if (!ref.m_UpstreamRef.IsEmpty() && !std::binary_search(remoteBranches.cbegin(), remoteBranches.cend(), ref.m_UpstreamRef))
 			treeLeaf.m_csUpstream = L"(gone: " + treeLeaf.m_csUpstream + L")";
+		else if (ref.m_Ahead != static_cast<size_t>(-1) && (ref.m_Ahead || ref.m_Behind))
+		{
+			treeLeaf.m_csUpstream += L' ';
+			treeLeaf.m_csUpstream.AppendFormat(IDS_PROC_BROWSEREFS_AHEADBEHIND, ref.m_Behind, ref.m_Ahead);
+		}
 		treeLeaf.m_csSubject = ref.GetSubject();
 		treeLeaf.m_csAuthor = ref.GetAuthorName();
 		treeLeaf.m_csAuthorDate = ref.GetAuthorDate();
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2003-2008 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -162,7 +162,7 @@ UINT CChangedDlg::ChangedStatusThread()
 	g_Git.RefreshGitIndex();
 
 	m_FileListCtrl.StoreScrollPos();
-	m_FileListCtrl.Clear();
+	m_FileListCtrl.ClearForRefresh();
 	m_FileListCtrl.m_bIncludedStaged = (m_bShowStaged == TRUE);
 	if (!m_FileListCtrl.GetStatus(m_bWholeProject ? nullptr : &m_pathList, m_bRemote, m_bShowIgnored != FALSE, m_bShowUnversioned != FALSE, m_bShowLocalChangesIgnored != FALSE))
 	{
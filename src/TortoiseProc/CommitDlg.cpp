@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2014 - TortoiseSVN
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -40,6 +40,7 @@
 #include "StringUtils.h"
 #include "FileTextLines.h"
 #include "DPIAware.h"
+#include <thread>
 
 #ifdef _DEBUG
 #define new DEBUG_NEW
@@ -48,10 +49,36 @@ static char THIS_FILE[] = __FILE__;
 #endif
 
 UINT CCommitDlg::WM_AUTOLISTREADY = RegisterWindowMessage(L"TORTOISEGIT_AUTOLISTREADY_MSG");
+UINT CCommitDlg::WM_UNVERSIONEDREADY = RegisterWindowMessage(L"TORTOISEGIT_COMMIT_UNVERSIONEDREADY");
 UINT CCommitDlg::WM_UPDATEOKBUTTON = RegisterWindowMessage(L"TORTOISEGIT_COMMIT_UPDATEOKBUTTON");
 UINT CCommitDlg::WM_UPDATEDATAFALSE = RegisterWindowMessage(L"TORTOISEGIT_COMMIT_UPDATEDATAFALSE");
 UINT CCommitDlg::WM_PARTIALSTAGINGREFRESHPATCHVIEW = RegisterWindowMessage(L"TORTOISEGIT_COMMIT_PARTIALSTAGINGREFRESHPATCHVIEW"); // same string in PatchViewDlg.cpp!!!
 
+struct CCommitDlg::UnversionedFetch
+{
+	LONG			generation = 0;
+	CString			workingDir;
+	CTGitPathList	pathList;
+	bool			bWholeProject = true;
+	DWORD			dwCheck = 0;
+	int				ret = 0;
+	CString			err;
+	CTGitPathList	unRevFileList;
+};
+
+struct CCommitDlg::UnversionedFetchQueue
+{
+	CComAutoCriticalSection							critSec;
+	std::vector<std::unique_ptr<UnversionedFetch>>	results;
+};
+
+struct CCommitDlg::UnversionedFetchThreadData
+{
+	HWND									hNotifyWnd = nullptr;
+	std::unique_ptr<UnversionedFetch>		pFetch;
+	std::shared_ptr<UnversionedFetchQueue>	pResults;
+};
+
 IMPLEMENT_DYNAMIC(CCommitDlg, CResizableStandAloneDialog)
 CCommitDlg::CCommitDlg(CWnd* pParent /*=nullptr*/)
 	: CResizableStandAloneDialog(CCommitDlg::IDD, pParent)
@@ -67,6 +94,7 @@ CCommitDlg::CCommitDlg(CWnd* pParent /*=nullptr*/)
 	, m_bAmendDiffToLastCommit(FALSE)
 	, m_bCommitAmend(FALSE)
 {
+	m_pUnversionedFetches = std::make_shared<UnversionedFetchQueue>();
 }
 
 CCommitDlg::~CCommitDlg()
@@ -125,6 +153,7 @@ BEGIN_MESSAGE_MAP(CCommitDlg, CResizableStandAloneDialog)
 
 	ON_REGISTERED_MESSAGE(CLinkControl::LK_LINKITEMCLICKED, &CCommitDlg::OnCheck)
 	ON_REGISTERED_MESSAGE(WM_AUTOLISTREADY, OnAutoListReady)
+	ON_REGISTERED_MESSAGE(WM_UNVERSIONEDREADY, OnUnversionedReady)
 	ON_REGISTERED_MESSAGE(WM_UPDATEOKBUTTON, OnUpdateOKButton)
 	ON_REGISTERED_MESSAGE(WM_UPDATEDATAFALSE, OnUpdateDataFalse)
 	ON_REGISTERED_MESSAGE(WM_PARTIALSTAGINGREFRESHPATCHVIEW, OnPartialStagingRefreshPatchView)
@@ -565,6 +594,49 @@ static void DoPush(HWND hWnd, bool usePushDlg)
 	CAppUtils::DoPush(hWnd, CAppUtils::IsSSHPutty(), false, false, false, false, false, head, remote, remotebranch, false, 0, L"");
 }
 
+static bool IsSubmoduleDirty(const CTGitPath& submodule)
+{
+	if (submodule.m_Action & CTGitPath::LOGACTIONS_UNVER)
+	{
+		CGit subgit;
+		subgit.m_IsUseGitDLL = false;
+		subgit.m_CurrentDir = g_Git.CombinePath(submodule);
+		CString subcmdout;
+		subgit.Run(L"git.exe status --porcelain", &subcmdout, CP_UTF8);
+		return !subcmdout.IsEmpty();
+	}
+
+	// the checks run on several threads, and Run() stores the running process in the CGit object
+	CGit git;
+	git.m_IsUseGitDLL = false;
+	git.m_CurrentDir = g_Git.m_CurrentDir;
+	CString cmd, cmdout;
+	cmd.Format(L"git.exe diff -- \"%s\"", submodule.GetWinPath());
+	git.Run(cmd, &cmdout, CP_UTF8);
+	return CStringUtils::EndsWith(cmdout, L"-dirty\n");
+}
+
+// Each check starts at least one git.exe and does not depend on the others, so several of them
+// run at the same time. The result is in the order of submodules, regardless which check finished first.
+static std::vector<char> GetDirtySubmodules(const std::vector<const CTGitPath*>& submodules)
+{
+	std::vector<char> dirty(submodules.size(), false);
+	std::atomic<size_t> next = 0;
+	auto worker = [&]() {
+		for (size_t i; (i = next++) < submodules.size();)
+			dirty[i] = IsSubmoduleDirty(*submodules[i]);
+	};
+
+	const size_t workerCount = min(submodules.size(), static_cast<size_t>(std::clamp(std::thread::hardware_concurrency(), 1U, 8U)));
+	std::vector<std::thread> workers;
+	for (size_t i = 1; i < workerCount; ++i)
+		workers.emplace_back(worker);
+	worker();
+	for (auto& thread : workers)
+		thread.join();
+	return dirty;
+}
+
 void CCommitDlg::OnOK()
 {
 	if (m_bBlock)
@@ -692,31 +764,18 @@ void CCommitDlg::OnOK()
 	}
 
 	const int nListItems = m_ListCtrl.GetItemCount();
+	std::vector<const CTGitPath*> submodules;
 	for (int i = 0; i < nListItems && !m_bCommitMessageOnly; ++i)
 	{
 		auto entry = m_ListCtrl.GetListEntry(i);
-		if (!entry->m_Checked || !entry->IsDirectory())
-			continue;
-
-		bool dirty = false;
-		if (entry->m_Action & CTGitPath::LOGACTIONS_UNVER)
-		{
-			CGit subgit;
-			subgit.m_IsUseGitDLL = false;
-			subgit.m_CurrentDir = g_Git.CombinePath(entry);
-			CString subcmdout;
-			subgit.Run(L"git.exe status --porcelain", &subcmdout, CP_UTF8);
-			dirty = !subcmdout.IsEmpty();
-		}
-		else
-		{
-			CString cmd, cmdout;
-			cmd.Format(L"git.exe diff -- \"%s\"", entry->GetWinPath());
-			g_Git.Run(cmd, &cmdout, CP_UTF8);
-			dirty = CStringUtils::EndsWith(cmdout, L"-dirty\n");
-		}
-
-		if (dirty)
+		if (entry->m_Checked && entry->IsDirectory())
+			submodules.push_back(entry);
+	}
+	const auto dirtySubmodules = GetDirtySubmodules(submodules);
+	for (size_t i = 0; i < submodules.size(); ++i)
+	{
+		auto entry = submodules[i];
+		if (dirtySubmodules[i])
 		{
 			CString message;
 			message.Format(IDS_COMMITDLG_SUBMODULEDIRTY, static_cast<LPCWSTR>(entry->GetGitPathString()));
@@ -739,6 +798,8 @@ void CCommitDlg::OnOK()
 		m_ListCtrl.WriteCheckedNamesToPathList(m_selectedPathList);
 	m_pathwatcher.Stop();
 	InterlockedExchange(&m_bBlock, TRUE);
+	// the commit takes the list as it is, the unversioned files which are still searched are dropped
+	CancelUnversionedFetch();
 
 	int nchecked = 0;
 
@@ -1319,6 +1380,49 @@ UINT CCommitDlg::StatusThreadEntry(LPVOID pVoid)
 	return static_cast<CCommitDlg*>(pVoid)->StatusThread();
 }
 
+void CCommitDlg::StartUnversionedFetch(const CTGitPathList* pList, DWORD dwCheck)
+{
+	auto pFetch = std::make_unique<UnversionedFetch>();
+	pFetch->generation = InterlockedIncrement(&m_nUnversionedFetchGeneration);
+	pFetch->workingDir = g_Git.m_CurrentDir;
+	pFetch->bWholeProject = !pList;
+	if (pList)
+		pFetch->pathList = *pList;
+	pFetch->dwCheck = dwCheck;
+
+	auto pData = new UnversionedFetchThreadData;
+	pData->hNotifyWnd = GetSafeHwnd();
+	pData->pFetch = std::move(pFetch);
+	pData->pResults = m_pUnversionedFetches;
+	if (!AfxBeginThread(UnversionedFetchThreadEntry, pData, THREAD_PRIORITY_NORMAL))
+	{
+		delete pData;
+		CMessageBox::Show(GetSafeHwnd(), IDS_ERR_THREADSTARTFAILED, IDS_APPNAME, MB_OK | MB_ICONERROR);
+	}
+}
+
+UINT CCommitDlg::UnversionedFetchThreadEntry(LPVOID pVoid)
+{
+	std::unique_ptr<UnversionedFetchThreadData> pData(static_cast<UnversionedFetchThreadData*>(pVoid));
+	auto& fetch = *pData->pFetch;
+
+	// the dialog keeps using g_Git (and its process handle) in the meantime
+	CGit git;
+	git.m_IsUseGitDLL = false;
+	git.m_CurrentDir = fetch.workingDir;
+	const ULONGLONG starttime = GetTickCount64();
+	fetch.ret = CGitStatusListCtrl::FetchUnRevFileList(git, fetch.bWholeProject ? nullptr : &fetch.pathList, fetch.unRevFileList, fetch.err);
+	CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": unversioned files fetched in %I64u msec\n", GetTickCount64() - starttime);
+
+	{
+		CComCritSecLock<CComCriticalSection> lock(pData->pResults->critSec);
+		pData->pResults->results.push_back(std::move(pData->pFetch));
+	}
+	// the result stays in the queue if the dialog is gone, it is freed with the queue then
+	::PostMessage(pData->hNotifyWnd, WM_UNVERSIONEDREADY, 0, 0);
+	return 0;
+}
+
 void CCommitDlg::ReloadHistoryEntries()
 {
 	CString reg;
@@ -1371,7 +1475,7 @@ UINT CCommitDlg::StatusThread()
 	if (!m_bDoNotStoreLastSelectedLine)
 		m_ListCtrl.StoreScrollPos();
 	// Initialise the list control with the status of the files/folders below us
-	m_ListCtrl.Clear();
+	m_ListCtrl.ClearForRefresh();
 	BOOL success;
 	CTGitPathList *pList;
 	m_ListCtrl.m_amend = (m_bCommitAmend==TRUE || m_bForceCommitAmend) && (m_bAmendDiffToLastCommit==FALSE);
@@ -1383,11 +1487,14 @@ UINT CCommitDlg::StatusThread()
 	else
 		pList = &m_pathList;
 
+	ULONGLONG starttime = GetTickCount64();
 	success = m_ListCtrl.GetStatus(pList, false, false, false, false, false, m_bStagingSupport);
+	CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": versioned files fetched in %I64u msec\n", GetTickCount64() - starttime);
 
-	//m_ListCtrl.UpdateFileList(git_revnum_t(GIT_REV_ZERO));
-	if(this->m_bShowUnversioned)
-		m_ListCtrl.UpdateFileList(CGitStatusListCtrl::FILELIST_UNVER, true, pList, m_bStagingSupport);
+	// The versioned files are shown first, the unversioned files are added as soon as they are
+	// found. Until then the ones of the last refresh are kept, so that the rows do not flicker.
+	if (success && m_bShowUnversioned)
+		m_ListCtrl.KeepUnRevFileList();
 
 	m_ListCtrl.CheckIfChangelistsArePresent(false);
 
@@ -1435,10 +1542,21 @@ UINT CCommitDlg::StatusThread()
 
 	SetDlgTitle();
 
-	// we don't have to block the commit dialog while we fetch the
-	// auto completion list.
+	// the versioned files can already be committed while the unversioned ones are searched
 	m_pathwatcher.ClearChangedPaths();
 	InterlockedExchange(&m_bBlock, FALSE);
+	SendMessage(WM_UPDATEOKBUTTON);
+	UpdateCheckLinks();
+
+	if (success && m_bShowUnversioned && m_bRunThread)
+	{
+		DWORD dwCheck = m_bSelectFilesForCommit ? dwShow : 0;
+		dwCheck &= ~(CTGitPath::LOGACTIONS_UNVER);
+		StartUnversionedFetch(pList, dwCheck);
+	}
+
+	// we don't have to block the commit dialog while we fetch the
+	// auto completion list.
 	std::map<CString, int> autolist;
 	if (static_cast<DWORD>(CRegDWORD(L"Software\\TortoiseGit\\Autocompletion", TRUE)) == TRUE)
 	{
@@ -1670,6 +1788,8 @@ void CCommitDlg::StartStatusThread()
 	if (InterlockedExchange(&m_bBlock, TRUE) != FALSE)
 		return;
 
+	CancelUnversionedFetch();
+
 	delete m_pThread;
 
 	m_pThread = AfxBeginThread(StatusThreadEntry, this, THREAD_PRIORITY_NORMAL, 0, CREATE_SUSPENDED);
@@ -1705,6 +1825,7 @@ void CCommitDlg::OnBnClickedShowunversioned()
 	m_regAddBeforeCommit = m_bShowUnversioned;
 	if (!m_bBlock)
 	{
+		CancelUnversionedFetch();
 		DWORD dwShow = m_ListCtrl.GetShowFlags();
 		if (DWORD(m_regAddBeforeCommit))
 			dwShow |= GITSLC_SHOWUNVERSIONED;
@@ -1814,6 +1935,35 @@ LRESULT CCommitDlg::OnAutoListReady(WPARAM, LPARAM lparam)
 	return 0;
 }
 
+LRESULT CCommitDlg::OnUnversionedReady(WPARAM, LPARAM)
+{
+	std::unique_ptr<UnversionedFetch> pFetch;
+	{
+		CComCritSecLock<CComCriticalSection> lock(m_pUnversionedFetches->critSec);
+		for (auto& result : m_pUnversionedFetches->results)
+		{
+			if (result->generation == m_nUnversionedFetchGeneration)
+				pFetch = std::move(result);
+		}
+		m_pUnversionedFetches->results.clear();
+	}
+	// cancelled, or a new status thread or a commit is about to replace the list
+	if (!pFetch || m_bBlock)
+		return 0;
+
+	if (pFetch->ret)
+	{
+		MessageBox(L"Failed to get UnRev file list\n" + pFetch->err, L"TortoiseGit", MB_OK | MB_ICONERROR);
+		return 0;
+	}
+
+	m_ListCtrl.ShowUnRevFileList(pFetch->unRevFileList, m_ListCtrl.GetShowFlags(), pFetch->dwCheck);
+	m_tooltips.AddTool(GetDlgItem(IDC_STATISTICS), m_ListCtrl.GetStatisticsString());
+	UpdateCheckLinks();
+	OnUpdateOKButton(0, 0);
+	return 0;
+}
+
 //////////////////////////////////////////////////////////////////////////
 // functions which run in the status thread
 //////////////////////////////////////////////////////////////////////////
@@ -2760,6 +2910,7 @@ void CCommitDlg::OnBnClickedWholeProject()
 	m_ListCtrl.Clear();
 	if (!m_bBlock)
 	{
+		CancelUnversionedFetch();
 		if (m_bWholeProject || m_bWholeProject2)
 			m_ListCtrl.GetStatus(nullptr, true, false, true, false, false, m_bStagingSupport);
 		else
@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2008 - TortoiseSVN
-// Copyright (C) 2008-2023, 2025 - TortoiseGit
+// Copyright (C) 2008-2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -120,6 +120,14 @@ private:
 	void ReloadHistoryEntries();
 	static UINT StatusThreadEntry(LPVOID pVoid);
 	UINT StatusThread();
+	struct UnversionedFetch;
+	struct UnversionedFetchQueue;
+	struct UnversionedFetchThreadData;
+	/// searches the unversioned files on its own thread, which is neither waited for nor killed
+	void StartUnversionedFetch(const CTGitPathList* pList, DWORD dwCheck);
+	/// drops the result of a running search for unversioned files
+	void CancelUnversionedFetch() { InterlockedIncrement(&m_nUnversionedFetchGeneration); }
+	static UINT UnversionedFetchThreadEntry(LPVOID pVoid);
 	void FillPatchView(bool onlySetTimer = false);
 	CWnd* GetPatchViewParentWnd() override { return this; }
 	void TogglePatchView() override;
@@ -153,6 +161,7 @@ protected:
 
 	afx_msg LRESULT OnCheck(WPARAM count, LPARAM);
 	afx_msg LRESULT OnAutoListReady(WPARAM, LPARAM);
+	afx_msg LRESULT OnUnversionedReady(WPARAM, LPARAM);
 	afx_msg LRESULT OnUpdateOKButton(WPARAM, LPARAM);
 	afx_msg LRESULT OnUpdateDataFalse(WPARAM, LPARAM);
 	afx_msg LRESULT OnPartialStagingRefreshPatchView(WPARAM, LPARAM);
@@ -218,12 +227,15 @@ private:
 	volatile LONG		m_bBlock = FALSE;
 	volatile LONG		m_bThreadRunning = FALSE;
 	volatile LONG		m_bRunThread = FALSE;
+	volatile LONG		m_nUnversionedFetchGeneration = 0;
+	std::shared_ptr<UnversionedFetchQueue>	m_pUnversionedFetches;
 	CRegDWORD			m_regAddBeforeCommit;
 	CRegDWORD			m_regDoNotAutoselectSubmodules;
 	CRegDWORD			m_regShowWholeProject;
 	ProjectProperties	m_ProjectProperties;
 	CString				m_sWindowTitle;
 	static UINT			WM_AUTOLISTREADY;
+	static UINT			WM_UNVERSIONEDREADY;
 	static UINT			WM_UPDATEOKBUTTON;
 	static UINT			WM_UPDATEDATAFALSE;
 	static UINT			WM_PARTIALSTAGINGREFRESHPATCHVIEW;
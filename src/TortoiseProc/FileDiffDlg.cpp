@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2003-2008, 2018 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -329,17 +329,23 @@ UINT CFileDiffDlg::DiffThread()
 	if( m_rev1.m_CommitHash.IsEmpty() || m_rev2.m_CommitHash.IsEmpty())
 		g_Git.RefreshGitIndex();
 
+	CString rev1 = m_rev1.m_CommitHash.ToString();
 	if (m_bCommonAncestorDiff && !(m_rev1.m_CommitHash.IsEmpty() || m_rev2.m_CommitHash.IsEmpty()))
 	{
 		CGitHash commonAncestor;
 		g_Git.IsFastForward(m_rev1.m_CommitHash.ToString(), m_rev2.m_CommitHash.ToString(), &commonAncestor);
-		g_Git.GetCommitDiffList(m_rev2.m_CommitHash.ToString(), commonAncestor.ToString(), m_arFileList, m_bIgnoreSpaceAtEol, m_bIgnoreSpaceChange, m_bIgnoreAllSpace, m_bIgnoreBlankLines);
+		rev1 = commonAncestor.ToString();
 	}
-	else
-		g_Git.GetCommitDiffList(m_rev2.m_CommitHash.ToString(), m_rev1.m_CommitHash.ToString(), m_arFileList, m_bIgnoreSpaceAtEol, m_bIgnoreSpaceChange, m_bIgnoreAllSpace, m_bIgnoreBlankLines);
-	Sort();
 
-	SendMessage(WM_DIFFFINISHED);
+	// Rename detection and line statistics take most of the time on large diffs, so the changed
+	// files are shown without them first. The rows are updated as soon as the full list is there.
+	CTGitPathList fileList;
+	if (!g_Git.GetCommitDiffListQuick(m_rev2.m_CommitHash.ToString(), rev1, fileList) && !fileList.IsEmpty())
+		SendMessage(WM_DIFFFINISHED, FALSE, reinterpret_cast<LPARAM>(&fileList));
+
+	if (g_Git.GetCommitDiffList(m_rev2.m_CommitHash.ToString(), rev1, fileList, m_bIgnoreSpaceAtEol, m_bIgnoreSpaceChange, m_bIgnoreAllSpace, m_bIgnoreBlankLines))
+		fileList.Clear();
+	SendMessage(WM_DIFFFINISHED, TRUE, reinterpret_cast<LPARAM>(&fileList));
 
 	InterlockedExchange(&m_bThreadRunning, FALSE);
 	return 0;
@@ -350,13 +356,21 @@ LRESULT CFileDiffDlg::OnDisableButtons(WPARAM, LPARAM)
 	RefreshCursor();
 	m_cFileList.ShowText(CString(MAKEINTRESOURCE(IDS_FILEDIFF_WAIT)));
 	m_cFileList.DeleteAllItems();
+	m_arFilteredList.clear();
 	m_arFileList.Clear();
+	m_bDiffComplete = false;
 	EnableInputControl(false);
 	return 0;
 }
 
-LRESULT CFileDiffDlg::OnDiffFinished(WPARAM, LPARAM)
+LRESULT CFileDiffDlg::OnDiffFinished(WPARAM wParam, LPARAM lParam)
 {
+	// the rows refer to the previous entries until Filter() updated them, moving keeps them at their place
+	const CTGitPathList previousFileList(std::move(m_arFileList));
+	m_arFileList = std::move(*reinterpret_cast<CTGitPathList*>(lParam));
+	m_bDiffComplete = wParam != FALSE;
+	Sort();
+
 	CString sFilterText;
 	m_cFilter.GetWindowText(sFilterText);
 	m_cFileList.SetRedraw(false);
@@ -371,6 +385,9 @@ LRESULT CFileDiffDlg::OnDiffFinished(WPARAM, LPARAM)
 	m_cFileList.SetRedraw(true);
 
 	InvalidateRect(nullptr);
+	if (!m_bDiffComplete)
+		return 0;
+
 	RefreshCursor();
 	EnableInputControl(true);
 	FillPatchView(true);
@@ -414,13 +431,18 @@ int CFileDiffDlg::AddEntry(const CTGitPath * fd)
 
 		ret = m_cFileList.InsertItem(index, GetFilename(fd), icon_idx);
 		m_cFileList.SetItemText(index, 1, fd->GetFileExtension());
-		m_cFileList.SetItemText(index, 2, fd->GetActionName());
-		m_cFileList.SetItemText(index, 3, fd->m_StatAdd);
-		m_cFileList.SetItemText(index, 4, fd->m_StatDel);
+		UpdateEntry(index, fd);
 	}
 	return ret;
 }
 
+void CFileDiffDlg::UpdateEntry(int index, const CTGitPath* fd)
+{
+	m_cFileList.SetItemText(index, 2, fd->GetActionName());
+	m_cFileList.SetItemText(index, 3, CTGitPath::FormatStat(fd->m_StatAdd));
+	m_cFileList.SetItemText(index, 4, CTGitPath::FormatStat(fd->m_StatDel));
+}
+
 void CFileDiffDlg::EnableInputControl(bool b)
 {
 	this->m_ctrRev1Edit.EnableWindow(b);
@@ -1011,7 +1033,7 @@ void CFileDiffDlg::Sort()
 	if(m_arFileList.GetCount() < 2)
 		return;
 
-	std::sort(m_arFileList.m_paths.begin(), m_arFileList.m_paths.end(), &CFileDiffDlg::SortCompare);
+	std::sort(m_arFileList.begin(), m_arFileList.end(), &CFileDiffDlg::SortCompare);
 }
 
 bool CFileDiffDlg::SortCompare(const CTGitPath& Data1, const CTGitPath& Data2)
@@ -1030,13 +1052,13 @@ bool CFileDiffDlg::SortCompare(const CTGitPath& Data1, const CTGitPath& Data2)
 		result = Data1.m_Action - Data2.m_Action;
 		break;
 	case 3:
-		d1 = CSorter::A2L(Data1.m_StatAdd);
-		d2 = CSorter::A2L(Data2.m_StatAdd);
+		d1 = Data1.m_StatAdd;
+		d2 = Data2.m_StatAdd;
 		result = d1 - d2;
 		break;
 	case 4:
-		d1 = CSorter::A2L(Data1.m_StatDel);;
-		d2 = CSorter::A2L(Data2.m_StatDel);
+		d1 = Data1.m_StatDel;
+		d2 = Data2.m_StatDel;
 		result = d1 - d2;
 		break;
 	default:
@@ -1245,17 +1267,28 @@ void CFileDiffDlg::Filter(const CString& sFilterText)
 	m_filter = std::make_shared<CLogDlgFileFilter>(sFilterText, 0, 0, false);
 	auto filter = *m_filter.load().get();
 
-	m_arFilteredList.clear();
+	std::vector<const CTGitPath*> previousFilteredList;
+	previousFilteredList.swap(m_arFilteredList);
 	for (int i=0;i<m_arFileList.GetCount();i++)
 	{
 		if (filter(m_arFileList[i]))
 		{
 			// Git 2.29.0 or later, --numstat doesn't show stats for the files with only ignored changes. This check hides such files.
-			const bool showItem = m_arFileList[i].IsDirectory() || !(m_arFileList[i].m_StatAdd.IsEmpty() && m_arFileList[i].m_StatDel.IsEmpty());
+			const bool showItem = !m_bDiffComplete || m_arFileList[i].IsDirectory() || !(m_arFileList[i].m_StatAdd == CTGitPath::STAT_UNKNOWN && m_arFileList[i].m_StatDel == CTGitPath::STAT_UNKNOWN);
 			if (showItem)
 				m_arFilteredList.push_back(&m_arFileList[i]);
 		}
 	}
+
+	// e.g. when the line statistics arrived, mostly the same files are shown, so only their columns are updated
+	if (static_cast<int>(previousFilteredList.size()) == m_cFileList.GetItemCount() && std::equal(m_arFilteredList.cbegin(), m_arFilteredList.cend(), previousFilteredList.cbegin(), previousFilteredList.cend(), [](const CTGitPath* fd, const CTGitPath* previous) { return fd->IsDirectory() == previous->IsDirectory() && GetFilename(fd) == GetFilename(previous); }))
+	{
+		for (int i = 0; i < static_cast<int>(m_arFilteredList.size()); ++i)
+			UpdateEntry(i, m_arFilteredList[i]);
+		return;
+	}
+
+	m_cFileList.DeleteAllItems();
 	for (const auto path : m_arFilteredList)
 		AddEntry(path);
 }
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2017, 2019-2020, 2023-2025 - TortoiseGit
+// Copyright (C) 2008-2017, 2019-2020, 2023-2026 - TortoiseGit
 // Copyright (C) 2003-2008 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -92,6 +92,7 @@ protected:
 	DECLARE_MESSAGE_MAP()
 
 	int					AddEntry(const CTGitPath * fd);
+	void				UpdateEntry(int index, const CTGitPath* fd);
 	void				DoDiff(int selIndex, bool blame);
 	void				SetURLLabels(int mask=0x3);
 	void				ClearURLabels(int mask);
@@ -152,6 +153,7 @@ private:
 	bool				m_bBlame = false;
 	CTGitPathList		m_arFileList;
 	std::vector<const CTGitPath*> m_arFilteredList;
+	bool				m_bDiffComplete = false;	///< false while m_arFileList lacks renames and line statistics, cf. DiffThread()
 
 	CString				m_strExportDir;
 
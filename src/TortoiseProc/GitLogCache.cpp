@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2019, 2023-2025 - TortoiseGit
+// Copyright (C) 2008-2019, 2023-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -257,7 +257,6 @@ int CLogCache::SaveOneItem(const GitRevLoglist& Rev, LARGE_INTEGER offset)
 	if (!WriteFile(this->m_DataFile, &header, sizeof(header), &dwWritten, 0))
 		return -1;
 
-	CString stat;
 	CString name,oldname;
 	for (int i = 0; i < Rev.m_Files.GetCount(); ++i)
 	{
@@ -271,10 +270,10 @@ int CLogCache::SaveOneItem(const GitRevLoglist& Rev, LARGE_INTEGER offset)
 		oldname = Rev.m_Files[i].GetGitOldPathString();
 		revfileheader.m_OldFileNameSize = oldname.GetLength();
 
-		stat = Rev.m_Files[i].m_StatAdd;
-		revfileheader.m_Add = (stat == L"-") ? 0xFFFFFFFF : _wtol(stat);
-		stat = Rev.m_Files[i].m_StatDel;
-		revfileheader.m_Del = (stat == L"-") ? 0xFFFFFFFF : _wtol(stat);
+		const int statAdd = Rev.m_Files[i].m_StatAdd;
+		revfileheader.m_Add = (statAdd == CTGitPath::STAT_BINARY) ? 0xFFFFFFFF : max(statAdd, 0);
+		const int statDel = Rev.m_Files[i].m_StatDel;
+		revfileheader.m_Del = (statDel == CTGitPath::STAT_BINARY) ? 0xFFFFFFFF : max(statDel, 0);
 
 		if (!WriteFile(this->m_DataFile, &revfileheader, sizeof(revfileheader) - sizeof(wchar_t), &dwWritten, 0))
 			return -1;
@@ -311,6 +310,7 @@ int CLogCache::LoadOneItem(GitRevLoglist& Rev, ULONGLONG ullOffset)
 		return -2;
 
 	Rev.m_Action = 0;
+	Rev.m_LineStat = {};
 
 	for (DWORD i = 0; i < header->m_FileCount; ++i)
 	{
@@ -319,6 +319,7 @@ int CLogCache::LoadOneItem(GitRevLoglist& Rev, ULONGLONG ullOffset)
 		{
 			Rev.m_Action = 0;
 			Rev.m_Files.Clear();
+			Rev.m_LineStat = {};
 			return -2;
 		}
 
@@ -326,6 +327,7 @@ int CLogCache::LoadOneItem(GitRevLoglist& Rev, ULONGLONG ullOffset)
 		{
 			Rev.m_Action = 0;
 			Rev.m_Files.Clear();
+			Rev.m_LineStat = {};
 			return -2;
 		}
 
@@ -336,6 +338,7 @@ int CLogCache::LoadOneItem(GitRevLoglist& Rev, ULONGLONG ullOffset)
 		{
 			Rev.m_Action = 0;
 			Rev.m_Files.Clear();
+			Rev.m_LineStat = {};
 			return -2;
 		}
 
@@ -351,16 +354,13 @@ int CLogCache::LoadOneItem(GitRevLoglist& Rev, ULONGLONG ullOffset)
 		path.m_Action = fileheader->m_Action & ~(CTGitPath::LOGACTIONS_HIDE | CTGitPath::LOGACTIONS_GRAY);
 		Rev.m_Action |= path.m_Action;
 
-		if(fileheader->m_Add == 0xFFFFFFFF)
-			path.m_StatAdd = L"-";
-		else
-			path.m_StatAdd.Format(L"%d", fileheader->m_Add);
+		path.m_StatAdd = fileheader->m_Add == 0xFFFFFFFF ? CTGitPath::STAT_BINARY : static_cast<int>(fileheader->m_Add);
+		path.m_StatDel = fileheader->m_Del == 0xFFFFFFFF ? CTGitPath::STAT_BINARY : static_cast<int>(fileheader->m_Del);
 
-		if(fileheader->m_Del == 0xFFFFFFFF)
-			path.m_StatDel = L"-";
-		else
-			path.m_StatDel.Format(L"%d", fileheader->m_Del);
+		// binary files are stored as 0xFFFFFFFF
+		Rev.m_LineStat.Add(path.m_Action, fileheader->m_Add == 0xFFFFFFFF ? 0 : static_cast<int>(fileheader->m_Add), fileheader->m_Del == 0xFFFFFFFF ? 0 : static_cast<int>(fileheader->m_Del));
 
+		path.InternPaths();
 		Rev.m_Files.AddPath(path);
 	}
 	return 0;
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 // Copyright (C) 2005-2007 Marco Costalba
 
 // This program is free software; you can redistribute it and/or
@@ -31,6 +31,7 @@
 #include "CommonAppUtils.h"
 #include "DPIAware.h"
 #include <regex>
+#include <thread>
 
 const UINT CGitLogListBase::m_FindDialogMessage = RegisterWindowMessage(FINDMSGSTRING);
 const UINT CGitLogListBase::m_ScrollToMessage = RegisterWindowMessage(L"TORTOISEGIT_LOG_SCROLLTO");
@@ -110,7 +111,7 @@ CGitLogListBase::CGitLogListBase() : CHintCtrl<CResizableColumnsListCtrl<CListCt
 	m_LineWidth = max(1, static_cast<int>(CRegDWORD(L"Software\\TortoiseGit\\TortoiseProc\\Graph\\LogLineWidth", 2)));
 	m_NodeSize = max(1, static_cast<int>(CRegDWORD(L"Software\\TortoiseGit\\TortoiseProc\\Graph\\LogNodeSize", 10)));
 
-	m_AsyncDiffEvent = ::CreateEvent(nullptr, FALSE, TRUE, nullptr);
+	m_AsyncDiffEvent = ::CreateEvent(nullptr, TRUE, TRUE, nullptr);
 	StartAsyncDiffThread();
 }
 
@@ -133,14 +134,20 @@ int CGitLogListBase::AsyncDiffThread()
 			GitRevLoglist* pRev;
 			{
 				Locker lock(m_AsynDiffListLock);
-				if (m_AsynDiffList.empty())
+				// rows which are drawn or selected right now come first
+				auto& list = m_AsynDiffList.empty() ? m_PrefetchDiffList : m_AsynDiffList;
+				if (list.empty())
+				{
+					::ResetEvent(m_AsyncDiffEvent);
 					break;
-				pRev = m_AsynDiffList.back();
-				m_AsynDiffList.pop_back();
-			}
+				}
+				pRev = list.back();
+				list.pop_back();
 
-			if (pRev->m_IsDiffFiles)
-				continue;
+				// another thread might already be working on it
+				if (pRev->m_IsDiffFiles || !m_AsyncDiffInProgress.insert(pRev).second)
+					continue;
+			}
 
 			if( pRev->m_CommitHash.IsEmpty() )
 			{
@@ -159,15 +166,20 @@ int CGitLogListBase::AsyncDiffThread()
 				if (CString err; pRev->GetUnRevFiles().FillUnRev(CTGitPath::LOGACTIONS_UNVER, nullptr, &err))
 				{
 					::MessageBox(nullptr, L"Failed to get UnRev file list\n" + err, L"TortoiseGit", MB_OK | MB_ICONERROR);
-					InterlockedExchange(&m_AsyncThreadRunning, FALSE);
+					Locker lock(m_AsynDiffListLock);
+					m_AsyncDiffInProgress.erase(pRev);
 					return -1;
 				}
 
 				InterlockedExchange(&pRev->m_IsDiffFiles, TRUE);
+				{
+					Locker lock(m_AsynDiffListLock);
+					m_AsyncDiffInProgress.erase(pRev);
+				}
 
 				CString body = L"\n";
 				body.AppendFormat(IDS_FILESCHANGES, files.GetCount());
-				pRev->GetBody() = body;
+				pRev->SetBody(body);
 				::PostMessage(m_hWnd, MSG_LOADED, 0, 0);
 				if (const auto selectedHash = m_lastSelectedHash.load(); m_nCacheSelectedItem == 0 && selectedHash.IsEmpty())
 					this->GetParent()->PostMessage(WM_COMMAND, MSG_FETCHED_DIFF, 0);
@@ -175,6 +187,10 @@ int CGitLogListBase::AsyncDiffThread()
 			}
 
 			pRev->CheckAndDiff();
+			{
+				Locker lock(m_AsynDiffListLock);
+				m_AsyncDiffInProgress.erase(pRev);
+			}
 			{
 				const int start = m_nCacheTopIndex;
 				const int end = start + m_nCacheItemsPerPage;
@@ -200,9 +216,42 @@ int CGitLogListBase::AsyncDiffThread()
 			}
 		}
 	}
-	InterlockedExchange(&m_AsyncThreadRunning, FALSE);
 	return 0;
 }
+
+void CGitLogListBase::PrefetchDiffs()
+{
+	const int top = GetTopIndex();
+	const size_t shownCount = m_arShownList.size();
+	if (top == m_PrefetchTopIndex && shownCount == m_PrefetchShownCount)
+		return;
+	m_PrefetchTopIndex = top;
+	m_PrefetchShownCount = shownCount;
+
+	std::vector<GitRevLoglist*> prefetch;
+	auto addRow = [&](int index) {
+		auto pRev = m_arShownList.SafeGetAt(index);
+		if (!pRev)
+			return false;
+		// the working tree changes are only fetched on request
+		if (!pRev->m_IsDiffFiles && !pRev->m_CommitHash.IsEmpty() && !IsCached(pRev))
+			prefetch.push_back(pRev);
+		return true;
+	};
+	// the visible rows first, then the next page and the previous page
+	const int perPage = max(1, GetCountPerPage());
+	for (int i = top; i <= top + 2 * perPage && addRow(i); ++i)
+		;
+	for (int i = top - 1; i >= 0 && i >= top - perPage && addRow(i); --i)
+		;
+	std::reverse(prefetch.begin(), prefetch.end());
+
+	// rows which were scrolled away are not needed any more
+	Locker lock(m_AsynDiffListLock);
+	m_PrefetchDiffList.swap(prefetch);
+	if (!m_PrefetchDiffList.empty())
+		::SetEvent(m_AsyncDiffEvent);
+}
 void CGitLogListBase::hideFromContextMenu(unsigned __int64 hideMask, bool exclusivelyShow)
 {
 	if (exclusivelyShow)
@@ -1055,7 +1104,7 @@ void CGitLogListBase::DrawGraph(HDC hdc,CRect &rect,INT_PTR index)
 	const int maxWidth = rect.Width();
 	const int lw = 3 * rect.Height() / 4; // laneWidth()
 
-	COLORREF activeColor = CTheme::Instance().GetThemeColor(m_Colors.GetColor((CColors::Colors)(CColors::BranchLine1 + (activeLane % Lanes::COLORS_NUM))), true);
+	COLORREF activeColor = GetLaneColor(activeLane);
 
 	for (unsigned int i = 0; i < laneNum && x2 < maxWidth; ++i)
 	{
@@ -1066,7 +1115,7 @@ void CGitLogListBase::DrawGraph(HDC hdc,CRect &rect,INT_PTR index)
 		if (ln == Lanes::LaneType::EMPTY)
 			continue;
 
-		COLORREF color = i == activeLane ? activeColor : CTheme::Instance().GetThemeColor(m_Colors.GetColor((CColors::Colors)(CColors::BranchLine1 + (i % Lanes::COLORS_NUM))), true);
+		COLORREF color = i == activeLane ? activeColor : GetLaneColor(i);
 		paintGraphLane(hdc, rect.Height(), ln, data->m_RolledUp, x1 + rect.left, x2 + rect.left, color,activeColor, rect.top);
 	}
 
@@ -1093,6 +1142,187 @@ void CGitLogListBase::DrawGraph(HDC hdc,CRect &rect,INT_PTR index)
 #endif
 }
 
+const std::vector<CGitLogListBase::REFLABEL>& CGitLogListBase::GetRefLabels(const GitRevLoglist* data, const MAP_HASH_NAME& hashMap)
+{
+	if (auto it = m_RenderCache.refLabels.find(data->m_CommitHash); it != m_RenderCache.refLabels.cend())
+		return it->second;
+
+	std::vector<REFLABEL>& refsToShow = m_RenderCache.refLabels[data->m_CommitHash];
+	STRING_VECTOR remoteTrackingList;
+	std::vector<CString>::const_iterator refListIt;
+	std::vector<CString>::const_iterator refListItEnd;
+	auto commitRefsIt = hashMap.find(data->m_CommitHash);
+	if (commitRefsIt != hashMap.cend())
+	{
+		refListIt = (*commitRefsIt).second.cbegin();
+		refListItEnd = (*commitRefsIt).second.cend();
+	}
+	for (; refListIt != refListItEnd; ++refListIt)
+	{
+		REFLABEL refLabel;
+		refLabel.color = RGB(255, 255, 255);
+		refLabel.singleRemote = false;
+		refLabel.hasTracking = false;
+		refLabel.sameName = false;
+		refLabel.name = CGit::GetShortName(*refListIt, &refLabel.refType);
+		refLabel.fullName = *refListIt;
+
+		switch (refLabel.refType)
+		{
+		case CGit::REF_TYPE::LOCAL_BRANCH:
+		{
+			if (!(m_ShowRefMask & LOGLIST_SHOWLOCALBRANCHES))
+				continue;
+			if (refLabel.name == m_CurrentBranch)
+				refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::CurrentBranch), true);
+			else
+				refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::LocalBranch), true);
+
+			std::pair<CString, CString> trackingEntry = m_TrackingMap[refLabel.name];
+			CString pullRemote = trackingEntry.first;
+			CString pullBranch = trackingEntry.second;
+			if (!pullRemote.IsEmpty() && !pullBranch.IsEmpty())
+			{
+				CString defaultUpstream;
+				defaultUpstream.Format(L"refs/remotes/%s/%s", static_cast<LPCWSTR>(pullRemote), static_cast<LPCWSTR>(pullBranch));
+				refLabel.hasTracking = true;
+				if (m_ShowRefMask & LOGLIST_SHOWREMOTEBRANCHES)
+				{
+					bool found = false;
+					for (auto it2 = refListIt + 1; it2 != refListItEnd; ++it2)
+					{
+						if (*it2 == defaultUpstream)
+						{
+							found = true;
+							break;
+						}
+					}
+
+					if (found)
+					{
+						const bool sameName = pullBranch == refLabel.name;
+						refsToShow.push_back(refLabel);
+						CGit::GetShortName(defaultUpstream, refLabel.name, L"refs/remotes/");
+						refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::RemoteBranch), true);
+						if (m_bSymbolizeRefNames)
+						{
+							if (!m_SingleRemote.IsEmpty() && m_SingleRemote == pullRemote)
+							{
+								refLabel.simplifiedName = L'/';
+								if (sameName)
+									refLabel.simplifiedName += L'≡';
+								else
+									refLabel.simplifiedName += pullBranch;
+								refLabel.singleRemote = true;
+							}
+							else if (sameName)
+								refLabel.simplifiedName = pullRemote + L"/≡";
+							refLabel.sameName = sameName;
+						}
+						refLabel.fullName = defaultUpstream;
+						refsToShow.push_back(refLabel);
+						remoteTrackingList.push_back(defaultUpstream);
+						continue;
+					}
+				}
+			}
+			break;
+		}
+		case CGit::REF_TYPE::REMOTE_BRANCH:
+		{
+			if (!(m_ShowRefMask & LOGLIST_SHOWREMOTEBRANCHES))
+				continue;
+			bool found = false;
+			for (size_t j = 0; j < remoteTrackingList.size(); ++j)
+			{
+				if (remoteTrackingList[j] == *refListIt)
+				{
+					found = true;
+					break;
+				}
+			}
+			if (found)
+				continue;
+
+			refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::RemoteBranch), true);
+			if (m_bSymbolizeRefNames)
+			{
+				if (!m_SingleRemote.IsEmpty() && CStringUtils::StartsWith(refLabel.name, m_SingleRemote + L"/"))
+				{
+					refLabel.simplifiedName = L'/' + refLabel.name.Mid(m_SingleRemote.GetLength() + 1);
+					refLabel.singleRemote = true;
+				}
+			}
+			break;
+		}
+		case CGit::REF_TYPE::ANNOTATED_TAG:
+			[[fallthrough]];
+		case CGit::REF_TYPE::TAG:
+			if (!(m_ShowRefMask & LOGLIST_SHOWTAGS))
+				continue;
+			refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::Tag), true);
+			break;
+
+		case CGit::REF_TYPE::STASH:
+			if (!(m_ShowRefMask & LOGLIST_SHOWSTASH))
+				continue;
+			refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::Stash), true);
+			break;
+
+		case CGit::REF_TYPE::BISECT_GOOD:
+			[[fallthrough]];
+		case CGit::REF_TYPE::BISECT_BAD:
+			[[fallthrough]];
+		case CGit::REF_TYPE::BISECT_SKIP:
+			if (!(m_ShowRefMask & LOGLIST_SHOWBISECT))
+				continue;
+			refLabel.color = CTheme::Instance().GetThemeColor((refLabel.refType == CGit::REF_TYPE::BISECT_GOOD) ? m_Colors.GetColor(CColors::BisectGood) : ((refLabel.refType == CGit::REF_TYPE::BISECT_SKIP) ? m_Colors.GetColor(CColors::BisectSkip) : m_Colors.GetColor(CColors::BisectBad)), true);
+			break;
+
+		case CGit::REF_TYPE::NOTES:
+			if (!(m_ShowRefMask & LOGLIST_SHOWOTHERREFS))
+				continue;
+			refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::NoteNode), true);
+			break;
+
+		default:
+			if (!(m_ShowRefMask & LOGLIST_SHOWOTHERREFS))
+				continue;
+			refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::OtherRef), true);
+			break;
+		}
+		refsToShow.push_back(refLabel);
+	}
+
+	const auto fnAddSuperProjectHash = [&](const CGitHash& hash, const CString& label) {
+		if (hash.IsEmpty() || data->m_CommitHash != hash)
+			return;
+
+		REFLABEL refLabel;
+		refLabel.color = CTheme::Instance().GetThemeColor(RGB(246, 153, 253), true);
+		refLabel.singleRemote = false;
+		refLabel.hasTracking = false;
+		refLabel.sameName = false;
+		refLabel.name = label;
+		refsToShow.push_back(refLabel);
+	};
+	fnAddSuperProjectHash(m_submoduleInfo.superProjectHash, L"super-project-pointer");
+	fnAddSuperProjectHash(m_submoduleInfo.mergeconflictMineHash, m_submoduleInfo.mineLabel);
+	fnAddSuperProjectHash(m_submoduleInfo.mergeconflictTheirsHash, m_submoduleInfo.theirsLabel);
+
+	return refsToShow;
+}
+
+COLORREF CGitLogListBase::GetLaneColor(size_t lane)
+{
+	if (m_RenderCache.laneColors.empty())
+	{
+		for (int i = 0; i < Lanes::COLORS_NUM; ++i)
+			m_RenderCache.laneColors.push_back(CTheme::Instance().GetThemeColor(m_Colors.GetColor(static_cast<CColors::Colors>(CColors::BranchLine1 + i)), true));
+	}
+	return m_RenderCache.laneColors[lane % Lanes::COLORS_NUM];
+}
+
 void CGitLogListBase::OnNMCustomdrawLoglist(NMHDR *pNMHDR, LRESULT *pResult)
 {
 	NMLVCUSTOMDRAW* pLVCD = reinterpret_cast<NMLVCUSTOMDRAW*>( pNMHDR );
@@ -1106,10 +1336,37 @@ void CGitLogListBase::OnNMCustomdrawLoglist(NMHDR *pNMHDR, LRESULT *pResult)
 	{
 	case CDDS_PREPAINT:
 		{
+			// the cache is only touched here on the UI thread, InvalidateRenderCache() might be called by the loading thread
+			PrefetchDiffs();
+
+			if (const unsigned int generation = m_RenderCacheGeneration; m_RenderCache.generation != generation || m_RenderCache.refLabels.size() > RENDERCACHE_MAX_ROWS || m_RenderCache.matchRanges.size() > RENDERCACHE_MAX_ROWS)
+			{
+				m_RenderCache = {};
+				m_RenderCache.generation = generation;
+			}
+#ifdef _DEBUG
+			QueryPerformanceCounter(&m_FrameTime.start);
+			*pResult = CDRF_NOTIFYITEMDRAW | CDRF_NOTIFYPOSTPAINT;
+#else
 			*pResult = CDRF_NOTIFYITEMDRAW;
+#endif
+			return;
+		}
+		break;
+#ifdef _DEBUG
+	case CDDS_POSTPAINT:
+		{
+			LARGE_INTEGER end, frequency;
+			QueryPerformanceCounter(&end);
+			QueryPerformanceFrequency(&frequency);
+			m_FrameTime.lastMs = 1000.0 * static_cast<double>(end.QuadPart - m_FrameTime.start.QuadPart) / static_cast<double>(frequency.QuadPart);
+			m_FrameTime.totalMs += m_FrameTime.lastMs;
+			++m_FrameTime.frames;
+			TRACE(L"log list frame: %.2f ms (average %.2f ms over %llu frames)\n", m_FrameTime.lastMs, m_FrameTime.totalMs / m_FrameTime.frames, m_FrameTime.frames);
 			return;
 		}
 		break;
+#endif
 	case CDDS_ITEMPREPAINT:
 		{
 			// This is the prepaint stage for an item. Here's where we set the
@@ -1220,168 +1477,7 @@ void CGitLogListBase::OnNMCustomdrawLoglist(NMHDR *pNMHDR, LRESULT *pResult)
 
 					FillBackGround(pLVCD->nmcd.hdc, pLVCD->nmcd.dwItemSpec, rect);
 
-					std::vector<REFLABEL> refsToShow;
-					STRING_VECTOR remoteTrackingList;
-					std::vector<CString>::const_iterator refListIt;
-					std::vector<CString>::const_iterator refListItEnd;
-					auto commitRefsIt = hashMap.find(data->m_CommitHash);
-					if (commitRefsIt != hashMap.cend())
-					{
-						refListIt = (*commitRefsIt).second.cbegin();
-						refListItEnd = (*commitRefsIt).second.cend();
-					}
-					for (; refListIt != refListItEnd; ++refListIt)
-					{
-						REFLABEL refLabel;
-						refLabel.color = RGB(255, 255, 255);
-						refLabel.singleRemote = false;
-						refLabel.hasTracking = false;
-						refLabel.sameName = false;
-						refLabel.name = CGit::GetShortName(*refListIt, &refLabel.refType);
-						refLabel.fullName = *refListIt;
-
-						switch (refLabel.refType)
-						{
-						case CGit::REF_TYPE::LOCAL_BRANCH:
-						{
-							if (!(m_ShowRefMask & LOGLIST_SHOWLOCALBRANCHES))
-								continue;
-							if (refLabel.name == m_CurrentBranch)
-								refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::CurrentBranch), true);
-							else
-								refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::LocalBranch), true);
-
-							std::pair<CString, CString> trackingEntry = m_TrackingMap[refLabel.name];
-							CString pullRemote = trackingEntry.first;
-							CString pullBranch = trackingEntry.second;
-							if (!pullRemote.IsEmpty() && !pullBranch.IsEmpty())
-							{
-								CString defaultUpstream;
-								defaultUpstream.Format(L"refs/remotes/%s/%s", static_cast<LPCWSTR>(pullRemote), static_cast<LPCWSTR>(pullBranch));
-								refLabel.hasTracking = true;
-								if (m_ShowRefMask & LOGLIST_SHOWREMOTEBRANCHES)
-								{
-									bool found = false;
-									for (auto it2 = refListIt + 1; it2 != refListItEnd; ++it2)
-									{
-										if (*it2 == defaultUpstream)
-										{
-											found = true;
-											break;
-										}
-									}
-
-									if (found)
-									{
-										const bool sameName = pullBranch == refLabel.name;
-										refsToShow.push_back(refLabel);
-										CGit::GetShortName(defaultUpstream, refLabel.name, L"refs/remotes/");
-										refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::RemoteBranch), true);
-										if (m_bSymbolizeRefNames)
-										{
-											if (!m_SingleRemote.IsEmpty() && m_SingleRemote == pullRemote)
-											{
-												refLabel.simplifiedName = L'/';
-												if (sameName)
-													refLabel.simplifiedName += L'≡';
-												else
-													refLabel.simplifiedName += pullBranch;
-												refLabel.singleRemote = true;
-											}
-											else if (sameName)
-												refLabel.simplifiedName = pullRemote + L"/≡";
-											refLabel.sameName = sameName;
-										}
-										refLabel.fullName = defaultUpstream;
-										refsToShow.push_back(refLabel);
-										remoteTrackingList.push_back(defaultUpstream);
-										continue;
-									}
-								}
-							}
-							break;
-						}
-						case CGit::REF_TYPE::REMOTE_BRANCH:
-						{
-							if (!(m_ShowRefMask & LOGLIST_SHOWREMOTEBRANCHES))
-								continue;
-							bool found = false;
-							for (size_t j = 0; j < remoteTrackingList.size(); ++j)
-							{
-								if (remoteTrackingList[j] == *refListIt)
-								{
-									found = true;
-									break;
-								}
-							}
-							if (found)
-								continue;
-
-							refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::RemoteBranch), true);
-							if (m_bSymbolizeRefNames)
-							{
-								if (!m_SingleRemote.IsEmpty() && CStringUtils::StartsWith(refLabel.name, m_SingleRemote + L"/"))
-								{
-									refLabel.simplifiedName = L'/' + refLabel.name.Mid(m_SingleRemote.GetLength() + 1);
-									refLabel.singleRemote = true;
-								}
-							}
-							break;
-						}
-						case CGit::REF_TYPE::ANNOTATED_TAG:
-							[[fallthrough]];
-						case CGit::REF_TYPE::TAG:
-							if (!(m_ShowRefMask & LOGLIST_SHOWTAGS))
-								continue;
-							refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::Tag), true);
-							break;
-
-						case CGit::REF_TYPE::STASH:
-							if (!(m_ShowRefMask & LOGLIST_SHOWSTASH))
-								continue;
-							refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::Stash), true);
-							break;
-
-						case CGit::REF_TYPE::BISECT_GOOD:
-							[[fallthrough]];
-						case CGit::REF_TYPE::BISECT_BAD:
-							[[fallthrough]];
-						case CGit::REF_TYPE::BISECT_SKIP:
-							if (!(m_ShowRefMask & LOGLIST_SHOWBISECT))
-								continue;
-							refLabel.color = CTheme::Instance().GetThemeColor((refLabel.refType == CGit::REF_TYPE::BISECT_GOOD) ? m_Colors.GetColor(CColors::BisectGood) : ((refLabel.refType == CGit::REF_TYPE::BISECT_SKIP) ? m_Colors.GetColor(CColors::BisectSkip) : m_Colors.GetColor(CColors::BisectBad)), true);
-							break;
-
-						case CGit::REF_TYPE::NOTES:
-							if (!(m_ShowRefMask & LOGLIST_SHOWOTHERREFS))
-								continue;
-							refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::NoteNode), true);
-							break;
-
-						default:
-							if (!(m_ShowRefMask & LOGLIST_SHOWOTHERREFS))
-								continue;
-							refLabel.color = CTheme::Instance().GetThemeColor(m_Colors.GetColor(CColors::OtherRef), true);
-							break;
-						}
-						refsToShow.push_back(refLabel);
-					}
-
-					const auto fnAddSuperProjectHash = [&](const CGitHash& hash, const CString& label) {
-						if (hash.IsEmpty() || data->m_CommitHash != hash)
-							return;
-
-						REFLABEL refLabel;
-						refLabel.color = CTheme::Instance().GetThemeColor(RGB(246, 153, 253), true);
-						refLabel.singleRemote = false;
-						refLabel.hasTracking = false;
-						refLabel.sameName = false;
-						refLabel.name = label;
-						refsToShow.push_back(refLabel);
-					};
-					fnAddSuperProjectHash(m_submoduleInfo.superProjectHash, L"super-project-pointer");
-					fnAddSuperProjectHash(m_submoduleInfo.mergeconflictMineHash, m_submoduleInfo.mineLabel);
-					fnAddSuperProjectHash(m_submoduleInfo.mergeconflictTheirsHash, m_submoduleInfo.theirsLabel);
+					const auto& refsToShow = GetRefLabels(data, hashMap);
 
 					if (refsToShow.empty())
 					{
@@ -3207,7 +3303,9 @@ void CGitLogListBase::Refresh(BOOL IsCleanFilter)
 		SafeTerminateAsyncDiffThread();
 		m_AsynDiffListLock.Lock();
 		m_AsynDiffList.clear();
+		m_PrefetchDiffList.clear();
 		m_AsynDiffListLock.Unlock();
+		m_PrefetchTopIndex = -1;
 		StartAsyncDiffThread();
 
 		StartLoadingThread();
@@ -3220,15 +3318,24 @@ void CGitLogListBase::StartAsyncDiffThread()
 		return;
 	if (InterlockedExchange(&m_AsyncThreadRunning, TRUE) != FALSE)
 		return;
-	m_DiffingThread = AfxBeginThread(AsyncThread, this, THREAD_PRIORITY_BELOW_NORMAL, 0, CREATE_SUSPENDED);
-	if (!m_DiffingThread)
+	// libgit2 diffs run in parallel on their own repositories, gitdll serializes all calls on m_critGitDllSec
+	const unsigned int threadCount = g_Git.UsingLibGit2(CGit::GIT_CMD_LOGLISTDIFF) ? std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U) : 1U;
+	for (unsigned int i = 0; i < threadCount; ++i)
 	{
-		InterlockedExchange(&m_AsyncThreadRunning, FALSE);
-		CMessageBox::Show(GetSafeHwnd(), IDS_ERR_THREADSTARTFAILED, IDS_APPNAME, MB_OK | MB_ICONERROR);
-		return;
+		CWinThread* thread = AfxBeginThread(AsyncThread, this, THREAD_PRIORITY_BELOW_NORMAL, 0, CREATE_SUSPENDED);
+		if (!thread)
+		{
+			if (!m_DiffingThreads.empty())
+				break;
+			InterlockedExchange(&m_AsyncThreadRunning, FALSE);
+			CMessageBox::Show(GetSafeHwnd(), IDS_ERR_THREADSTARTFAILED, IDS_APPNAME, MB_OK | MB_ICONERROR);
+			return;
+		}
+		thread->m_bAutoDelete = FALSE;
+		m_DiffingThreads.push_back(thread);
 	}
-	m_DiffingThread->m_bAutoDelete = FALSE;
-	m_DiffingThread->ResumeThread();
+	for (auto thread : m_DiffingThreads)
+		thread->ResumeThread();
 }
 
 void CGitLogListBase::StartLoadingThread()
@@ -4105,7 +4212,29 @@ bool CGitLogListBase::DrawListItemWithMatchesIfEnabled(std::shared_ptr<CLogDlgFi
 
 		FillBackGround(pLVCD->nmcd.hdc, pLVCD->nmcd.dwItemSpec, rect);
 
-		*pResult = DrawListItemWithMatches(filter.get(), *this, pLVCD, m_Colors);
+		CString text = static_cast<LPCWSTR>(GetItemText(static_cast<int>(pLVCD->nmcd.dwItemSpec), pLVCD->iSubItem));
+		if (text.IsEmpty())
+		{
+			*pResult = CDRF_DODEFAULT;
+			return true;
+		}
+
+		// matching (e.g. a regex) is much more expensive than drawing, so the ranges are kept until the filter changes
+		if (m_RenderCache.filter != filter)
+		{
+			m_RenderCache.filter = filter;
+			m_RenderCache.matchRanges.clear();
+		}
+		const GitRevLoglist* data = m_arShownList.SafeGetAt(pLVCD->nmcd.dwItemSpec);
+		auto& [cachedText, ranges] = m_RenderCache.matchRanges[{ data ? data->m_CommitHash : CGitHash(), pLVCD->iSubItem }];
+		if (cachedText != text || cachedText.IsEmpty())
+		{
+			cachedText = text;
+			ranges.clear();
+			filter->GetMatchRanges(ranges, text, 0);
+		}
+
+		*pResult = DrawListItemWithMatches(ranges, text, *this, pLVCD, m_Colors);
 		return true;
 	}
 	return false;
@@ -4119,6 +4248,11 @@ LRESULT CGitLogListBase::DrawListItemWithMatches(CFilterHelper* filter, CListCtr
 
 	std::vector<CHARRANGE> ranges;
 	filter->GetMatchRanges(ranges, text, 0);
+	return DrawListItemWithMatches(ranges, text, listCtrl, pLVCD, colors);
+}
+
+LRESULT CGitLogListBase::DrawListItemWithMatches(const std::vector<CHARRANGE>& ranges, const CString& text, CListCtrl& listCtrl, NMLVCUSTOMDRAW* pLVCD, CColors& colors)
+{
 	if (ranges.empty())
 		return CDRF_DODEFAULT;
 
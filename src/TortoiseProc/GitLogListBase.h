@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -246,8 +246,9 @@ public:
 		m_wcRev.Clear();
 		m_wcRev.GetSubject().LoadString(IDS_LOG_WORKINGDIRCHANGES);
 		m_wcRev.m_Mark = L'-';
-		m_wcRev.GetBody().LoadString(IDS_LOG_FETCHINGSTATUS);
-		m_wcRev.GetBody() = L'\n' + m_wcRev.GetBody();
+		CString body;
+		body.LoadString(IDS_LOG_FETCHINGSTATUS);
+		m_wcRev.SetBody(L'\n' + body);
 		m_wcRev.m_CallDiffAsync = DiffAsync;
 		InterlockedExchange(&m_wcRev.m_IsDiffFiles, FALSE);
 		if (refresh && m_bShowWC)
@@ -506,6 +507,8 @@ protected:
 		FetchTrackingBranchList();
 
 		g_Git.GetSubmodulePointer(m_submoduleInfo);
+
+		InvalidateRenderCache();
 	}
 	void StartAsyncDiffThread();
 	void StartLoadingThread();
@@ -568,6 +571,36 @@ protected:
 		CGit::REF_TYPE refType = CGit::REF_TYPE::UNKNOWN;
 	};
 
+	/// data for drawing rows which only changes together with the refs, the display options or the filter, cf. InvalidateRenderCache()
+	struct RowRenderCache
+	{
+		unsigned int	generation = 0;
+		std::unordered_map<CGitHash, std::vector<REFLABEL>>	refLabels;
+		std::vector<COLORREF>	laneColors;
+		std::shared_ptr<CLogDlgFilter>	filter;	// the match ranges belong to this filter
+		std::map<std::pair<CGitHash, int>, std::pair<CString, std::vector<CHARRANGE>>>	matchRanges; // (commit, column) vs. (text, ranges)
+	};
+	static constexpr size_t RENDERCACHE_MAX_ROWS = 10000;
+	RowRenderCache		m_RenderCache;
+	std::atomic<unsigned int>	m_RenderCacheGeneration = 0;
+#ifdef _DEBUG
+	struct
+	{
+		LARGE_INTEGER	start{};
+		double			lastMs = 0;
+		double			totalMs = 0;
+		ULONGLONG		frames = 0;
+	} m_FrameTime;
+#endif
+	const std::vector<REFLABEL>& GetRefLabels(const GitRevLoglist* data, const MAP_HASH_NAME& hashMap);
+	COLORREF GetLaneColor(size_t lane);
+
+public:
+	/// has to be called if something changes which is cached for drawing the rows (e.g. the shown refs or the colors)
+	void InvalidateRenderCache() { ++m_RenderCacheGeneration; }
+
+protected:
+
 	DECLARE_MESSAGE_MAP()
 	afx_msg void OnDestroy();
 	virtual afx_msg void OnNMCustomdrawLoglist(NMHDR* pNMHDR, LRESULT* pResult);
@@ -616,6 +649,7 @@ protected:
 public:
 	// needs to be called from LogDlg.cpp and FileDiffDlg.cpp
 	static LRESULT DrawListItemWithMatches(CFilterHelper* filter, CListCtrl& listCtrl, NMLVCUSTOMDRAW* pLVCD, CColors& colors);
+	static LRESULT DrawListItemWithMatches(const std::vector<CHARRANGE>& ranges, const CString& text, CListCtrl& listCtrl, NMLVCUSTOMDRAW* pLVCD, CColors& colors);
 
 protected:
 	void paintGraphLane(HDC hdc, int laneHeight, Lanes::LaneType type, bool rolledUp, int x1, int x2,
@@ -629,11 +663,18 @@ protected:
 	int GetHeadIndex();
 
 	std::vector<GitRevLoglist*> m_AsynDiffList;
+	std::vector<GitRevLoglist*> m_PrefetchDiffList; // rows around the visible ones, the most important one is at the back
+	std::unordered_set<GitRevLoglist*> m_AsyncDiffInProgress;
 	CComAutoCriticalSection m_AsynDiffListLock;
-	HANDLE m_AsyncDiffEvent = nullptr;
+	HANDLE m_AsyncDiffEvent = nullptr; // manual reset, only reset with m_AsynDiffListLock held and both lists empty
 	volatile LONG m_AsyncThreadExit = FALSE;
-	CWinThread* m_DiffingThread = nullptr;
+	std::vector<CWinThread*> m_DiffingThreads;
 	volatile LONG m_AsyncThreadRunning = FALSE;
+	int m_PrefetchTopIndex = -1;
+	size_t m_PrefetchShownCount = 0;
+
+	/// queues the rows around the visible ones, so that their changed files are known before they are shown or selected
+	void PrefetchDiffs();
 
 public:
 	bool IsCached(GitRevLoglist* rev)
@@ -671,13 +712,17 @@ protected:
 public:
 	void SafeTerminateAsyncDiffThread()
 	{
-		if (m_DiffingThread && InterlockedExchange(&m_AsyncThreadExit, TRUE) == FALSE)
+		if (!m_DiffingThreads.empty() && InterlockedExchange(&m_AsyncThreadExit, TRUE) == FALSE)
 		{
 			::SetEvent(m_AsyncDiffEvent);
-			while (::WaitForSingleObject(m_DiffingThread->m_hThread, 1000) == WAIT_TIMEOUT)
-				CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": Waiting for async diff thread to exit...\n");
-			delete m_DiffingThread;
-			m_DiffingThread = nullptr;
+			for (auto thread : m_DiffingThreads)
+			{
+				while (::WaitForSingleObject(thread->m_hThread, 1000) == WAIT_TIMEOUT)
+					CTraceToOutputDebugString::Instance()(_T(__FUNCTION__) L": Waiting for async diff thread to exit...\n");
+				delete thread;
+			}
+			m_DiffingThreads.clear();
+			InterlockedExchange(&m_AsyncThreadRunning, FALSE);
 			InterlockedExchange(&m_AsyncThreadExit, FALSE);
 		}
 	};
@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2008, 2014 - TortoiseSVN
-// Copyright (C) 2008-2017, 2019 - TortoiseGit
+// Copyright (C) 2008-2017, 2019, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -74,13 +74,13 @@ bool CSorter::operator() (const CTGitPath* entry1 , const CTGitPath* entry2) con
 	case 5: //Del Number
 		{
 			if (result == 0)
-				result = SGN(A2L(entry1->m_StatDel) - A2L(entry2->m_StatDel));
+				result = SGN(entry1->m_StatDel - entry2->m_StatDel);
 			break;
 		}
 	case 4: //Add Number
 		{
 			if (result == 0)
-				result = SGN(A2L(entry1->m_StatAdd) - A2L(entry2->m_StatAdd));
+				result = SGN(entry1->m_StatAdd - entry2->m_StatAdd);
 			break;
 		}
 
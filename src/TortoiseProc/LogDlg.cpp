@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2009, 2015 - TortoiseSVN
-// Copyright (C) 2008-2025 - TortoiseGit
+// Copyright (C) 2008-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -3225,6 +3225,7 @@ void CLogDlg::HandleShowLabels(bool var, int flag)
 		m_LogList.m_ShowRefMask |= flag;
 	else
 		m_LogList.m_ShowRefMask &= ~flag;
+	m_LogList.InvalidateRenderCache();
 
 	if (((m_LogList.m_ShowFilter & CGitLogListBase::FILTERSHOW_REFS) && !(m_LogList.m_ShowFilter & CGitLogListBase::FILTERSHOW_ANYCOMMIT)) || !m_LogList.m_RollUpStates.load()->empty())
 	{
@@ -3600,6 +3601,7 @@ void CLogDlg::OnNMCustomdrawChangedFileList(NMHDR* pNMHDR, LRESULT* pResult)
 void CLogDlg::OnSysColorChange()
 {
 	__super::OnSysColorChange();
+	m_LogList.InvalidateRenderCache();
 	SetupLogMessageViewControl();
 	CMFCVisualManager::GetInstance()->RedrawAll();
 	FillLogMessageCtrl();
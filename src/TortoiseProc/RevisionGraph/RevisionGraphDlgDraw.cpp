@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2011, 2015 - TortoiseSVN
-// Copyright (C) 2012-2013, 2015-2025 - TortoiseGit
+// Copyright (C) 2012-2013, 2015-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -285,7 +285,15 @@ PointF CRevisionGraphWnd::cutPoint(ogdf::node v, double lw, const PointF& ps, co
 	return pt;
 }
 
-void CRevisionGraphWnd::DrawConnections(GraphicsDevice& graphics, const CRect& /*logRect*/, const CSize& offset) const
+bool CRevisionGraphWnd::IsNodeInRect(ogdf::node v, const CRect& logRect) const
+{
+	// leave room for the markers next to the node
+	const double margin = GetLeftRightMargin();
+	return m_GraphAttr.x(v) + m_GraphAttr.width(v) / 2 + margin >= logRect.left && m_GraphAttr.x(v) - m_GraphAttr.width(v) / 2 - margin <= logRect.right
+		&& m_GraphAttr.y(v) + m_GraphAttr.height(v) / 2 >= logRect.top && m_GraphAttr.y(v) - m_GraphAttr.height(v) / 2 <= logRect.bottom;
+}
+
+void CRevisionGraphWnd::DrawConnections(GraphicsDevice& graphics, const CRect& logRect, const CSize& offset) const
 {
 	CArray<PointF> points;
 	CArray<CPoint> pts;
@@ -296,12 +304,32 @@ void CRevisionGraphWnd::DrawConnections(GraphicsDevice& graphics, const CRect& /
 	float penwidth = 2*m_fZoomFactor<1? 1:2*m_fZoomFactor;
 	Gdiplus::Pen pen(CTheme::Instance().GetThemeColor(GetColorFromSysColor(COLOR_WINDOWTEXT)), penwidth);
 
+	// the export formats need all lines
+	const bool onlyVisible = !graphics.pSVG && !graphics.pGraphviz;
+
 	// iterate over all visible lines
 	for (auto e : m_Graph.edges)
 	{
 		// get connection and point position
 		const auto& dpl = this->m_GraphAttr.bends(e);
 
+		if (onlyVisible)
+		{
+			double left = min(m_GraphAttr.x(e->source()), m_GraphAttr.x(e->target()));
+			double right = max(m_GraphAttr.x(e->source()), m_GraphAttr.x(e->target()));
+			double top = min(m_GraphAttr.y(e->source()), m_GraphAttr.y(e->target()));
+			double bottom = max(m_GraphAttr.y(e->source()), m_GraphAttr.y(e->target()));
+			for (const auto& point : dpl)
+			{
+				left = min(left, point.m_x);
+				right = max(right, point.m_x);
+				top = min(top, point.m_y);
+				bottom = max(bottom, point.m_y);
+			}
+			if (right < logRect.left || left > logRect.right || bottom < logRect.top || top > logRect.bottom)
+				continue;
+		}
+
 		points.RemoveAll();
 		pts.RemoveAll();
 
@@ -509,7 +537,7 @@ void CRevisionGraphWnd::DrawNode(GraphicsDevice& graphics, AllColorsAndBrushes&
 	}
 }
 
-void CRevisionGraphWnd::DrawTexts (GraphicsDevice& graphics, const CRect& /*logRect*/, const CSize& offset)
+void CRevisionGraphWnd::DrawTexts (GraphicsDevice& graphics, const CRect& logRect, const CSize& offset)
 {
 	if (m_nFontSize <= 0)
 		return;
@@ -524,8 +552,14 @@ void CRevisionGraphWnd::DrawTexts (GraphicsDevice& graphics, const CRect& /*logR
 	Gdiplus::Font font(fontname, static_cast<REAL>(m_nFontSize), FontStyleRegular);
 	auto colorsAndBrushes = SetupColorsAndBrushes(m_Colors);
 
+	// the export formats need all nodes
+	const bool onlyVisible = !graphics.pSVG && !graphics.pGraphviz;
+
 	for (auto v : m_Graph.nodes)
 	{
+		if (onlyVisible && !IsNodeInRect(v, logRect))
+			continue;
+
 		// get node and position
 		RectF noderect (GetNodeRect (v, offset));
 
@@ -708,12 +742,32 @@ void CRevisionGraphWnd::DrawGraph(GraphicsDevice& graphics, const CRect& rect, i
 
 void CRevisionGraphWnd::MeasureTextLength(GraphicsDevice& graphics, Gdiplus::Font& font, const CString& text, int& xmax, int& ymax) const
 {
-	RectF rect;
-	graphics.graphics->MeasureString(text, text.GetLength(), &font, Gdiplus::PointF(0, 0), &rect);
-	if (rect.Width > xmax)
-		xmax = static_cast<int>(rect.Width);
-	if (rect.Height > ymax)
-		ymax = static_cast<int>(rect.Height);
+	FontFamily family;
+	WCHAR familyName[LF_FACESIZE] = { 0 };
+	font.GetFamily(&family);
+	family.GetFamilyName(familyName);
+	CString fontKey;
+	fontKey.Format(L"%s:%g", familyName, font.GetSize());
+	if (fontKey != m_TextExtentCacheFont)
+	{
+		m_TextExtentCache.clear();
+		m_TextExtentCacheFont = fontKey;
+	}
+
+	SizeF size;
+	if (auto it = m_TextExtentCache.find(static_cast<LPCWSTR>(text)); it != m_TextExtentCache.cend())
+		size = it->second;
+	else
+	{
+		RectF rect;
+		graphics.graphics->MeasureString(text, text.GetLength(), &font, Gdiplus::PointF(0, 0), &rect);
+		rect.GetSize(&size);
+		m_TextExtentCache.emplace(static_cast<LPCWSTR>(text), size);
+	}
+	if (size.Width > xmax)
+		xmax = static_cast<int>(size.Width);
+	if (size.Height > ymax)
+		ymax = static_cast<int>(size.Height);
 }
 
 void CRevisionGraphWnd::SetNodeRect(GraphicsDevice& graphics, Gdiplus::Font& font, const Rect& commitString, ogdf::node* pnode, const CGitHash& rev)
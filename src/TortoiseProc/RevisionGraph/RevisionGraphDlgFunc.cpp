@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2011 - TortoiseSVN
-// Copyright (C) 2012-2023, 2025 - TortoiseGit
+// Copyright (C) 2012-2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -25,8 +25,16 @@
 #include "Git.h"
 #include "DPIAware.h"
 #include <regex>
+#include <thread>
+#include <atomic>
 #include "AppUtils.h"
 
+#pragma warning(push)
+#pragma warning(disable: 4100) // unreferenced formal parameter
+#include <ogdf/layered/MedianHeuristic.h>
+#include <ogdf/layered/FastHierarchyLayout.h>
+#pragma warning(pop)
+
 #ifdef _DEBUG
 #define new DEBUG_NEW
 #undef THIS_FILE
@@ -35,6 +43,71 @@ static char THIS_FILE[] = __FILE__;
 
 using namespace Gdiplus;
 
+namespace
+{
+// number of generations which are laid out together; larger graphs are split into bands which are laid out independently
+constexpr int REVGRAPH_LAYOUT_BAND_GENERATIONS = 200;
+constexpr double REVGRAPH_LAYER_DISTANCE = 30.0;
+constexpr double REVGRAPH_NODE_DISTANCE = 25.0;
+
+struct LayoutBand
+{
+	std::vector<ogdf::node>			nodes;
+	std::vector<ogdf::edge>			edges;		///< edges with both ends in this band
+	std::vector<ogdf::DPoint>		positions;	///< of nodes, relative to the band
+	std::vector<ogdf::DPolyline>	bends;		///< of edges, relative to the band
+	double							top = 0;
+	double							bottom = 0;
+};
+
+/// lays out the nodes of a band in a graph of their own, so that the bands can be laid out concurrently
+void LayoutGenerationBand(LayoutBand& band, const ogdf::GraphAttributes& graphAttr, const std::vector<int>& ranks, const std::vector<int>& localIndexes, int firstRank)
+{
+	ogdf::Graph graph;
+	ogdf::GraphAttributes attr(graph, ogdf::GraphAttributes::nodeGraphics | ogdf::GraphAttributes::edgeGraphics);
+	std::vector<ogdf::node> nodes;
+	nodes.reserve(band.nodes.size());
+	for (auto v : band.nodes)
+	{
+		auto nd = graph.newNode();
+		attr.width(nd) = graphAttr.width(v);
+		attr.height(nd) = graphAttr.height(v);
+		nodes.push_back(nd);
+	}
+	std::vector<ogdf::edge> edges;
+	edges.reserve(band.edges.size());
+	for (auto e : band.edges)
+		edges.push_back(graph.newEdge(nodes[localIndexes[e->source()->index()]], nodes[localIndexes[e->target()->index()]]));
+
+	// the layers are given by the generation numbers, so no (expensive) ranking has to be computed
+	ogdf::NodeArray<int> layers(graph);
+	for (size_t i = 0; i < nodes.size(); ++i)
+		layers[nodes[i]] = ranks[band.nodes[i]->index()] - firstRank;
+
+	ogdf::SugiyamaLayout layout;
+	layout.setCrossMin(::new ogdf::MedianHeuristic());
+	auto pOHL = ::new ogdf::FastHierarchyLayout;
+	pOHL->layerDistance(REVGRAPH_LAYER_DISTANCE);
+	pOHL->nodeDistance(REVGRAPH_NODE_DISTANCE);
+	layout.setLayout(pOHL); // owned by layout
+	layout.call(attr, layers);
+
+	band.positions.reserve(nodes.size());
+	for (size_t i = 0; i < nodes.size(); ++i)
+	{
+		const double y = attr.y(nodes[i]);
+		if (i == 0 || y - attr.height(nodes[i]) / 2 < band.top)
+			band.top = y - attr.height(nodes[i]) / 2;
+		if (i == 0 || y + attr.height(nodes[i]) / 2 > band.bottom)
+			band.bottom = y + attr.height(nodes[i]) / 2;
+		band.positions.emplace_back(attr.x(nodes[i]), y);
+	}
+	band.bends.reserve(edges.size());
+	for (auto e : edges)
+		band.bends.push_back(attr.bends(e));
+}
+}
+
 void CRevisionGraphWnd::InitView()
 {
 	m_bIsCanvasMove = false;
@@ -356,11 +429,7 @@ bool CRevisionGraphWnd::FetchRevisionData
 		}
 	}
 
-	//this->m_OHL.layerDistance(30.0);
-	//this->m_OHL.nodeDistance(25.0);
-	//this->m_OHL.weightBalancing(0.8);
-
-	m_SugiyamLayout.call(m_GraphAttr);
+	LayoutGraph();
 
 	double xmax = 0;
 	double ymax = 0;
@@ -380,6 +449,97 @@ bool CRevisionGraphWnd::FetchRevisionData
 	return true;
 }
 
+void CRevisionGraphWnd::LayoutGraph()
+{
+	const auto maxIndex = static_cast<size_t>(m_Graph.maxNodeIndex() + 1);
+
+	// generation numbers: 0 for root commits, otherwise one more than the highest generation of the parents;
+	// edges point from a commit to its parents
+	std::vector<int> generations(maxIndex, 0);
+	std::vector<int> pendingParents(maxIndex, 0);
+	for (auto e : m_Graph.edges)
+		++pendingParents[e->source()->index()];
+	std::vector<ogdf::node> queue;
+	queue.reserve(maxIndex);
+	for (auto v : m_Graph.nodes)
+	{
+		if (!pendingParents[v->index()])
+			queue.push_back(v);
+	}
+	int maxGeneration = 0;
+	for (size_t i = 0; i < queue.size(); ++i)
+	{
+		auto v = queue[i];
+		const int generation = generations[v->index()];
+		maxGeneration = max(maxGeneration, generation);
+		for (auto adj : v->adjEntries)
+		{
+			auto e = adj->theEdge();
+			if (e->target() != v)
+				continue;
+			auto child = e->source();
+			generations[child->index()] = max(generations[child->index()], generation + 1);
+			if (--pendingParents[child->index()] == 0)
+				queue.push_back(child);
+		}
+	}
+
+	// newest commits on top
+	std::vector<int> ranks(maxIndex, 0);
+	std::vector<LayoutBand> bands(maxGeneration / REVGRAPH_LAYOUT_BAND_GENERATIONS + 1);
+	std::vector<int> localIndexes(maxIndex, 0);
+	for (auto v : m_Graph.nodes)
+	{
+		ranks[v->index()] = maxGeneration - generations[v->index()];
+		auto& band = bands[ranks[v->index()] / REVGRAPH_LAYOUT_BAND_GENERATIONS];
+		localIndexes[v->index()] = static_cast<int>(band.nodes.size());
+		band.nodes.push_back(v);
+	}
+	for (auto e : m_Graph.edges)
+	{
+		const int band = ranks[e->source()->index()] / REVGRAPH_LAYOUT_BAND_GENERATIONS;
+		if (band == ranks[e->target()->index()] / REVGRAPH_LAYOUT_BAND_GENERATIONS)
+			bands[band].edges.push_back(e);
+	}
+
+	std::atomic<size_t> nextBand = 0;
+	auto worker = [&]() {
+		for (size_t i; (i = nextBand++) < bands.size();)
+			LayoutGenerationBand(bands[i], m_GraphAttr, ranks, localIndexes, static_cast<int>(i) * REVGRAPH_LAYOUT_BAND_GENERATIONS);
+	};
+	std::vector<std::thread> workers;
+	const size_t workerCount = min(bands.size(), static_cast<size_t>(max(std::thread::hardware_concurrency(), 1U)));
+	for (size_t i = 1; i < workerCount; ++i)
+		workers.emplace_back(worker);
+	worker();
+	for (auto& thread : workers)
+		thread.join();
+
+	// stack the bands, edges between two bands are drawn as straight lines
+	for (auto e : m_Graph.edges)
+		m_GraphAttr.bends(e).clear();
+	double offset = 0;
+	for (auto& band : bands)
+	{
+		if (band.nodes.empty())
+			continue;
+		const double dy = offset - band.top;
+		for (size_t i = 0; i < band.nodes.size(); ++i)
+		{
+			m_GraphAttr.x(band.nodes[i]) = band.positions[i].m_x;
+			m_GraphAttr.y(band.nodes[i]) = band.positions[i].m_y + dy;
+		}
+		for (size_t i = 0; i < band.edges.size(); ++i)
+		{
+			auto& bends = m_GraphAttr.bends(band.edges[i]);
+			bends = band.bends[i];
+			for (auto& point : bends)
+				point.m_y += dy;
+		}
+		offset += band.bottom - band.top + REVGRAPH_LAYER_DISTANCE;
+	}
+}
+
 bool CRevisionGraphWnd::IsUpdateJobRunning() const
 {
 	return (updateJob.get() != nullptr) && !updateJob->IsDone();
@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2012, 2015 - TortoiseSVN
-// Copyright (C) 2012-2023, 2025 - TortoiseGit
+// Copyright (C) 2012-2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -30,13 +30,6 @@
 #include "FormatMessageWrapper.h"
 #include "GitRevLoglist.h"
 
-#pragma warning(push)
-#pragma warning(disable: 4100) // unreferenced formal parameter
-#include <ogdf/layered/OptimalRanking.h>
-#include <ogdf/layered/MedianHeuristic.h>
-#include <ogdf/layered/FastHierarchyLayout.h>
-#pragma warning(pop)
-
 #ifdef _DEBUG
 #define new DEBUG_NEW
 #undef THIS_FILE
@@ -119,21 +112,10 @@ CRevisionGraphWnd::CRevisionGraphWnd()
 
 	m_GraphAttr.init(this->m_Graph, ogdf::GraphAttributes::nodeGraphics | ogdf::GraphAttributes::edgeGraphics);
 
-	m_SugiyamLayout.setRanking(::new ogdf::OptimalRanking());
-	m_SugiyamLayout.setCrossMin(::new ogdf::MedianHeuristic());
-
 	double pi = 3.1415926;
 	m_ArrowCos = cos(pi/8);
 	m_ArrowSin = sin(pi/8);
 	this->m_ArrowSize = 8;
-
-	auto pOHL = ::new ogdf::FastHierarchyLayout;
-	//It will auto delte when m_SugiyamLayout destroy
-
-	pOHL->layerDistance(30.0);
-	pOHL->nodeDistance(25.0);
-
-	m_SugiyamLayout.setLayout(pOHL);
 }
 
 CRevisionGraphWnd::~CRevisionGraphWnd()
@@ -1,7 +1,7 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
 // Copyright (C) 2003-2011 - TortoiseSVN
-// Copyright (C) 2012-2019, 2022-2023, 2025 - TortoiseGit
+// Copyright (C) 2012-2019, 2022-2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -195,7 +195,6 @@ protected:
 
 	ogdf::Graph	m_Graph;
 	ogdf::GraphAttributes m_GraphAttr;
-	ogdf::SugiyamaLayout m_SugiyamLayout;
 
 	CRect	m_GraphRect;
 
@@ -307,6 +306,7 @@ private:
 	void			DrawRoundedRect (GraphicsDevice& graphics, const Color& penColor, int penWidth, const Pen* pen, const Color& fillColor, const Brush* brush, const RectF& rect, int mask=ROUND_BOTH) const;
 	RectF			TransformRectToScreen (const CRect& rect, const CSize& offset) const;
 	RectF			GetNodeRect (const ogdf::node& v, const CSize& offset) const;
+	bool			IsNodeInRect(ogdf::node v, const CRect& logRect) const;
 	void			DrawMarker ( GraphicsDevice& graphics, const RectF& noderect
 							   , MarkerPosition position, int relPosition, const Color& penColor, int num) const;
 	void			DrawConnections (GraphicsDevice& graphics, const CRect& logRect, const CSize& offset) const;
@@ -317,4 +317,10 @@ private:
 	int				GetEncoderClsid(const WCHAR* format, CLSID* pClsid);
 	void	SetNodeRect(GraphicsDevice& graphics, Gdiplus::Font& font, const Rect& commitString, ogdf::node* pnode, const CGitHash& rev);
 	void	MeasureTextLength(GraphicsDevice& graphics, Gdiplus::Font& font, const CString& text, int& xmax, int& ymax) const;
+	/// layered layout with the generation numbers as layers, large graphs are laid out in bands of generations
+	void	LayoutGraph();
+
+	/// the ref names are measured again for every refresh, cache their sizes as long as the font does not change
+	mutable std::unordered_map<std::wstring, SizeF> m_TextExtentCache;
+	mutable CString	m_TextExtentCacheFont;
 };
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008-2021, 2023-2025 - TortoiseGit
+// Copyright (C) 2008-2021, 2023-2026 - TortoiseGit
 // Copyright (C) 2003-2011, 2014-2016, 2018 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -31,6 +31,8 @@
 #include <utility>
 #include <strsafe.h>
 #include <iterator>
+#include <thread>
+#include <atomic>
 
 using namespace Gdiplus;
 
@@ -546,6 +548,85 @@ int CStatGraphDlg::GetCalendarWeek(const CTime& time)
 	return iWeekOfYear;
 }
 
+namespace
+{
+// below this number of commits per chunk, the aggregation is not worth spreading over threads
+constexpr size_t STATGRAPH_MIN_COMMITS_PER_CHUNK = 4096;
+
+size_t GetWorkerCount(size_t items, size_t minItemsPerWorker)
+{
+	const size_t maxWorkers = std::max(std::thread::hardware_concurrency(), 1U);
+	return std::clamp<size_t>(items / minItemsPerWorker, 1, maxWorkers);
+}
+
+/// calls fn(chunk, begin, end) for \a chunks consecutive ranges of [0, count) in parallel
+template <typename Fn>
+void ParallelForChunks(size_t count, size_t chunks, Fn fn)
+{
+	std::vector<std::thread> workers;
+	for (size_t chunk = 1; chunk < chunks; ++chunk)
+		workers.emplace_back(fn, chunk, count * chunk / chunks, count * (chunk + 1) / chunks);
+	fn(0, 0, count / chunks);
+	for (auto& worker : workers)
+		worker.join();
+}
+}
+
+bool CStatGraphDlg::FetchLineStats(std::vector<GitRevLoglist::LineStat>& lineStats, CSysProgressDlg& progress)
+{
+	const size_t count = m_ShowList.size();
+	lineStats.assign(count, GitRevLoglist::LineStat());
+
+	// the diffs take very different amounts of time, so the workers fetch the next commit as soon as they are done
+	std::atomic<size_t> next = 0;
+	std::atomic<size_t> finished = 0;
+	std::atomic<size_t> lastFinished = 0;
+	std::atomic<bool> cancel = false;
+	auto worker = [&]() {
+		for (size_t i; !cancel && (i = next++) < count;)
+		{
+			auto pLogEntry = m_ShowList[i];
+			// merge commits are not counted
+			if (pLogEntry->m_ParentHash.size() <= 1)
+			{
+				pLogEntry->CheckAndDiff();
+				lineStats[i] = pLogEntry->GetLineStat();
+			}
+			lastFinished = i;
+			++finished;
+		}
+	};
+
+	std::vector<std::thread> workers;
+	std::vector<HANDLE> handles;
+	const unsigned int workerCount = static_cast<unsigned int>(std::min<size_t>(GetWorkerCount(count, 1), MAXIMUM_WAIT_OBJECTS));
+	for (unsigned int i = 0; i < workerCount; ++i)
+	{
+		workers.emplace_back(worker);
+		handles.push_back(workers.back().native_handle());
+	}
+
+	bool cancelled = false;
+	while (!handles.empty() && ::WaitForMultipleObjects(static_cast<DWORD>(handles.size()), handles.data(), TRUE, 100) == WAIT_TIMEOUT)
+	{
+		if (progress.HasUserCancelled())
+		{
+			cancel = true;
+			cancelled = true;
+			break;
+		}
+		if (progress.IsVisible() && finished > 0)
+		{
+			auto pLogEntry = m_ShowList[lastFinished];
+			progress.FormatNonPathLine(2, L"%s: %s", static_cast<LPCWSTR>(pLogEntry->m_CommitHash.ToString(g_Git.GetShortHASHLength())), static_cast<LPCWSTR>(pLogEntry->GetSubject()));
+			progress.SetProgress64(finished, count);
+		}
+	}
+	for (auto& thread : workers)
+		thread.join();
+	return !cancelled;
+}
+
 int CStatGraphDlg::GatherData(BOOL fetchdiff, BOOL keepFetchedData)
 {
 	m_parAuthors.RemoveAll();
@@ -579,18 +660,18 @@ int CStatGraphDlg::GatherData(BOOL fetchdiff, BOOL keepFetchedData)
 	}
 
 	// create arrays which are aware of the current filter
-	ULONGLONG starttime = GetTickCount64();
-
 	if (m_bUseCommitDates)
 		std::sort(m_ShowList.begin(), m_ShowList.end(), [](GitRevLoglist* pLhs, GitRevLoglist* pRhs) { return pLhs->GetCommitterDate() > pRhs->GetCommitterDate(); });
 	else
 		std::sort(m_ShowList.begin(), m_ShowList.end(), [](GitRevLoglist* pLhs, GitRevLoglist* pRhs) { return pLhs->GetAuthorDate() > pRhs->GetAuthorDate(); });
 
+	std::vector<GitRevLoglist::LineStat> lineStats;
+	if (fetchdiff && !FetchLineStats(lineStats, progress))
+		return -1;
+
 	for (size_t i = 0; i < m_ShowList.size(); ++i)
 	{
 		auto pLogEntry = m_ShowList[i];
-		int inc, dec, incnewfile, decdeletedfile, files;
-		inc = dec = incnewfile = decdeletedfile = files= 0;
 
 		CString strAuthor = m_bUseCommitterNames ? pLogEntry->GetCommitterName() : pLogEntry->GetAuthorName();
 		if (strAuthor.IsEmpty())
@@ -601,43 +682,15 @@ int CStatGraphDlg::GatherData(BOOL fetchdiff, BOOL keepFetchedData)
 		else
 			m_parDates.Add(static_cast<DWORD>(pLogEntry->GetAuthorDate().GetTime()));
 
-		if (fetchdiff && (pLogEntry->m_ParentHash.size() <= 1))
-		{
-			auto list = pLogEntry->GetFiles(nullptr);
-			files = list.GetCount();
-
-			for (int j = 0; j < files; j++)
-			{
-				if (list[j].m_Action & CTGitPath::LOGACTIONS_DELETED)
-					decdeletedfile += _wtol(list[j].m_StatDel);
-				else if(list[j].m_Action & CTGitPath::LOGACTIONS_ADDED)
-					incnewfile += _wtol(list[j].m_StatAdd);
-				else
-				{
-					inc += _wtol(list[j].m_StatAdd);
-					dec += _wtol(list[j].m_StatDel);
-				}
-
-				if (progress.HasUserCancelled())
-					return -1;
-			}
-		}
 		if (!keepFetchedData)
 		{
-			m_parFileChanges.Add(files);
-			m_lineInc.Add(inc);
-			m_lineDec.Add(dec);
-			m_lineDel.Add(decdeletedfile);
-			m_lineNew.Add(incnewfile);
+			const GitRevLoglist::LineStat lineStat = lineStats.empty() ? GitRevLoglist::LineStat() : lineStats[i];
+			m_parFileChanges.Add(lineStat.files);
+			m_lineInc.Add(lineStat.inc);
+			m_lineDec.Add(lineStat.dec);
+			m_lineDel.Add(lineStat.deletedFile);
+			m_lineNew.Add(lineStat.newFile);
 		}
-
-		if (progress.IsVisible() && (GetTickCount64() - starttime > 100UL))
-		{
-			progress.FormatNonPathLine(2, L"%s: %s", static_cast<LPCWSTR>(pLogEntry->m_CommitHash.ToString(g_Git.GetShortHASHLength())), static_cast<LPCWSTR>(pLogEntry->GetSubject()));
-			progress.SetProgress64(i, m_ShowList.size());
-			starttime = GetTickCount64();
-		}
-
 	}
 
 	if (fetchdiff)
@@ -663,51 +716,109 @@ int CStatGraphDlg::GatherData(BOOL fetchdiff, BOOL keepFetchedData)
 	m_LinesWPerUnitAndAuthor.clear();
 	m_LinesWOPerUnitAndAuthor.clear();
 
-	int interval = 0;
-	__time64_t d = static_cast<__time64_t>(m_parDates.GetAt(0));
-	int nLastUnit = GetUnit(d);
+	m_nTotalLinesInc = m_nTotalLinesDec = m_nTotalLinesNew = m_nTotalLinesDel =0;
 	double AllContributionAuthor = 0;
 
-	m_nTotalLinesInc = m_nTotalLinesDec = m_nTotalLinesNew = m_nTotalLinesDel =0;
+	const auto count = static_cast<size_t>(m_nTotalCommits);
+	const size_t chunks = GetWorkerCount(count, STATGRAPH_MIN_COMMITS_PER_CHUNK);
 
-	// Now loop over all weeks and gather the info
-	for (LONG i=0; i<m_nTotalCommits; ++i)
+	// Find the unit of every commit, the interval numbers depend on the preceding commits
+	std::vector<int> units(count);
+	ParallelForChunks(count, chunks, [&](size_t, size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+			units[i] = GetUnit(static_cast<__time64_t>(m_parDates.GetAt(i)));
+	});
+	std::vector<int> intervals(count);
+	int interval = 0;
+	for (size_t i = 0; i < count; ++i)
 	{
-		// Find the interval number
-		__time64_t commitDate = static_cast<__time64_t>(m_parDates.GetAt(i));
-		int u = GetUnit(commitDate);
-		if (nLastUnit != u)
+		if (i > 0 && units[i] != units[i - 1])
 			interval++;
-		nLastUnit = u;
-		// Find the authors name
-		CString sAuth = m_parAuthors.GetAt(i);
-		if (!m_bAuthorsCaseSensitive)
-			sAuth = sAuth.MakeLower();
-		std::wstring author = std::wstring(sAuth);
-		// Increase total commit count for this author
-		m_commitsPerAuthor[author]++;
-		// Increase the commit count for this author in this week
-		m_commitsPerUnitAndAuthor[interval][author]++;
-
-		m_LinesWPerUnitAndAuthor[interval][author] += m_lineInc.GetAt(i) + m_lineDec.GetAt(i) + m_lineNew.GetAt(i) + + m_lineDel.GetAt(i);
-		m_LinesWOPerUnitAndAuthor[interval][author] += m_lineInc.GetAt(i) + m_lineDec.GetAt(i);
-
-		CTime t = m_parDates.GetAt(i);
-		m_unitNames[interval] = GetUnitLabel(nLastUnit, t);
-		// Increase the file change count for this author in this week
-		int fileChanges = m_parFileChanges.GetAt(i);
-		m_filechangesPerUnitAndAuthor[interval][author] += fileChanges;
-		m_nTotalFileChanges += fileChanges;
-
-		//calculate Contribution Author
-		double contributionAuthor = CoeffContribution(static_cast<int>(m_nTotalCommits) - i -1) * (fileChanges ? fileChanges : 1);
-		AllContributionAuthor += contributionAuthor;
-		m_PercentageOfAuthorship[author] += contributionAuthor;
-
-		m_nTotalLinesInc += m_lineInc.GetAt(i);
-		m_nTotalLinesDec += m_lineDec.GetAt(i);
-		m_nTotalLinesNew += m_lineNew.GetAt(i);
-		m_nTotalLinesDel += m_lineDel.GetAt(i);
+		intervals[i] = interval;
+		// the label is based on the last commit of the interval
+		if (i + 1 == count || units[i + 1] != units[i])
+		{
+			CTime t = m_parDates.GetAt(i);
+			m_unitNames[interval] = GetUnitLabel(units[i], t);
+		}
+	}
+
+	// Now loop over all weeks and gather the info, every chunk of commits into its own maps which are merged afterwards
+	struct PartialData
+	{
+		IntervalDataMap		commitsPerUnitAndAuthor;
+		IntervalDataMap		filechangesPerUnitAndAuthor;
+		IntervalDataMap		linesWPerUnitAndAuthor;
+		IntervalDataMap		linesWOPerUnitAndAuthor;
+		AuthorDataMap		commitsPerAuthor;
+		AuthorshipDataMap	percentageOfAuthorship;
+		double				allContributionAuthor = 0;
+		LONG				totalFileChanges = 0;
+		LONG				totalLinesInc = 0;
+		LONG				totalLinesDec = 0;
+		LONG				totalLinesNew = 0;
+		LONG				totalLinesDel = 0;
+	};
+	std::vector<PartialData> partialData(chunks);
+	ParallelForChunks(count, chunks, [&](size_t chunk, size_t begin, size_t end) {
+		auto& data = partialData[chunk];
+		for (size_t i = begin; i < end; ++i)
+		{
+			const int intervalOfCommit = intervals[i];
+			// Find the authors name
+			CString sAuth = m_parAuthors.GetAt(i);
+			if (!m_bAuthorsCaseSensitive)
+				sAuth = sAuth.MakeLower();
+			std::wstring author = std::wstring(sAuth);
+			// Increase total commit count for this author
+			data.commitsPerAuthor[author]++;
+			// Increase the commit count for this author in this week
+			data.commitsPerUnitAndAuthor[intervalOfCommit][author]++;
+
+			data.linesWPerUnitAndAuthor[intervalOfCommit][author] += m_lineInc.GetAt(i) + m_lineDec.GetAt(i) + m_lineNew.GetAt(i) + m_lineDel.GetAt(i);
+			data.linesWOPerUnitAndAuthor[intervalOfCommit][author] += m_lineInc.GetAt(i) + m_lineDec.GetAt(i);
+
+			// Increase the file change count for this author in this week
+			int fileChanges = m_parFileChanges.GetAt(i);
+			data.filechangesPerUnitAndAuthor[intervalOfCommit][author] += fileChanges;
+			data.totalFileChanges += fileChanges;
+
+			//calculate Contribution Author
+			double contributionAuthor = CoeffContribution(static_cast<int>(count - i - 1)) * (fileChanges ? fileChanges : 1);
+			data.allContributionAuthor += contributionAuthor;
+			data.percentageOfAuthorship[author] += contributionAuthor;
+
+			data.totalLinesInc += m_lineInc.GetAt(i);
+			data.totalLinesDec += m_lineDec.GetAt(i);
+			data.totalLinesNew += m_lineNew.GetAt(i);
+			data.totalLinesDel += m_lineDel.GetAt(i);
+		}
+	});
+
+	auto mergeIntervalData = [](IntervalDataMap& target, const IntervalDataMap& source) {
+		for (const auto& [unit, authors] : source)
+		{
+			auto& targetAuthors = target[unit];
+			for (const auto& [author, value] : authors)
+				targetAuthors[author] += value;
+		}
+	};
+	for (const auto& data : partialData)
+	{
+		mergeIntervalData(m_commitsPerUnitAndAuthor, data.commitsPerUnitAndAuthor);
+		mergeIntervalData(m_filechangesPerUnitAndAuthor, data.filechangesPerUnitAndAuthor);
+		mergeIntervalData(m_LinesWPerUnitAndAuthor, data.linesWPerUnitAndAuthor);
+		mergeIntervalData(m_LinesWOPerUnitAndAuthor, data.linesWOPerUnitAndAuthor);
+		for (const auto& [author, commits] : data.commitsPerAuthor)
+			m_commitsPerAuthor[author] += commits;
+		for (const auto& [author, contribution] : data.percentageOfAuthorship)
+			m_PercentageOfAuthorship[author] += contribution;
+		AllContributionAuthor += data.allContributionAuthor;
+		m_nTotalFileChanges += data.totalFileChanges;
+		m_nTotalLinesInc += data.totalLinesInc;
+		m_nTotalLinesDec += data.totalLinesDec;
+		m_nTotalLinesNew += data.totalLinesNew;
+		m_nTotalLinesDel += data.totalLinesDel;
 	}
 
 	// Find first and last interval number.
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2008, 2011-2013, 2015-2018, 2021-2023, 2025 - TortoiseGit
+// Copyright (C) 2008, 2011-2013, 2015-2018, 2021-2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2003-2011, 2015 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -24,6 +24,8 @@
 #include "TGitPath.h"
 #include "GitRevLoglist.h"
 
+class CSysProgressDlg;
+
 /**
  * \ingroup TortoiseProc
  * Helper class for drawing and then saving the drawing to a meta file (wmf)
@@ -152,6 +154,8 @@ protected:
 	int GetCalendarWeek(const CTime& time);
 	/// Parses the data given to the dialog and generates mappings with statistical data.
 	int GatherData(BOOL fetchdiff = FALSE, BOOL keepFetchedData = FALSE);
+	/// Fetches the line statistics of all commits in m_ShowList using several worker threads, returns false if the user cancelled.
+	bool FetchLineStats(std::vector<GitRevLoglist::LineStat>& lineStats, CSysProgressDlg& progress);
 	/// Populates the lists passed as arguments based on the commit threshold set with the skipper.
 	void FilterSkippedAuthors(std::list<std::wstring>& included_authors, std::list<std::wstring>& skipped_authors);
 	/// Shows the graph Percentage Of Authorship
@@ -2143,6 +2143,7 @@
 #define IDI_UNLOCK_BKG                  32925
 #define IDC_LOCKSLIST                   32926
 #define IDC_LFS_UNLOCK                  32927
+#define IDS_PROC_BROWSEREFS_AHEADBEHIND 32928
 
 // Next default values for new objects
 // 
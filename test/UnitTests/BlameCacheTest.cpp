@@ -0,0 +1,101 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#include "stdafx.h"
+#include "BlameCache.h"
+
+namespace
+{
+CTortoiseGitBlameData::BlameHunk MakeHunk(const wchar_t* hash, int originalLine, int finalLine, int numberOfLines, const wchar_t* filename = L"file.txt")
+{
+	CTortoiseGitBlameData::BlameHunk hunk;
+	hunk.hash = CGitHash::FromHexStr(hash);
+	hunk.originalLine = originalLine;
+	hunk.finalLine = finalLine;
+	hunk.numberOfLines = numberOfLines;
+	hunk.filename = filename;
+	return hunk;
+}
+
+constexpr auto ancestorHash = L"1111111111111111111111111111111111111111";
+constexpr auto hashA = L"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa";
+constexpr auto hashB = L"bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb";
+constexpr auto hashC = L"cccccccccccccccccccccccccccccccccccccccc";
+
+// the cached blame of the ancestor's version of the file, which has 9 lines
+const CBlameCache::Hunks ancestorHunks = {
+	MakeHunk(hashA, 10, 1, 3),
+	MakeHunk(hashB, 1, 4, 2, L"old.txt"),
+	MakeHunk(hashC, 7, 6, 4),
+};
+
+void ExpectHunk(const CTortoiseGitBlameData::BlameHunk& expected, const CTortoiseGitBlameData::BlameHunk& actual)
+{
+	EXPECT_EQ(expected.hash, actual.hash);
+	EXPECT_EQ(expected.originalLine, actual.originalLine);
+	EXPECT_EQ(expected.finalLine, actual.finalLine);
+	EXPECT_EQ(expected.numberOfLines, actual.numberOfLines);
+	EXPECT_STREQ(expected.filename, actual.filename);
+}
+}
+
+TEST(CBlameCache, Resolve_WithinOneHunk)
+{
+	// lines 7-8 of the ancestor's version are now lines 2-3
+	CBlameCache::Hunks resolved;
+	EXPECT_TRUE(CBlameCache::Resolve(MakeHunk(ancestorHash, 7, 2, 2), ancestorHunks, resolved));
+	ASSERT_EQ(size_t(1), resolved.size());
+	ExpectHunk(MakeHunk(hashC, 8, 2, 2), resolved[0]);
+}
+
+TEST(CBlameCache, Resolve_AcrossHunks)
+{
+	CBlameCache::Hunks resolved;
+	resolved.push_back(MakeHunk(hashA, 1, 1, 1)); // already resolved hunks are kept
+	EXPECT_TRUE(CBlameCache::Resolve(MakeHunk(ancestorHash, 3, 20, 4), ancestorHunks, resolved));
+	ASSERT_EQ(size_t(4), resolved.size());
+	ExpectHunk(MakeHunk(hashA, 1, 1, 1), resolved[0]);
+	ExpectHunk(MakeHunk(hashA, 12, 20, 1), resolved[1]);
+	ExpectHunk(MakeHunk(hashB, 1, 21, 2, L"old.txt"), resolved[2]);
+	ExpectHunk(MakeHunk(hashC, 7, 23, 1), resolved[3]);
+
+	resolved.clear();
+	EXPECT_TRUE(CBlameCache::Resolve(MakeHunk(ancestorHash, 1, 1, 9), ancestorHunks, resolved));
+	ASSERT_EQ(size_t(3), resolved.size());
+	for (size_t i = 0; i < resolved.size(); ++i)
+		ExpectHunk(ancestorHunks[i], resolved[i]);
+}
+
+TEST(CBlameCache, Resolve_NotCovered)
+{
+	CBlameCache::Hunks resolved;
+	// line 10 does not exist in the ancestor's version
+	EXPECT_FALSE(CBlameCache::Resolve(MakeHunk(ancestorHash, 9, 5, 2), ancestorHunks, resolved));
+	resolved.clear();
+	EXPECT_FALSE(CBlameCache::Resolve(MakeHunk(ancestorHash, 12, 5, 1), ancestorHunks, resolved));
+	resolved.clear();
+	EXPECT_FALSE(CBlameCache::Resolve(MakeHunk(ancestorHash, 0, 5, 1), ancestorHunks, resolved));
+	resolved.clear();
+	EXPECT_FALSE(CBlameCache::Resolve(MakeHunk(ancestorHash, 1, 1, 1), CBlameCache::Hunks(), resolved));
+	resolved.clear();
+
+	// the ancestor's blame has a gap
+	const CBlameCache::Hunks gapHunks = { MakeHunk(hashA, 1, 1, 2), MakeHunk(hashB, 1, 4, 2) };
+	EXPECT_FALSE(CBlameCache::Resolve(MakeHunk(ancestorHash, 2, 1, 2), gapHunks, resolved));
+}
@@ -0,0 +1,274 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#include "stdafx.h"
+#include "RepositoryFixtures.h"
+#include "GitCommitIndex.h"
+
+class GitCommitIndexCBasicGitWithTestRepoFixture : public CBasicGitWithTestRepoFixture
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(GitCommitIndex, GitCommitIndexCBasicGitWithTestRepoFixture, testing::Values(LIBGIT2));
+
+static void CheckIndex(const CGitCommitIndex& index, const CGitHash& master, const CGitHash& originMaster, const CGitHash& simpleConflict)
+{
+	EXPECT_EQ(1, index.IsAncestor(originMaster, master));
+	EXPECT_EQ(0, index.IsAncestor(master, originMaster));
+	EXPECT_EQ(1, index.IsAncestor(master, master));
+	EXPECT_EQ(0, index.IsAncestor(simpleConflict, master));
+	EXPECT_EQ(-1, index.IsAncestor(CGitHash::FromHexStr(L"0123456789012345678901234567890123456789"), master));
+	EXPECT_LT(index.GetGeneration(originMaster), index.GetGeneration(master));
+
+	CGitHash base;
+	EXPECT_TRUE(index.GetMergeBase(master, originMaster, base));
+	EXPECT_STREQ(L"a9d53b535cb49640a6099860ac4999f5a0857b91", base.ToString());
+	EXPECT_TRUE(index.GetMergeBase(master, simpleConflict, base));
+	EXPECT_STREQ(L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8", base.ToString());
+
+	std::vector<bool> contains;
+	EXPECT_TRUE(index.GetContaining(originMaster, { master, originMaster }, contains));
+	ASSERT_EQ(2U, contains.size());
+	EXPECT_TRUE(contains[0]);
+	EXPECT_TRUE(contains[1]);
+	EXPECT_TRUE(index.GetContaining(master, { simpleConflict, originMaster, master }, contains));
+	ASSERT_EQ(3U, contains.size());
+	EXPECT_FALSE(contains[0]);
+	EXPECT_FALSE(contains[1]);
+	EXPECT_TRUE(contains[2]);
+	EXPECT_TRUE(index.GetContaining(CGitHash::FromHexStr(L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8"), { master, simpleConflict }, contains));
+	ASSERT_EQ(2U, contains.size());
+	EXPECT_TRUE(contains[0]);
+	EXPECT_TRUE(contains[1]);
+}
+
+TEST_P(GitCommitIndexCBasicGitWithTestRepoFixture, IndexAndQuery)
+{
+	CGitHash master, originMaster, simpleConflict;
+	EXPECT_EQ(0, m_Git.GetHash(master, L"master"));
+	EXPECT_EQ(0, m_Git.GetHash(originMaster, L"origin/master"));
+	EXPECT_EQ(0, m_Git.GetHash(simpleConflict, L"simple-conflict"));
+
+	CString adminDir;
+	ASSERT_TRUE(GitAdminDir::GetAdminDirPath(m_Dir.GetTempDir(), adminDir));
+	CAutoRepository repo(m_Git.GetGitRepository());
+	ASSERT_TRUE(repo);
+
+	CGitCommitIndex index;
+	index.Load(adminDir);
+	ASSERT_TRUE(index.IsEnabled());
+	EXPECT_EQ(0U, index.GetCount());
+	EXPECT_EQ(0U, index.GetGeneration(master));
+
+	EXPECT_TRUE(index.Update(repo, { master, originMaster, simpleConflict }));
+	const size_t count = index.GetCount();
+	EXPECT_LT(0U, count);
+	CheckIndex(index, master, originMaster, simpleConflict);
+	EXPECT_TRUE(index.Save());
+	EXPECT_TRUE(PathFileExists(adminDir + L"tortoisegit.commitindex"));
+
+	// incremental update: only the history of master first, then the rest is appended
+	{
+		DeleteFile(adminDir + L"tortoisegit.commitindex");
+		CGitCommitIndex partial;
+		partial.Load(adminDir);
+		EXPECT_TRUE(partial.Update(repo, { master }));
+		EXPECT_TRUE(partial.Save());
+		EXPECT_GT(count, partial.GetCount());
+	}
+	{
+		CGitCommitIndex reloaded;
+		reloaded.Load(adminDir);
+		EXPECT_LT(0U, reloaded.GetCount());
+		EXPECT_TRUE(reloaded.Update(repo, { originMaster, simpleConflict }));
+		EXPECT_EQ(count, reloaded.GetCount());
+		EXPECT_TRUE(reloaded.Save());
+	}
+	CGitCommitIndex reloaded;
+	reloaded.Load(adminDir);
+	EXPECT_EQ(count, reloaded.GetCount());
+	CheckIndex(reloaded, master, originMaster, simpleConflict);
+
+	// a broken index is discarded from the first invalid record on, records added later must not end up behind the broken one
+	for (const auto& garbage : { std::string("broken"), std::string(GIT_HASH_SIZE, 'x') + std::string(4, '\xff') })
+	{
+		DeleteFile(adminDir + L"tortoisegit.commitindex");
+		CGitCommitIndex partial;
+		partial.Load(adminDir);
+		EXPECT_TRUE(partial.Update(repo, { master }));
+		EXPECT_TRUE(partial.Save());
+		{
+			CAutoFILE pFile = _wfsopen(adminDir + L"tortoisegit.commitindex", L"ab", _SH_DENYWR);
+			ASSERT_TRUE(pFile);
+			fwrite(garbage.data(), 1, garbage.size(), pFile);
+		}
+		reloaded.Load(adminDir);
+		EXPECT_EQ(partial.GetCount(), reloaded.GetCount());
+		EXPECT_TRUE(reloaded.Update(repo, { originMaster, simpleConflict }));
+		EXPECT_TRUE(reloaded.Save());
+		reloaded.Load(adminDir);
+		EXPECT_EQ(count, reloaded.GetCount());
+		CheckIndex(reloaded, master, originMaster, simpleConflict);
+	}
+
+	// an update reads a limited number of commits, what it indexed until then is complete and can be stored
+	{
+		DeleteFile(adminDir + L"tortoisegit.commitindex");
+		CGitCommitIndex limited;
+		limited.Load(adminDir);
+		EXPECT_FALSE(limited.Update(repo, { master, originMaster, simpleConflict }, 2));
+		EXPECT_GE(2U, limited.GetCount());
+		EXPECT_TRUE(limited.Save());
+
+		CGitCommitIndex fresh;
+		fresh.Load(adminDir);
+		EXPECT_EQ(limited.GetCount(), fresh.GetCount());
+		EXPECT_TRUE(fresh.Update(repo, { master, originMaster, simpleConflict }));
+		EXPECT_EQ(count, fresh.GetCount());
+		EXPECT_TRUE(fresh.Save());
+	}
+	{
+		CGitCommitIndex fresh;
+		fresh.Load(adminDir);
+		EXPECT_EQ(count, fresh.GetCount());
+		CheckIndex(fresh, master, originMaster, simpleConflict);
+	}
+
+	// a cancelled update stops before reading any commit
+	{
+		DeleteFile(adminDir + L"tortoisegit.commitindex");
+		CGitCommitIndex cancelled;
+		cancelled.Load(adminDir);
+		volatile LONG cancel = TRUE;
+		EXPECT_FALSE(cancelled.Update(repo, { master }, SIZE_MAX, &cancel));
+		EXPECT_EQ(0U, cancelled.GetCount());
+	}
+
+	// not used for shallow repositories
+	CString shallowFile = adminDir + L"shallow";
+	{
+		CAutoFILE pFile = _wfsopen(shallowFile, L"wb", _SH_DENYWR);
+		ASSERT_TRUE(pFile);
+	}
+	reloaded.Load(adminDir);
+	EXPECT_FALSE(reloaded.IsEnabled());
+	EXPECT_FALSE(reloaded.Update(repo, { master }));
+	DeleteFile(shallowFile);
+
+	// CGit falls back to libgit2 if the index cannot be used (yet), so the results must not differ
+	DeleteFile(adminDir + L"tortoisegit.commitindex");
+	CGitHash commonAncestor;
+	EXPECT_TRUE(m_Git.IsFastForward(L"origin/master", L"master", &commonAncestor));
+	EXPECT_STREQ(L"a9d53b535cb49640a6099860ac4999f5a0857b91", commonAncestor.ToString());
+	EXPECT_FALSE(m_Git.IsFastForward(L"simple-conflict", L"master", &commonAncestor));
+	EXPECT_STREQ(L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8", commonAncestor.ToString());
+
+	// the commits indexed by the queries are stored right away, so that another process can use them
+	CGitCommitIndex fresh;
+	fresh.Load(adminDir);
+	EXPECT_LT(0U, fresh.GetCount());
+	EXPECT_EQ(1, fresh.IsAncestor(originMaster, master));
+	EXPECT_EQ(0, fresh.IsAncestor(simpleConflict, master));
+}
+
+static void CheckBitmap(const CGitCommitIndex& index, const CGitCommitIndex::Bitmap& bitmap, const CGitHash& master, const CGitHash& originMaster, const CGitHash& simpleConflict)
+{
+	EXPECT_EQ(master, bitmap.tip);
+	EXPECT_EQ(1, index.IsReachable(bitmap, master));
+	EXPECT_EQ(1, index.IsReachable(bitmap, originMaster));
+	EXPECT_EQ(1, index.IsReachable(bitmap, CGitHash::FromHexStr(L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8")));
+	EXPECT_EQ(0, index.IsReachable(bitmap, simpleConflict));
+	EXPECT_EQ(-1, index.IsReachable(bitmap, CGitHash::FromHexStr(L"0123456789012345678901234567890123456789")));
+}
+
+TEST_P(GitCommitIndexCBasicGitWithTestRepoFixture, ReachabilityBitmaps)
+{
+	CGitHash master, originMaster, simpleConflict;
+	EXPECT_EQ(0, m_Git.GetHash(master, L"master"));
+	EXPECT_EQ(0, m_Git.GetHash(originMaster, L"origin/master"));
+	EXPECT_EQ(0, m_Git.GetHash(simpleConflict, L"simple-conflict"));
+
+	CString adminDir;
+	ASSERT_TRUE(GitAdminDir::GetAdminDirPath(m_Dir.GetTempDir(), adminDir));
+	CAutoRepository repo(m_Git.GetGitRepository());
+	ASSERT_TRUE(repo);
+
+	{
+		CGitCommitIndex index;
+		index.Load(adminDir);
+		EXPECT_TRUE(index.Update(repo, { master, originMaster, simpleConflict }));
+		EXPECT_EQ(nullptr, index.GetReachabilityBitmap(L"HEAD", CGitHash::FromHexStr(L"0123456789012345678901234567890123456789")));
+
+		// a ref which moves forward keeps its bitmap up to date
+		auto bitmap = index.GetReachabilityBitmap(L"HEAD", originMaster);
+		ASSERT_NE(nullptr, bitmap);
+		EXPECT_EQ(0, index.IsReachable(*bitmap, master));
+		bitmap = index.GetReachabilityBitmap(L"HEAD", master);
+		ASSERT_NE(nullptr, bitmap);
+		CheckBitmap(index, *bitmap, master, originMaster, simpleConflict);
+		// run-length encoded, the reachable commits are not scattered in this history
+		EXPECT_GT(index.GetCount(), bitmap->runEnds.size());
+		EXPECT_TRUE(index.Save());
+		EXPECT_TRUE(PathFileExists(adminDir + L"tortoisegit.commitindex-bitmaps"));
+	}
+
+	// the stored bitmap is used by other instances, an unknown ref gets computed
+	{
+		CGitCommitIndex index;
+		index.Load(adminDir);
+		auto bitmap = index.GetReachabilityBitmap(L"HEAD", master);
+		ASSERT_NE(nullptr, bitmap);
+		CheckBitmap(index, *bitmap, master, originMaster, simpleConflict);
+		bitmap = index.GetReachabilityBitmap(L"refs/heads/simple-conflict", simpleConflict);
+		ASSERT_NE(nullptr, bitmap);
+		EXPECT_EQ(1, index.IsReachable(*bitmap, simpleConflict));
+		EXPECT_EQ(0, index.IsReachable(*bitmap, master));
+	}
+
+	// an index which is written anew in another order gets a new id, so the stored bitmaps are dropped
+	DeleteFile(adminDir + L"tortoisegit.commitindex");
+	{
+		CGitCommitIndex index;
+		index.Load(adminDir);
+		EXPECT_TRUE(index.Update(repo, { simpleConflict, originMaster, master }));
+		EXPECT_TRUE(index.Save());
+	}
+	{
+		CGitCommitIndex index;
+		index.Load(adminDir);
+		auto bitmap = index.GetReachabilityBitmap(L"HEAD", master);
+		ASSERT_NE(nullptr, bitmap);
+		CheckBitmap(index, *bitmap, master, originMaster, simpleConflict);
+	}
+
+	// a broken bitmap file is ignored
+	{
+		CAutoFILE pFile = _wfsopen(adminDir + L"tortoisegit.commitindex-bitmaps", L"wb", _SH_DENYWR);
+		ASSERT_TRUE(pFile);
+		fwrite("broken", 1, 6, pFile);
+	}
+	{
+		CGitCommitIndex index;
+		index.Load(adminDir);
+		auto bitmap = index.GetReachabilityBitmap(L"HEAD", master);
+		ASSERT_NE(nullptr, bitmap);
+		CheckBitmap(index, *bitmap, master, originMaster, simpleConflict);
+		EXPECT_TRUE(index.Save());
+	}
+}
@@ -0,0 +1,89 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#include "stdafx.h"
+#include "Git.h"
+#include "GitLineSplitter.h"
+
+static std::vector<std::string> SplitInChunks(const std::string& data, size_t chunkSize)
+{
+	std::vector<std::string> lines;
+	CGitLineSplitter splitter;
+	auto onLine = [&lines](std::string_view line) { lines.emplace_back(line); };
+	for (size_t pos = 0; pos < data.size(); pos += chunkSize)
+		splitter.Feed(data.data() + pos, min(chunkSize, data.size() - pos), onLine);
+	splitter.Finish(onLine);
+	return lines;
+}
+
+TEST(CGitLineSplitter, Split)
+{
+	const std::vector<std::string> expected = { "first line", "", "third line\r", "last line without newline" };
+	const std::string data = "first line\n\nthird line\r\nlast line without newline";
+	// lines spanning several chunks, chunks containing several lines and everything in between
+	for (size_t chunkSize = 1; chunkSize <= data.size(); ++chunkSize)
+		EXPECT_EQ(expected, SplitInChunks(data, chunkSize)) << "chunk size " << chunkSize;
+
+	EXPECT_EQ(std::vector<std::string>({ "a", "b" }), SplitInChunks("a\nb\n", 3));
+	EXPECT_TRUE(SplitInChunks("", 1).empty());
+	EXPECT_EQ(std::vector<std::string>({ "" }), SplitInChunks("\n", 1));
+}
+
+TEST(CGitLineSplitter, GitCallCb)
+{
+	std::vector<CStringA> lines;
+	CGitCallCb call(L"", [&lines](const CStringA& line) { lines.push_back(line); });
+	call.OnOutputData("one\ntw", 6);
+	call.OnOutputData("o\nthree", 7);
+	call.OnEnd();
+	EXPECT_EQ(std::vector<CStringA>({ "one", "two", "three" }), lines);
+
+	std::vector<std::string> views;
+	CGitCallCb viewCall(L"", [&views](std::string_view line) { views.emplace_back(line); });
+	viewCall.OnOutputData("one\ntw", 6);
+	viewCall.OnOutputData("o\n", 2);
+	viewCall.OnEnd();
+	EXPECT_EQ(std::vector<std::string>({ "one", "two" }), views);
+}
+
+// Throughput benchmark, run with --gtest_also_run_disabled_tests
+TEST(CGitLineSplitter, DISABLED_Throughput)
+{
+	// something similar to the output of "git log --raw", fed in the chunk size CGit::Run() reads
+	std::string chunk;
+	while (chunk.size() < 64 * 1024)
+		chunk += ":100644 100644 7c3cbfe13a929d2291a574dca45e4fd2c2a5dbd 7c3cbfe13a929d2291a574dca45e4fd2c2a5dbd M\tsrc/some/directory/file.cpp\n";
+	constexpr size_t totalSize = 512 * 1024 * 1024;
+	const size_t chunks = totalSize / chunk.size();
+
+	size_t lines = 0, bytes = 0;
+	CGitCallCb call(L"", [&](std::string_view line) { ++lines; bytes += line.size(); });
+	LARGE_INTEGER start, end, frequency;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	for (size_t i = 0; i < chunks; ++i)
+		call.OnOutputData(chunk.data(), chunk.size());
+	call.OnEnd();
+	QueryPerformanceCounter(&end);
+
+	const double seconds = static_cast<double>(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+	EXPECT_EQ(chunks * chunk.size(), bytes + lines);
+	const double mebibytes = static_cast<double>(chunks * chunk.size()) / (1024 * 1024);
+	printf("split %.0f MiB into %zu lines in %.3f s (%.0f MiB/s)\n", mebibytes, lines, seconds, mebibytes / seconds);
+}
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2015-2020, 2025 - TortoiseGit
+// Copyright (C) 2015-2020, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -87,8 +87,8 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
 	EXPECT_FALSE(list[0].IsDirectory());
@@ -103,8 +103,8 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
 	rev.Clear();
@@ -121,26 +121,26 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
 	EXPECT_STREQ(L"copy/utf16-be-nobom.txt", list[1].GetGitPathString());
 	EXPECT_STREQ(L"", list[1].GetGitOldPathString());
-	EXPECT_STREQ(L"-", list[1].m_StatAdd);
-	EXPECT_STREQ(L"-", list[1].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatDel);
 	EXPECT_EQ(0, list[1].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
 	EXPECT_STREQ(L"copy/utf8-bom.txt", list[2].GetGitPathString());
 	EXPECT_STREQ(L"", list[2].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[2].m_StatAdd);
-	EXPECT_STREQ(L"1", list[2].m_StatDel);
+	EXPECT_EQ(1, list[2].m_StatAdd);
+	EXPECT_EQ(1, list[2].m_StatDel);
 	EXPECT_EQ(0, list[2].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[2].m_Action);
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[3].GetGitPathString());
 	EXPECT_STREQ(L"", list[3].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[3].m_StatAdd);
-	EXPECT_STREQ(L"1", list[3].m_StatDel);
+	EXPECT_EQ(1, list[3].m_StatAdd);
+	EXPECT_EQ(1, list[3].m_StatDel);
 	EXPECT_EQ(0, list[3].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[3].m_Action);
 	rev.Clear();
@@ -151,8 +151,8 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"newfiles3.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
 	EXPECT_FALSE(list[0].IsDirectory());
@@ -164,15 +164,15 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"newfiles.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"newfiles.txt", list[1].GetGitPathString());
 	EXPECT_STREQ(L"", list[1].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"1", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(1, list[1].m_StatDel);
 	EXPECT_EQ(1, list[1].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
 	EXPECT_FALSE(list[1].IsDirectory());
@@ -191,29 +191,29 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"newfiles2 - Cöpy.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"utf16-be-nobom.txt", list[1].GetGitPathString()); // changed from file to symlink
 	EXPECT_STREQ(L"", list[1].GetGitOldPathString());
-	EXPECT_STREQ(L"-", list[1].m_StatAdd);
-	EXPECT_STREQ(L"-", list[1].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatDel);
 	EXPECT_EQ(0, list[1].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_STREQ(L"utf8-bom.txt", list[2].GetGitPathString());
 	EXPECT_STREQ(L"", list[2].GetGitOldPathString());
-	EXPECT_STREQ(L"0", list[2].m_StatAdd);
-	EXPECT_STREQ(L"9", list[2].m_StatDel);
+	EXPECT_EQ(0, list[2].m_StatAdd);
+	EXPECT_EQ(9, list[2].m_StatDel);
 	EXPECT_EQ(0, list[2].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[2].m_Action);
 	EXPECT_FALSE(list[2].IsDirectory());
 	EXPECT_STREQ(L"was-ansi.txt", list[3].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[3].GetGitOldPathString());
-	EXPECT_STREQ(L"0", list[3].m_StatAdd);
-	EXPECT_STREQ(L"0", list[3].m_StatDel);
+	EXPECT_EQ(0, list[3].m_StatAdd);
+	EXPECT_EQ(0, list[3].m_StatDel);
 	EXPECT_EQ(0, list[3].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[3].m_Action);
 	EXPECT_FALSE(list[3].IsDirectory());
@@ -225,29 +225,29 @@ static void SafeFetchFullInfo(CGit* cGit)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"it-was-ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[0].m_Action);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_STREQ(L"newfiles2 - Cöpy.txt", list[1].GetGitPathString());
 	EXPECT_STREQ(L"", list[1].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"0", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(0, list[1].m_StatDel);
 	EXPECT_EQ(0, list[1].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_STREQ(L"utf16-be-nobom.txt", list[2].GetGitPathString()); // changed from file to symlink
 	EXPECT_STREQ(L"", list[2].GetGitOldPathString());
-	EXPECT_STREQ(L"-", list[2].m_StatAdd);
-	EXPECT_STREQ(L"-", list[2].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[2].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[2].m_StatDel);
 	EXPECT_EQ(0, list[2].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[2].m_Action);
 	EXPECT_FALSE(list[2].IsDirectory());
 	EXPECT_STREQ(L"utf8-bom.txt", list[3].GetGitPathString());
 	EXPECT_STREQ(L"", list[3].GetGitOldPathString());
-	EXPECT_STREQ(L"0", list[3].m_StatAdd);
-	EXPECT_STREQ(L"9", list[3].m_StatDel);
+	EXPECT_EQ(0, list[3].m_StatAdd);
+	EXPECT_EQ(9, list[3].m_StatDel);
 	EXPECT_EQ(0, list[3].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[3].m_Action);
 	EXPECT_FALSE(list[3].IsDirectory());
@@ -276,8 +276,8 @@ static void SafeFetchFullInfo_Submodule(CGit* cGit, config testConfig)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
 	EXPECT_TRUE(list[0].IsDirectory());
@@ -290,8 +290,8 @@ static void SafeFetchFullInfo_Submodule(CGit* cGit, config testConfig)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
 	EXPECT_TRUE(list[0].IsDirectory());
@@ -304,8 +304,8 @@ static void SafeFetchFullInfo_Submodule(CGit* cGit, config testConfig)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
 	EXPECT_TRUE(list[0].IsDirectory());
@@ -320,13 +320,13 @@ static void SafeFetchFullInfo_Submodule(CGit* cGit, config testConfig)
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	if (testConfig == LIBGIT2_ALL) // TODO: libgit behaves differently here
 	{
-		EXPECT_STREQ(L"-", list[0].m_StatAdd);
-		EXPECT_STREQ(L"-", list[0].m_StatDel);
+		EXPECT_EQ(CTGitPath::STAT_BINARY, list[0].m_StatAdd);
+		EXPECT_EQ(CTGitPath::STAT_BINARY, list[0].m_StatDel);
 	}
 	else
 	{
-		EXPECT_STREQ(L"1", list[0].m_StatAdd);
-		EXPECT_STREQ(L"1", list[0].m_StatDel);
+		EXPECT_EQ(1, list[0].m_StatAdd);
+		EXPECT_EQ(1, list[0].m_StatDel);
 	}
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
@@ -342,13 +342,13 @@ static void SafeFetchFullInfo_Submodule(CGit* cGit, config testConfig)
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	if (testConfig == LIBGIT2_ALL) // TODO: libgit behaves differently here
 	{
-		EXPECT_STREQ(L"-", list[0].m_StatAdd);
-		EXPECT_STREQ(L"-", list[0].m_StatDel);
+		EXPECT_EQ(CTGitPath::STAT_BINARY, list[0].m_StatAdd);
+		EXPECT_EQ(CTGitPath::STAT_BINARY, list[0].m_StatDel);
 	}
 	else
 	{
-		EXPECT_STREQ(L"1", list[0].m_StatAdd);
-		EXPECT_STREQ(L"1", list[0].m_StatDel);
+		EXPECT_EQ(1, list[0].m_StatAdd);
+		EXPECT_EQ(1, list[0].m_StatDel);
 	}
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
@@ -362,15 +362,15 @@ static void SafeFetchFullInfo_Submodule(CGit* cGit, config testConfig)
 	list = rev.GetFiles(nullptr).m_files;
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_EQ(0, list[0].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
 	EXPECT_TRUE(list[0].IsDirectory());
 	EXPECT_STREQ(L"something", list[1].GetGitPathString());
 	EXPECT_STREQ(L"", list[1].GetGitOldPathString());
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"1", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(1, list[1].m_StatDel);
 	EXPECT_EQ(1, list[1].m_ParentNo);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
 	EXPECT_TRUE(list[1].IsDirectory());
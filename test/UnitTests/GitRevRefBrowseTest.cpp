@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2015-2020, 2024 - TortoiseGit
+// Copyright (C) 2015-2020, 2024, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -32,6 +32,31 @@ class GitRevRefBrowserCBasicGitWithTestRepoBareFixture : public CBasicGitWithTes
 INSTANTIATE_TEST_SUITE_P(GitRevRefBrowser, GitRevRefBrowserCBasicGitWithTestRepoFixture, testing::Values(GIT_CLI));
 INSTANTIATE_TEST_SUITE_P(GitRevRefBrowser, GitRevRefBrowserCBasicGitWithTestRepoBareFixture, testing::Values(GIT_CLI));
 
+class GitRevRefBrowserMergeFilterCBasicGitWithTestRepoFixture : public CBasicGitWithTestRepoFixture
+{
+};
+
+INSTANTIATE_TEST_SUITE_P(GitRevRefBrowser, GitRevRefBrowserMergeFilterCBasicGitWithTestRepoFixture, testing::Values(GIT_CLI, LIBGIT2));
+
+static void GetGitRevRefMapMergeFilter()
+{
+	MAP_REF_GITREVREFBROWSER refMap;
+	CString err;
+	EXPECT_EQ(0, GitRevRefBrowser::GetGitRevRefMap(refMap, 1, err));
+	EXPECT_STREQ(L"", err);
+	EXPECT_EQ(6U, refMap.size());
+	for (const auto& branch : { L"refs/heads/master", L"refs/heads/master2", L"refs/remotes/origin/master", L"refs/tags/all-files-signed", L"refs/tags/also-signed", L"refs/tags/normal-tag" })
+		EXPECT_TRUE(refMap.find(branch) != refMap.end());
+
+	refMap.clear();
+	EXPECT_EQ(0, GitRevRefBrowser::GetGitRevRefMap(refMap, 2, err));
+	EXPECT_STREQ(L"", err);
+	EXPECT_EQ(6U, refMap.size());
+	EXPECT_TRUE(refMap.find(L"refs/heads/master") == refMap.end());
+	for (const auto& branch : { L"refs/heads/forconflict", L"refs/heads/signed-commit", L"refs/heads/simple-conflict", L"refs/heads/subdir/branch", L"refs/notes/commits", L"refs/stash" })
+		EXPECT_TRUE(refMap.find(branch) != refMap.end());
+}
+
 static void GetGitRevRefMap()
 {
 	g_Git.SetConfigValue(L"branch.master.description", L"test");
@@ -51,6 +76,17 @@ static void GetGitRevRefMap()
 	EXPECT_STREQ(L"2015-03-07 18:03:58", rev.GetCommitterDate().FormatGmt(L"%Y-%m-%d %H:%M:%S"));
 	EXPECT_STREQ(L"Changed ASCII file", rev.GetSubject());
 	EXPECT_STREQ(L"refs/remotes/origin/master", rev.m_UpstreamRef);
+	{
+		CAutoRepository repo(g_Git.GetGitRepository());
+		ASSERT_TRUE(repo.IsValid());
+		git_oid upstream;
+		ASSERT_EQ(0, git_reference_name_to_id(&upstream, repo, "refs/remotes/origin/master"));
+		size_t ahead = 0, behind = 0;
+		EXPECT_EQ(0, git_graph_ahead_behind(&ahead, &behind, repo, rev.m_CommitHash, &upstream));
+		EXPECT_LT(0U, ahead);
+		EXPECT_EQ(ahead, rev.m_Ahead);
+		EXPECT_EQ(behind, rev.m_Behind);
+	}
 	EXPECT_STREQ(L"test", rev.m_Description);
 
 	rev = refMap[L"refs/heads/signed-commit"];
@@ -91,20 +127,7 @@ static void GetGitRevRefMap()
 	for (auto it = refMap.cbegin(); it != refMap.cend(); ++it)
 		EXPECT_TRUE(CStringUtils::StartsWith(it->first, L"refs/heads/"));
 
-	refMap.clear();
-	EXPECT_EQ(0, GitRevRefBrowser::GetGitRevRefMap(refMap, 1, err));
-	EXPECT_STREQ(L"", err);
-	EXPECT_EQ(6U, refMap.size());
-	for (const auto& branch : { L"refs/heads/master", L"refs/heads/master2", L"refs/remotes/origin/master", L"refs/tags/all-files-signed", L"refs/tags/also-signed", L"refs/tags/normal-tag" })
-		EXPECT_TRUE(refMap.find(branch) != refMap.end());
-
-	refMap.clear();
-	EXPECT_EQ(0, GitRevRefBrowser::GetGitRevRefMap(refMap, 2, err));
-	EXPECT_STREQ(L"", err);
-	EXPECT_EQ(6U, refMap.size());
-	EXPECT_TRUE(refMap.find(L"refs/heads/master") == refMap.end());
-	for (const auto& branch : { L"refs/heads/forconflict", L"refs/heads/signed-commit", L"refs/heads/simple-conflict", L"refs/heads/subdir/branch", L"refs/notes/commits", L"refs/stash" })
-		EXPECT_TRUE(refMap.find(branch) != refMap.end());
+	GetGitRevRefMapMergeFilter();
 }
 
 TEST_P(GitRevRefBrowserCBasicGitWithTestRepoFixture, GetGitRevRefMap)
@@ -116,3 +139,11 @@ TEST_P(GitRevRefBrowserCBasicGitWithTestRepoBareFixture, GetGitRevRefMap)
 {
 	GetGitRevRefMap();
 }
+
+TEST_P(GitRevRefBrowserMergeFilterCBasicGitWithTestRepoFixture, GetGitRevRefMapMergeFilter)
+{
+	GetGitRevRefMapMergeFilter();
+
+	// a second call reuses the reachability bitmap of HEAD
+	GetGitRevRefMapMergeFilter();
+}
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2015-2021, 2023, 2025 - TortoiseGit
+// Copyright (C) 2015-2021, 2023, 2025-2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -21,6 +21,7 @@
 #include "Git.h"
 #include "StringUtils.h"
 #include "RepositoryFixtures.h"
+#include "GitBatchHelper.h"
 
 // For performance reason, turn LIBGIT off by default,
 INSTANTIATE_TEST_SUITE_P(CGit, CBasicGitWithEmptyRepositoryFixture, testing::Values(GIT_CLI, /*LIBGIT,*/ LIBGIT2, LIBGIT2_ALL));
@@ -1644,7 +1645,7 @@ TEST_P(CBasicGitWithTestRepoFixture, Config)
 
 TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 {
-	if (GetParam() != 0)
+	if (GetParam() != LIBGIT2_ALL && GetParam() != GIT_CLI)
 		return;
 
 	// adding ansi2.txt (as a copy of ansi.txt) produces a warning
@@ -1685,8 +1686,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, &filter, true, true));
@@ -1695,8 +1696,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 
@@ -1715,8 +1716,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter));
@@ -1733,8 +1734,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, &filter, true, true));
@@ -1742,8 +1743,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 
@@ -1797,8 +1798,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -1877,13 +1878,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"utf8-bom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -1948,8 +1949,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[1].GetGitPathString());
@@ -1972,8 +1973,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -1981,8 +1982,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -1991,13 +1992,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"utf8-nobom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter, false));
@@ -2011,8 +2012,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter, true, true));
@@ -2020,8 +2021,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -2035,27 +2036,27 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"utf8-nobom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, &filter, true, true));
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	EXPECT_STREQ(L"utf8-nobom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[1].m_stagingStatus);
 
@@ -2154,8 +2155,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -2163,8 +2164,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::PartiallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -2173,13 +2174,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter));
@@ -2187,8 +2188,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, &filter, false));
@@ -2196,8 +2197,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, &filter, false, true));
@@ -2205,8 +2206,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::PartiallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -2215,13 +2216,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, &filter, true, true));
@@ -2229,14 +2230,14 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	EXPECT_STREQ(L"copy/utf8-nobom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::PartiallyStaged, list[1].m_stagingStatus);
 
@@ -2252,16 +2253,16 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_MISSING, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_MISSING, list.GetAction());
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_MISSING, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyUnstaged, list[0].m_stagingStatus);
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, nullptr));
@@ -2323,16 +2324,16 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list.GetAction());
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, nullptr));
@@ -2394,8 +2395,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -2403,8 +2404,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list.GetAction());
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -2413,13 +2414,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED | CTGitPath::LOGACTIONS_DELETED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"copy/ansi.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[1].m_Action);
-	EXPECT_STREQ(L"0", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(0, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter));
@@ -2482,8 +2483,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -2491,8 +2492,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list.GetAction());
 	EXPECT_STREQ(L"copy/ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -2501,13 +2502,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED | CTGitPath::LOGACTIONS_DELETED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"copy/ansi.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[1].m_Action);
-	EXPECT_STREQ(L"0", list[1].m_StatAdd);
-	EXPECT_STREQ(L"9", list[1].m_StatDel);
+	EXPECT_EQ(0, list[1].m_StatAdd);
+	EXPECT_EQ(9, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter));
@@ -2568,8 +2569,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"änsi2.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -2590,8 +2591,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"änsi2.txt", list[1].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[1].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[1].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter, false));
@@ -2774,8 +2775,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"änsi2.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[0].m_Action);
-	//EXPECT_STREQ(L"9", list[0].m_StatAdd);
-	//EXPECT_STREQ(L"0", list[0].m_StatDel);
+	//EXPECT_EQ(9, list[0].m_StatAdd);
+	//EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -2784,8 +2785,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"änsi2.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[0].m_Action);
-	//EXPECT_STREQ(L"9", list[0].m_StatAdd);
-	//EXPECT_STREQ(L"0", list[0].m_StatDel);
+	//EXPECT_EQ(9, list[0].m_StatAdd);
+	//EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::PartiallyStaged, list[0].m_stagingStatus);
 	//EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[1].m_stagingStatus);
@@ -2795,14 +2796,14 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED | CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"änsi2.txt", list[1].GetGitPathString());
 	EXPECT_STREQ(L"ansi.txt", list[1].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, list[1].m_Action);
-	//EXPECT_STREQ(L"9", list[1].m_StatAdd);
-	//EXPECT_STREQ(L"0", list[1].m_StatDel);
+	//EXPECT_EQ(9, list[1].m_StatAdd);
+	//EXPECT_EQ(0, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter, false));
@@ -2876,15 +2877,15 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"änsi2.txt", list[1].GetGitPathString());
 	EXPECT_STREQ(L"", list[1].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -2892,14 +2893,14 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	EXPECT_STREQ(L"änsi2.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
-	EXPECT_STREQ(L"9", list[1].m_StatAdd);
-	EXPECT_STREQ(L"0", list[1].m_StatDel);
+	EXPECT_EQ(9, list[1].m_StatAdd);
+	EXPECT_EQ(0, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[1].m_stagingStatus);
 	list.Clear();
@@ -2908,18 +2909,18 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED | CTGitPath::LOGACTIONS_MODIFIED | CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"9", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(9, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"ascii.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"2", list[1].m_StatAdd);
-	EXPECT_STREQ(L"2", list[1].m_StatDel);
+	EXPECT_EQ(2, list[1].m_StatAdd);
+	EXPECT_EQ(2, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_STREQ(L"änsi2.txt", list[2].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[2].m_Action);
-	EXPECT_STREQ(L"9", list[2].m_StatAdd);
-	EXPECT_STREQ(L"0", list[2].m_StatDel);
+	EXPECT_EQ(9, list[2].m_StatAdd);
+	EXPECT_EQ(0, list[2].m_StatDel);
 	EXPECT_FALSE(list[2].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter, false));
@@ -3001,8 +3002,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/test-file.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -3010,8 +3011,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"copy/test-file.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -3020,13 +3021,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED | CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"copy/test-file.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"0", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(0, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter));
@@ -3090,8 +3091,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"copy/test-file.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -3099,8 +3100,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"copy/test-file.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::PartiallyStaged, list[0].m_stagingStatus);
 	list.Clear();
@@ -3109,13 +3110,13 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED | CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"ascii.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"2", list[0].m_StatAdd);
-	EXPECT_STREQ(L"2", list[0].m_StatDel);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"copy/test-file.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
-	EXPECT_STREQ(L"1", list[1].m_StatAdd);
-	EXPECT_STREQ(L"0", list[1].m_StatDel);
+	EXPECT_EQ(1, list[1].m_StatAdd);
+	EXPECT_EQ(0, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter));
@@ -3178,8 +3179,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"ansi2.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"9", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(9, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -3373,8 +3374,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_STREQ(L"", list[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"6", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(6, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -3497,7 +3498,7 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges)
 
 TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_DeletedRemotely)
 {
-	if (GetParam() != 0)
+	if (GetParam() != LIBGIT2_ALL && GetParam() != GIT_CLI)
 		return;
 
 	CString output;
@@ -3528,38 +3529,38 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"utf16-be-bom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"-", list[1].m_StatAdd);
-	EXPECT_STREQ(L"-", list[1].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_STREQ(L"utf16-be-nobom.txt", list[2].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[2].m_Action);
-	EXPECT_STREQ(L"-", list[2].m_StatAdd);
-	EXPECT_STREQ(L"-", list[2].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[2].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[2].m_StatDel);
 	EXPECT_FALSE(list[2].IsDirectory());
 	EXPECT_STREQ(L"utf16-le-bom.txt", list[3].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[3].m_Action);
-	EXPECT_STREQ(L"-", list[3].m_StatAdd);
-	EXPECT_STREQ(L"-", list[3].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[3].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[3].m_StatDel);
 	EXPECT_FALSE(list[3].IsDirectory());
 	EXPECT_STREQ(L"utf16-le-nobom.txt", list[4].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[4].m_Action);
-	EXPECT_STREQ(L"-", list[4].m_StatAdd);
-	EXPECT_STREQ(L"-", list[4].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[4].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[4].m_StatDel);
 	EXPECT_FALSE(list[4].IsDirectory());
 	EXPECT_STREQ(L"utf8-bom.txt", list[5].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[5].m_Action);
-	EXPECT_STREQ(L"6", list[5].m_StatAdd);
-	EXPECT_STREQ(L"6", list[5].m_StatDel);
+	EXPECT_EQ(6, list[5].m_StatAdd);
+	EXPECT_EQ(6, list[5].m_StatDel);
 	EXPECT_FALSE(list[5].IsDirectory());
 	EXPECT_STREQ(L"utf8-nobom.txt", list[6].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[6].m_Action);
-	EXPECT_STREQ(L"3", list[6].m_StatAdd);
-	EXPECT_STREQ(L"3", list[6].m_StatDel);
+	EXPECT_EQ(3, list[6].m_StatAdd);
+	EXPECT_EQ(3, list[6].m_StatDel);
 	EXPECT_FALSE(list[6].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, nullptr));
@@ -3567,23 +3568,23 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_STREQ(L"utf16-be-bom.txt", list[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[1].m_Action);
-	EXPECT_STREQ(L"-", list[1].m_StatAdd);
-	EXPECT_STREQ(L"-", list[1].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[1].m_StatDel);
 	EXPECT_FALSE(list[1].IsDirectory());
 	EXPECT_STREQ(L"utf16-be-nobom.txt", list[2].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[2].m_Action);
-	EXPECT_STREQ(L"-", list[2].m_StatAdd);
-	EXPECT_STREQ(L"-", list[2].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[2].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[2].m_StatDel);
 	EXPECT_FALSE(list[2].IsDirectory());
 	EXPECT_STREQ(L"utf16-le-bom.txt", list[3].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[3].m_Action);
-	EXPECT_STREQ(L"-", list[3].m_StatAdd);
-	EXPECT_STREQ(L"-", list[3].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[3].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, list[3].m_StatDel);
 	EXPECT_FALSE(list[3].IsDirectory());
 	EXPECT_STREQ(L"utf16-le-nobom.txt", list[4].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[4].m_Action);
@@ -3661,7 +3662,7 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 
 TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_DeletedLocally)
 {
-	if (GetParam() != 0)
+	if (GetParam() != LIBGIT2_ALL && GetParam() != GIT_CLI)
 		return;
 
 	CString output;
@@ -3689,8 +3690,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_ADDED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	//EXPECT_STREQ(L"9", list[0].m_StatAdd);
-	//EXPECT_STREQ(L"0", list[0].m_StatDel);
+	//EXPECT_EQ(9, list[0].m_StatAdd);
+	//EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, true, nullptr));
@@ -3698,8 +3699,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"4", list[0].m_StatAdd);
-	EXPECT_STREQ(L"4", list[0].m_StatDel);
+	EXPECT_EQ(4, list[0].m_StatAdd);
+	EXPECT_EQ(4, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, &filter, false));
@@ -3712,8 +3713,8 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED, list[0].m_Action);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
@@ -3722,15 +3723,15 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_DeleteModifyConflict_
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED, list.GetAction());
 	EXPECT_STREQ(L"ansi.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED, list[0].m_Action);
-	EXPECT_STREQ(L"0", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(0, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyUnstaged, list[0].m_stagingStatus);
 }
 
 TEST_P(CBasicGitWithEmptyRepositoryFixture, GetWorkingTreeChanges)
 {
-	if (GetParam() != 0)
+	if (GetParam() != LIBGIT2_ALL && GetParam() != GIT_CLI)
 		return;
 
 	CTGitPathList list;
@@ -3749,8 +3750,8 @@ TEST_P(CBasicGitWithEmptyRepositoryFixture, GetWorkingTreeChanges)
 	// EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list.GetAction()); // we do not care here for the list action, as its only used in GitLogListBase and there we re-calculate it in AsyncDiffThread
 	EXPECT_STREQ(L"test.txt", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"", list[0].m_StatAdd); // TODO: right now no numstat is parsed
-	EXPECT_STREQ(L"", list[0].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, list[0].m_StatAdd); // TODO: right now no numstat is parsed
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -3885,7 +3886,7 @@ static int DoSubmodule(const CString& cmd, CGit& git, const CString& submoduleDi
 
 TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules)
 {
-	if (GetParam() != 0)
+	if (GetParam() != LIBGIT2_ALL && GetParam() != GIT_CLI)
 		return;
 
 	CTGitPathList list;
@@ -3915,8 +3916,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	// EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list.GetAction()); // we do not care here for the list action, as its only used in GitLogListBase and there we re-calculate it in AsyncDiffThread
 	EXPECT_STREQ(L"submodule", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
@@ -3924,8 +3925,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	// EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list.GetAction()); // we do not care here for the list action, as its only used in GitLogListBase and there we re-calculate it in AsyncDiffThread
 	EXPECT_STREQ(L"submodule", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"0", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(0, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::PartiallyStaged, list[0].m_stagingStatus);
 
@@ -3956,16 +3957,16 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyUnstaged, list[0].m_stagingStatus);
 
@@ -3980,16 +3981,16 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 	list.Clear();
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr, true, true));
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 	EXPECT_EQ(CTGitPath::StagingStatus::TotallyUnstaged, list[0].m_stagingStatus);
 
@@ -4011,8 +4012,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	else
 	{
 		EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-		EXPECT_STREQ(L"1", list[0].m_StatAdd);
-		EXPECT_STREQ(L"0", list[0].m_StatDel);
+		EXPECT_EQ(1, list[0].m_StatAdd);
+		EXPECT_EQ(0, list[0].m_StatDel);
 		EXPECT_TRUE(list[0].IsDirectory()); // now a directory is in filesystem
 	}
 	list.Clear();
@@ -4027,8 +4028,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	else
 	{
 		EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_ADDED, list[0].m_Action);
-		EXPECT_STREQ(L"1", list[0].m_StatAdd);
-		EXPECT_STREQ(L"0", list[0].m_StatDel);
+		EXPECT_EQ(1, list[0].m_StatAdd);
+		EXPECT_EQ(0, list[0].m_StatDel);
 		EXPECT_TRUE(list[0].IsDirectory()); // now a directory is in filesystem
 	}
 
@@ -4062,13 +4063,13 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	{
 		EXPECT_STREQ(L"something", list[0].GetGitPathString());
 		EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED, list[0].m_Action);
-		EXPECT_STREQ(L"0", list[0].m_StatAdd);
-		EXPECT_STREQ(L"0", list[0].m_StatDel);
+		EXPECT_EQ(0, list[0].m_StatAdd);
+		EXPECT_EQ(0, list[0].m_StatDel);
 		EXPECT_TRUE(list[0].IsDirectory()); // directory is in filesystem
 		EXPECT_STREQ(L"something~file", list[1].GetGitPathString());
 		EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
-		EXPECT_STREQ(L"1", list[1].m_StatAdd);
-		EXPECT_STREQ(L"0", list[1].m_StatDel);
+		EXPECT_EQ(1, list[1].m_StatAdd);
+		EXPECT_EQ(0, list[1].m_StatDel);
 		EXPECT_FALSE(list[1].IsDirectory()); // alternative file is in filesystem
 	}
 
@@ -4088,8 +4089,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 		ASSERT_EQ(2, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	if (m_Git.ms_LastMsysGitVersion < ConvertVersionToInt(2, 34, 0))
 		EXPECT_FALSE(list[0].IsDirectory()); // file is in filesystem
 	else
@@ -4097,8 +4098,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 		EXPECT_TRUE(list[0].IsDirectory()); // directory is in filesystem
 		EXPECT_STREQ(L"something~HEAD", list[1].GetGitPathString());
 		EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_ADDED, list[1].m_Action);
-		EXPECT_STREQ(L"1", list[1].m_StatAdd);
-		EXPECT_STREQ(L"0", list[1].m_StatDel);
+		EXPECT_EQ(1, list[1].m_StatAdd);
+		EXPECT_EQ(0, list[1].m_StatDel);
 		EXPECT_FALSE(list[1].IsDirectory()); // alternative file is in filesystem
 	}
 
@@ -4115,8 +4116,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_UNMERGED | CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_TRUE(list[0].IsDirectory());
 
 	// test for submodule to file
@@ -4136,8 +4137,8 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 
 	// test for file to submodule
@@ -4161,14 +4162,14 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetWorkingTreeChanges_Submodules
 	ASSERT_EQ(1, list.GetCount());
 	EXPECT_STREQ(L"something", list[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
-	EXPECT_STREQ(L"1", list[0].m_StatAdd);
-	EXPECT_STREQ(L"1", list[0].m_StatDel);
+	EXPECT_EQ(1, list[0].m_StatAdd);
+	EXPECT_EQ(1, list[0].m_StatDel);
 	EXPECT_FALSE(list[0].IsDirectory());
 }
 
 TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_RefreshGitIndex)
 {
-	if (GetParam() != 0)
+	if (GetParam() != LIBGIT2_ALL && GetParam() != GIT_CLI)
 		return;
 
 	// adding ansi2.txt (as a copy of ansi.txt) produces a warning
@@ -4194,7 +4195,7 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_RefreshGitIndex)
 	// START: this is the undesired behavior
 	// this test is just there so we notice when this change somehow
 	EXPECT_EQ(0, m_Git.GetWorkingTreeChanges(list, false, nullptr));
-	if (m_Git.ms_bCygwinGit || m_Git.ms_bMsys2Git)
+	if (m_Git.ms_bCygwinGit || m_Git.ms_bMsys2Git || m_Git.UsingLibGit2(CGit::GIT_CMD_WORKINGTREECHANGES)) // libgit2 compares the content if the stat data differs
 		EXPECT_EQ(0, list.GetCount());
 	else
 		EXPECT_EQ(1, list.GetCount());
@@ -4206,6 +4207,47 @@ TEST_P(CBasicGitWithTestRepoFixture, GetWorkingTreeChanges_RefreshGitIndex)
 	EXPECT_EQ(0, list.GetCount());
 }
 
+TEST_P(CBasicGitWithTestRepoFixture, FillUnRev)
+{
+	CString output;
+	EXPECT_EQ(0, m_Git.Run(L"git.exe reset --hard master", &output, CP_UTF8));
+	EXPECT_STRNE(L"", output);
+
+	CTGitPathList list;
+	EXPECT_EQ(0, list.FillUnRev(CTGitPath::LOGACTIONS_UNVER));
+	EXPECT_TRUE(list.IsEmpty());
+
+	EXPECT_TRUE(CStringUtils::WriteStringToTextFile(m_Git.m_CurrentDir + L"\\untracked-file.txt", L"something"));
+	EXPECT_TRUE(CreateDirectory(m_Git.m_CurrentDir + L"\\untracked-dir", nullptr));
+	EXPECT_TRUE(CStringUtils::WriteStringToTextFile(m_Git.m_CurrentDir + L"\\untracked-dir\\file.txt", L"something"));
+	CreateDirectory(m_Git.m_CurrentDir + L"\\.git\\info", nullptr);
+	EXPECT_TRUE(CStringUtils::WriteStringToTextFile(m_Git.m_CurrentDir + L"\\.git\\info\\exclude", L"*.ignored\n"));
+	EXPECT_TRUE(CStringUtils::WriteStringToTextFile(m_Git.m_CurrentDir + L"\\copy\\file.ignored", L"something"));
+
+	EXPECT_EQ(0, list.FillUnRev(CTGitPath::LOGACTIONS_UNVER));
+	ASSERT_EQ(2, list.GetCount());
+	EXPECT_STREQ(L"untracked-dir/file.txt", list[0].GetGitPathString());
+	EXPECT_EQ(CTGitPath::LOGACTIONS_UNVER, list[0].m_Action);
+	EXPECT_STREQ(L"untracked-file.txt", list[1].GetGitPathString());
+	EXPECT_EQ(CTGitPath::LOGACTIONS_UNVER, list[1].m_Action);
+
+	// all entries of the filter list at once
+	CTGitPathList filter(CTGitPath(L"untracked-dir"));
+	filter.AddPath(CTGitPath(L"copy"));
+	EXPECT_EQ(0, list.FillUnRev(CTGitPath::LOGACTIONS_UNVER, &filter));
+	ASSERT_EQ(1, list.GetCount());
+	EXPECT_STREQ(L"untracked-dir/file.txt", list[0].GetGitPathString());
+
+	EXPECT_EQ(0, list.FillUnRev(CTGitPath::LOGACTIONS_IGNORE));
+	ASSERT_EQ(1, list.GetCount());
+	EXPECT_STREQ(L"copy/file.ignored", list[0].GetGitPathString());
+	EXPECT_EQ(CTGitPath::LOGACTIONS_IGNORE, list[0].m_Action);
+
+	EXPECT_EQ(0, list.FillUnRev(CTGitPath::LOGACTIONS_IGNORE, &filter));
+	ASSERT_EQ(1, list.GetCount());
+	EXPECT_STREQ(L"copy/file.ignored", list[0].GetGitPathString());
+}
+
 TEST_P(CBasicGitWithTestRepoFixture, GetBisectTerms)
 {
 	if (m_Git.ms_bCygwinGit)
@@ -4338,6 +4380,87 @@ TEST_P(CBasicGitWithTestRepoFixture, GetUnifiedDiff)
 	EXPECT_STREQ(L" utf8-nobom.txt | 4 ++--\n 1 file changed, 2 insertions(+), 2 deletions(-)\n\ndiff --git a/utf8-nobom.txt b/utf8-nobom.txt\nindex ffa0d50..c225b3f 100644\n--- a/utf8-nobom.txt\n+++ b/utf8-nobom.txt\n@@ -1,9 +1,9 @@\n-ä#äf34öööäß€9875oe\r\n+ä#äf34ööcöäß€9875oe\r\n fgdjkglsfdg\r\n öäöü45g\r\n fdgi&§$%&hfdsgä\r\n ä#äf34öööäß€9875oe\r\n-öäüpfgmfdg\r\n+öäcüpfgmfdg\r\n €fgfdsg\r\n 45\r\n äü\n\\ No newline at end of file\n", fileContents);
 }
 
+TEST_P(CBasicGitWithTestRepoFixture, GetCommitDiffList)
+{
+	CTGitPathList list;
+	EXPECT_EQ(0, m_Git.GetCommitDiffList(L"b9ef30183497cdad5c30b88d32dc1bed7951dfeb", L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8", list));
+	ASSERT_EQ(1, list.GetCount());
+	EXPECT_STREQ(L"utf8-nobom.txt", list[0].GetGitPathString());
+	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
+	EXPECT_EQ(2, list[0].m_StatAdd);
+	EXPECT_EQ(2, list[0].m_StatDel);
+
+	// same files, but neither line statistics nor renames
+	EXPECT_EQ(0, m_Git.GetCommitDiffListQuick(L"b9ef30183497cdad5c30b88d32dc1bed7951dfeb", L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8", list));
+	ASSERT_EQ(1, list.GetCount());
+	EXPECT_STREQ(L"utf8-nobom.txt", list[0].GetGitPathString());
+	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, list[0].m_Action);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, list[0].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, list[0].m_StatDel);
+
+	EXPECT_EQ(-1, m_Git.GetCommitDiffListQuick(L"does-not-exist", L"b02add66f48814a73aa2f0876d6bbc8662d6a9a8", list));
+}
+
+static CGitHash CreateTestCommit(git_repository* repo, const git_tree* tree, const git_signature* signature, const char* message, const CGitHash& parent1, const CGitHash& parent2 = CGitHash())
+{
+	CAutoCommit parents[2];
+	EXPECT_EQ(0, git_commit_lookup(parents[0].GetPointer(), repo, parent1));
+	if (!parent2.IsEmpty())
+		EXPECT_EQ(0, git_commit_lookup(parents[1].GetPointer(), repo, parent2));
+	git_oid oid;
+	EXPECT_EQ(0, git_commit_create_v(&oid, repo, nullptr, signature, signature, nullptr, message, tree, parent2.IsEmpty() ? 1 : 2, static_cast<const git_commit*>(parents[0]), static_cast<const git_commit*>(parents[1])));
+	return CGitHash(oid);
+}
+
+TEST_P(CBasicGitWithTestRepoFixture, GetAheadBehind)
+{
+	CAutoRepository repo(m_Git.GetGitRepository());
+	ASSERT_TRUE(repo.IsValid());
+	const CGitHash master = CGitHash::FromHexStr(L"7c3cbfe13a929d2291a574dca45e4fd2d2ac1aa6");
+	CAutoCommit masterCommit;
+	ASSERT_EQ(0, git_commit_lookup(masterCommit.GetPointer(), repo, master));
+	CAutoTree tree;
+	ASSERT_EQ(0, git_commit_tree(tree.GetPointer(), masterCommit));
+
+	// all new commits have the same date, so the walk by date cannot order them
+	CAutoSignature signature;
+	ASSERT_EQ(0, git_signature_new(signature.GetPointer(), "a", "a@example.com", 1500000000, 0));
+	const CGitHash a1 = CreateTestCommit(repo, tree, signature, "a1", master);
+	const CGitHash a2 = CreateTestCommit(repo, tree, signature, "a2", a1);
+	const CGitHash b1 = CreateTestCommit(repo, tree, signature, "b1", master);
+	const CGitHash merge = CreateTestCommit(repo, tree, signature, "merge", a2, b1);
+	const CGitHash c1 = CreateTestCommit(repo, tree, signature, "c1", b1);
+	const CGitHash merge2 = CreateTestCommit(repo, tree, signature, "merge2", c1, merge);
+	const CGitHash d1 = CreateTestCommit(repo, tree, signature, "d1", a1);
+
+	const std::vector<std::pair<CGitHash, CGitHash>> pairs = {
+		{ a2, b1 },
+		{ merge, c1 },
+		{ c1, merge },
+		{ merge, a2 },
+		{ merge2, d1 },
+		{ d1, merge },
+		{ merge2, master },
+		{ master, CGitHash::FromHexStr(L"4c5c93d2a0b368bc4570d5ec02ab03b9c4334d44") },
+		{ CGitHash::FromHexStr(L"31ff87c86e9f6d3853e438cb151043f30f09029a"), merge2 },
+		{ a1, a1 },
+	};
+	std::vector<std::pair<size_t, size_t>> aheadBehind;
+	ASSERT_EQ(0, CGit::GetAheadBehind(repo, pairs, aheadBehind));
+	ASSERT_EQ(pairs.size(), aheadBehind.size());
+	for (size_t i = 0; i < pairs.size(); ++i)
+	{
+		size_t ahead = 0, behind = 0;
+		EXPECT_EQ(0, git_graph_ahead_behind(&ahead, &behind, repo, pairs[i].first, pairs[i].second));
+		EXPECT_EQ(ahead, aheadBehind[i].first) << "pair " << i;
+		EXPECT_EQ(behind, aheadBehind[i].second) << "pair " << i;
+	}
+	EXPECT_EQ(5U, aheadBehind[4].first); // a2, b1, c1, merge, merge2
+	EXPECT_EQ(1U, aheadBehind[4].second); // d1
+	EXPECT_EQ(0U, aheadBehind[9].first);
+	EXPECT_EQ(0U, aheadBehind[9].second);
+}
+
 static void GetGitNotes(CGit& m_Git, config testConfig)
 {
 	if (testConfig != LIBGIT2_ALL)
@@ -4593,3 +4716,45 @@ TEST_P(CBasicGitWithSubmoduleRepositoryFixture, GetSubmoduleHash)
 		EXPECT_STRNE(L"", error);
 	}
 }
+
+TEST_P(CBasicGitWithTestRepoFixture, BatchHelper)
+{
+	// the helper does not depend on the libgit2 settings
+	if (GetParam() != GIT_CLI || !CGitBatchHelper::IsSupported())
+		return;
+
+	CGitBatchHelper helper(m_Git);
+	CGitHash hash;
+	CStringA type;
+	EXPECT_EQ(1, helper.GetObjectInfo(L"HEAD~1", hash, type));
+	EXPECT_STREQ(L"1fc3c9688e27596d8717b54f2939dc951568f6cb", hash.ToString());
+	EXPECT_STREQ("commit", type);
+	EXPECT_EQ(1, helper.GetObjectInfo(L"normal-tag", hash, type));
+	EXPECT_STREQ(L"b9ef30183497cdad5c30b88d32dc1bed7951dfeb", hash.ToString());
+	EXPECT_EQ(0, helper.GetObjectInfo(L"does-not-exist", hash, type));
+	EXPECT_EQ(-1, helper.GetObjectInfo(L"HEAD\nHEAD", hash, type));
+
+	// the process is restarted after it was stopped
+	BYTE_VECTOR content;
+	helper.Stop();
+	EXPECT_EQ(1, helper.GetObjectContents(L"4c5c93d2a0b368bc4570d5ec02ab03b9c4334d44:newfiles2 - C\u00f6py.txt", type, content));
+	EXPECT_STREQ("blob", type);
+	EXPECT_EQ(14U, content.size());
+	EXPECT_EQ(0, helper.GetObjectContents(L"HEAD:does-not-exist", type, content));
+
+	CString value;
+	EXPECT_EQ(0, helper.GetConfigValue(L"batchhelper.Sub.Test", false, value));
+	EXPECT_EQ(0, m_Git.SetConfigValue(L"BatchHelper.Sub.test", L"yes"));
+	helper.InvalidateConfig();
+	EXPECT_EQ(1, helper.GetConfigValue(L"batchhelper.Sub.Test", false, value));
+	EXPECT_STREQ(L"yes", value);
+	EXPECT_EQ(1, helper.GetConfigValue(L"batchhelper.Sub.Test", true, value));
+	EXPECT_STREQ(L"true", value);
+	EXPECT_EQ(0, helper.GetConfigValue(L"batchhelper.sub.test", false, value));
+
+	// changes by other processes are noticed without invalidating
+	CString output;
+	EXPECT_EQ(0, m_Git.Run(L"git.exe config batchhelper.Sub.test no", &output, CP_UTF8));
+	EXPECT_EQ(1, helper.GetConfigValue(L"batchhelper.Sub.Test", true, value));
+	EXPECT_STREQ(L"false", value);
+}
@@ -0,0 +1,261 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#include "stdafx.h"
+#include "IncrementalDiff.h"
+
+namespace
+{
+// a plain LCS line diff as reference, the tests are chosen so that the alignment is unambiguous
+std::vector<CIncrementalDiff::DiffBlock> LineDiff(const std::vector<viewdata>& left, const std::vector<viewdata>& right)
+{
+	const size_t n = left.size();
+	const size_t m = right.size();
+	std::vector<std::vector<size_t>> lcs(n + 1, std::vector<size_t>(m + 1, 0));
+	for (size_t i = n; i-- > 0;)
+	{
+		for (size_t j = m; j-- > 0;)
+			lcs[i][j] = left[i].sLine == right[j].sLine ? lcs[i + 1][j + 1] + 1 : max(lcs[i + 1][j], lcs[i][j + 1]);
+	}
+
+	std::vector<CIncrementalDiff::DiffBlock> blocks;
+	auto add = [&blocks](bool bCommon, size_t leftLines, size_t rightLines)
+	{
+		if (blocks.empty() || blocks.back().bCommon != bCommon)
+			blocks.push_back({ bCommon, 0, 0 });
+		blocks.back().leftLines += leftLines;
+		blocks.back().rightLines += rightLines;
+	};
+	size_t i = 0;
+	size_t j = 0;
+	while (i < n || j < m)
+	{
+		if (i < n && j < m && left[i].sLine == right[j].sLine)
+		{
+			add(true, 1, 1);
+			++i;
+			++j;
+		}
+		else if (j < m && (i == n || lcs[i][j + 1] >= lcs[i + 1][j]))
+		{
+			add(false, 0, 1);
+			++j;
+		}
+		else
+		{
+			add(false, 1, 0);
+			++i;
+		}
+	}
+	return blocks;
+}
+
+std::vector<viewdata> ToLines(std::initializer_list<const wchar_t*> texts)
+{
+	std::vector<viewdata> lines;
+	int linenumber = 0;
+	for (auto text : texts)
+		lines.emplace_back(text, DiffState::Normal, linenumber++, EOL::CRLF, HideState::Shown);
+	return lines;
+}
+
+// the rows a diff of the whole files produces
+void FullDiff(const std::vector<viewdata>& leftLines, const std::vector<viewdata>& rightLines, CViewData& left, CViewData& right)
+{
+	CIncrementalDiff::Result result;
+	result.oldLeft = leftLines;
+	result.oldRight = rightLines;
+	CIncrementalDiff::LayoutWindow(result, LineDiff(leftLines, rightLines));
+	ASSERT_EQ(result.left.size(), result.right.size());
+	left.Clear();
+	right.Clear();
+	for (size_t i = 0; i < result.left.size(); ++i)
+	{
+		left.AddData(result.left[i]);
+		right.AddData(result.right[i]);
+	}
+}
+
+// re-diffs the anchored window around [first, last] and replaces its rows, like CMainFrame does with the result of the worker thread
+void IncrementalDiff(CViewData& left, CViewData& right, int first, int last)
+{
+	CIncrementalDiff::GetAnchoredWindow(left, right, first, last);
+	CIncrementalDiff::Result result;
+	result.firstViewLine = first;
+	result.lastViewLine = last;
+	for (int row = first; row <= last; ++row)
+	{
+		result.oldLeft.push_back(left.GetData(row));
+		result.oldRight.push_back(right.GetData(row));
+	}
+	ASSERT_TRUE(result.MatchesViews(left, right));
+	CIncrementalDiff::LayoutWindow(result, LineDiff(CIncrementalDiff::GetRealLines(result.oldLeft), CIncrementalDiff::GetRealLines(result.oldRight)));
+	ASSERT_EQ(result.left.size(), result.right.size());
+
+	for (int row = last; row >= first; --row)
+	{
+		left.RemoveData(row);
+		right.RemoveData(row);
+	}
+	for (size_t i = 0; i < result.left.size(); ++i)
+	{
+		left.InsertData(first + static_cast<int>(i), result.left[i]);
+		right.InsertData(first + static_cast<int>(i), result.right[i]);
+	}
+}
+
+void ExpectSameRows(const CViewData& expected, const CViewData& actual)
+{
+	ASSERT_EQ(expected.GetCount(), actual.GetCount());
+	for (int row = 0; row < expected.GetCount(); ++row)
+	{
+		EXPECT_EQ(expected.GetState(row), actual.GetState(row)) << "row " << row;
+		EXPECT_STREQ(expected.GetLine(row), actual.GetLine(row)) << "row " << row;
+	}
+}
+
+int FindRow(const CViewData& data, const wchar_t* text)
+{
+	for (int row = 0; row < data.GetCount(); ++row)
+	{
+		if (data.GetLine(row) == text)
+			return row;
+	}
+	return -1;
+}
+
+viewdata EditedRow(const wchar_t* text)
+{
+	return viewdata(text, DiffState::Edited, -1, EOL::CRLF, HideState::Shown);
+}
+
+viewdata EmptyRow()
+{
+	return viewdata(CString(), DiffState::Empty, -1, EOL::NoEnding, HideState::Shown);
+}
+
+class CIncrementalDiffTest : public ::testing::Test
+{
+protected:
+	void SetUp() override
+	{
+		FullDiff(m_leftLines, m_rightLines, m_left, m_right);
+	}
+
+	// compares the incrementally updated views with a full diff of the edited files
+	void CheckAgainstFullDiff(const std::vector<viewdata>& editedRightLines, int first, int last)
+	{
+		IncrementalDiff(m_left, m_right, first, last);
+		CViewData expectedLeft;
+		CViewData expectedRight;
+		FullDiff(m_leftLines, editedRightLines, expectedLeft, expectedRight);
+		ExpectSameRows(expectedLeft, m_left);
+		ExpectSameRows(expectedRight, m_right);
+	}
+
+	const std::vector<viewdata> m_leftLines = ToLines({ L"a", L"b", L"c", L"d", L"e", L"f", L"g", L"h", L"i", L"j" });
+	const std::vector<viewdata> m_rightLines = ToLines({ L"a", L"b", L"C", L"d", L"e", L"f", L"g", L"h", L"y", L"i", L"j" });
+	CViewData m_left;
+	CViewData m_right;
+};
+}
+
+TEST_F(CIncrementalDiffTest, GetAnchoredWindow)
+{
+	const int changed = FindRow(m_right, L"C");
+	ASSERT_EQ(2, changed);
+	// "c" and "C" are shown side by side, the window is bordered by "b" and "d"
+	EXPECT_EQ(DiffState::Removed, m_left.GetState(changed));
+	EXPECT_EQ(DiffState::Added, m_right.GetState(changed));
+
+	int first = changed;
+	int last = changed;
+	CIncrementalDiff::GetAnchoredWindow(m_left, m_right, first, last);
+	EXPECT_EQ(changed, first);
+	EXPECT_EQ(changed, last);
+
+	const int added = FindRow(m_right, L"y");
+	ASSERT_LT(0, added);
+	EXPECT_EQ(DiffState::Empty, m_left.GetState(added));
+	first = added - 2;
+	last = added;
+	CIncrementalDiff::GetAnchoredWindow(m_left, m_right, first, last);
+	EXPECT_EQ(added - 2, first);
+	EXPECT_EQ(added, last);
+
+	first = -5;
+	last = 100;
+	CIncrementalDiff::GetAnchoredWindow(m_left, m_right, first, last);
+	EXPECT_EQ(0, first);
+	EXPECT_EQ(m_left.GetCount() - 1, last);
+}
+
+TEST_F(CIncrementalDiffTest, EditUnchangedLine)
+{
+	const int row = FindRow(m_right, L"f");
+	m_right.SetData(row, EditedRow(L"F"));
+
+	auto edited = m_rightLines;
+	edited[5].sLine = L"F";
+	CheckAgainstFullDiff(edited, row, row);
+}
+
+TEST_F(CIncrementalDiffTest, EditRevertsChange)
+{
+	const int row = FindRow(m_right, L"C");
+	m_right.SetData(row, EditedRow(L"c"));
+
+	auto edited = m_rightLines;
+	edited[2].sLine = L"c";
+	CheckAgainstFullDiff(edited, row, row);
+	EXPECT_EQ(DiffState::Normal, m_right.GetState(row));
+}
+
+TEST_F(CIncrementalDiffTest, InsertLine)
+{
+	const int row = FindRow(m_right, L"e") + 1;
+	m_right.InsertData(row, EditedRow(L"x"));
+	m_left.InsertData(row, EmptyRow());
+
+	auto edited = m_rightLines;
+	edited.insert(edited.begin() + 5, EditedRow(L"x"));
+	CheckAgainstFullDiff(edited, row, row);
+}
+
+TEST_F(CIncrementalDiffTest, RemoveLine)
+{
+	const int row = FindRow(m_right, L"e");
+	m_right.SetData(row, EmptyRow());
+
+	auto edited = m_rightLines;
+	edited.erase(edited.begin() + 4);
+	CheckAgainstFullDiff(edited, row, row);
+	EXPECT_EQ(DiffState::Removed, m_left.GetState(row));
+}
+
+TEST_F(CIncrementalDiffTest, EditNextToAddedLine)
+{
+	// the window has to include the added "y", otherwise the rows of "h" and "y" would be aligned differently than by a full diff
+	const int row = FindRow(m_right, L"h");
+	m_right.SetData(row, EditedRow(L"y"));
+
+	auto edited = m_rightLines;
+	edited[7].sLine = L"y";
+	CheckAgainstFullDiff(edited, row, row);
+}
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2015, 2017-2020, 2023 - TortoiseGit
+// Copyright (C) 2015, 2017-2020, 2023, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -160,6 +160,11 @@ static void ParserFromLogTests()
 	EXPECT_STREQ(L"7c3cbfe13a929d2291a574dca45e4fd2d2ac1aa6", logDataVector.GetGitRevAt(0).m_CommitHash.ToString());
 	EXPECT_STREQ(L"49ecdfff36bfe2b9b499b33e5034f427e2fa54dd", logDataVector.GetGitRevAt(2).m_CommitHash.ToString());
 	EXPECT_STREQ(L"560deea87853158b22d0c0fd73f60a458d47838a", logDataVector.GetGitRevAt(4).m_CommitHash.ToString());
+	// equal identities share their buffer
+	EXPECT_STREQ(L"Sven Strickroth", logDataVector.GetGitRevAt(0).GetAuthorName());
+	EXPECT_EQ(static_cast<LPCWSTR>(logDataVector.GetGitRevAt(0).GetAuthorName()), static_cast<LPCWSTR>(logDataVector.GetGitRevAt(2).GetAuthorName()));
+	EXPECT_EQ(static_cast<LPCWSTR>(logDataVector.GetGitRevAt(0).GetAuthorEmail()), static_cast<LPCWSTR>(logDataVector.GetGitRevAt(4).GetAuthorEmail()));
+	EXPECT_STREQ(L"Some other User", logDataVector.GetGitRevAt(1).GetAuthorName());
 
 	logCache.m_HashMap.clear();
 	logDataVector.ClearAll();
@@ -168,6 +173,10 @@ static void ParserFromLogTests()
 	EXPECT_EQ(24U, logDataVector.m_HashMap.size());
 	EXPECT_EQ(24U, logCache.m_HashMap.size());
 	EXPECT_STREQ(L"31ff87c86e9f6d3853e438cb151043f30f09029a", logDataVector.GetGitRevAt(0).m_CommitHash.ToString());
+	// the body is decoded on demand
+	EXPECT_STREQ(L"Several actions", logDataVector.GetGitRevAt(0).GetSubject());
+	EXPECT_NE(-1, logDataVector.GetGitRevAt(0).GetBody().Find(L"* amended with different date"));
+	EXPECT_NE(-1, logDataVector.GetGitRevAt(0).GetSubjectBody().Find(L"Signed-off-by: Sven Strickroth <email@cs-ware.de>"));
 	EXPECT_STREQ(L"4c5c93d2a0b368bc4570d5ec02ab03b9c4334d44", logDataVector.GetGitRevAt(1).m_CommitHash.ToString());
 	EXPECT_STREQ(L"4517b91ee8f7497d40cf93d112f12196a7cec995", logDataVector.GetGitRevAt(12).m_CommitHash.ToString());
 	EXPECT_STREQ(L"c5b89de0335fd674e2e421ac4543098cb2f22cde", logDataVector.GetGitRevAt(15).m_CommitHash.ToString());
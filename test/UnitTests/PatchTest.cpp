@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2018-2019, 2021-2022 - TortoiseGit
+// Copyright (C) 2018-2019, 2021-2022, 2026 - TortoiseGit
 
 // This program is free software; you can redistribute it and/or
 // modify it under the terms of the GNU General Public License
@@ -344,6 +344,79 @@ TEST(CPatch, Parse_UnquotedFilenameUTF8)
 	}
 }
 
+TEST(CPatch, Parse_LinesOnDemand)
+{
+	CAutoTempDir tempDir;
+	const CString patchFile = tempDir.GetTempDir() + L"\\ondemand.patch";
+	ASSERT_TRUE(CStringUtils::WriteStringToTextFile(patchFile, L"From: someone\r\nSubject: test\r\n\r\ndiff --git a/one.txt b/one.txt\r\nindex 1111111..2222222 100644\r\n--- a/one.txt\r\n+++ b/one.txt\r\n@@ -1,2 +1,2 @@\r\n-old\r\n+new\r\n context\r\ndiff --git a/two.txt b/two.txt\r\n--- a/two.txt\r\n+++ b/two.txt\r\n@@ -1 +1,2 @@\r\n same\r\n+\u00e4dded\r\n\\ No newline at end of file\r\n", true));
+
+	CPatch patch;
+	EXPECT_TRUE(patch.OpenUnifiedDiffFile(patchFile));
+	EXPECT_STREQ(L"", patch.GetErrorMessage());
+	ASSERT_EQ(2, patch.GetNumberOfFiles());
+	EXPECT_STREQ(L"one.txt", patch.GetFilename(0));
+	EXPECT_STREQ(L"1111111", patch.GetRevision(0));
+	EXPECT_STREQ(L"2222222", patch.GetRevision2(0));
+	EXPECT_STREQ(L"two.txt", patch.GetFilename2(1));
+
+	auto& chunks0 = patch.GetChunks(0);
+	ASSERT_EQ(size_t(1), chunks0.size());
+	ASSERT_EQ(3, chunks0[0]->arLines.GetCount());
+	EXPECT_STREQ(L"old", chunks0[0]->arLines.GetAt(0));
+	EXPECT_STREQ(L"new", chunks0[0]->arLines.GetAt(1));
+	EXPECT_STREQ(L"context", chunks0[0]->arLines.GetAt(2));
+	EXPECT_EQ(EOL::AutoLine, chunks0[0]->arEOLs[2]);
+
+	// only the lines of one file diff are kept in memory
+	auto& chunks1 = patch.GetChunks(1);
+	EXPECT_EQ(0, chunks0[0]->arLines.GetCount());
+	ASSERT_EQ(size_t(1), chunks1.size());
+	ASSERT_EQ(2, chunks1[0]->arLines.GetCount());
+	EXPECT_STREQ(L"same", chunks1[0]->arLines.GetAt(0));
+	EXPECT_STREQ(L"\u00e4dded", chunks1[0]->arLines.GetAt(1));
+	ASSERT_EQ(2, chunks1[0]->arLinesStates.GetCount());
+	EXPECT_EQ(static_cast<DWORD>(PATCHSTATE_CONTEXT), chunks1[0]->arLinesStates.GetAt(0));
+	EXPECT_EQ(static_cast<DWORD>(PATCHSTATE_ADDED), chunks1[0]->arLinesStates.GetAt(1));
+}
+
+TEST(CPatch, Parse_FileNotKeptOpen)
+{
+	CAutoTempDir tempDir;
+	const CString patchFile = tempDir.GetTempDir() + L"\\unlocked.patch";
+	ASSERT_TRUE(CStringUtils::WriteStringToTextFile(patchFile, L"--- a/one.txt\n+++ b/one.txt\n@@ -1 +1 @@\n-old\n+new\n", true));
+
+	CPatch patch;
+	EXPECT_TRUE(patch.OpenUnifiedDiffFile(patchFile));
+	ASSERT_EQ(1, patch.GetNumberOfFiles());
+
+	// the file is not mapped anymore after parsing, so it can be replaced
+	EXPECT_TRUE(DeleteFile(patchFile));
+	ASSERT_TRUE(CStringUtils::WriteStringToTextFile(patchFile, L"--- a/one.txt\n+++ b/one.txt\n@@ -1 +1 @@\n-changed\n+content\n", true));
+
+	// the positions of the chunks do not belong to the new content, so its lines must not be used
+	auto& chunks = patch.GetChunks(0);
+	ASSERT_EQ(size_t(1), chunks.size());
+	EXPECT_EQ(0, chunks[0]->arLines.GetCount());
+
+	CPatch patch2;
+	EXPECT_TRUE(patch2.OpenUnifiedDiffFile(patchFile));
+	auto& chunks2 = patch2.GetChunks(0);
+	ASSERT_EQ(size_t(1), chunks2.size());
+	ASSERT_EQ(2, chunks2[0]->arLines.GetCount());
+	EXPECT_STREQ(L"changed", chunks2[0]->arLines.GetAt(0));
+}
+
+TEST(CPatch, Parse_ChunkMismatch)
+{
+	CAutoTempDir tempDir;
+	const CString patchFile = tempDir.GetTempDir() + L"\\mismatch.patch";
+	ASSERT_TRUE(CStringUtils::WriteStringToTextFile(patchFile, L"--- a/one.txt\n+++ b/one.txt\n@@ -1,3 +1,3 @@\n-old\n+new\n", true));
+
+	CPatch patch;
+	EXPECT_FALSE(patch.OpenUnifiedDiffFile(patchFile));
+	EXPECT_EQ(0, patch.GetNumberOfFiles());
+}
+
 TEST(CPatch, PatchFile)
 {
 	CString resourceDir;
@@ -0,0 +1,117 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#include "stdafx.h"
+#include "ScreenLineIndex.h"
+
+TEST(CScreenLineIndex, Empty)
+{
+	CScreenLineIndex index;
+	EXPECT_EQ(0, index.GetCount());
+	EXPECT_EQ(0, index.GetTotal());
+	EXPECT_EQ(0, index.GetStart(0));
+	EXPECT_EQ(-1, index.FindIndex(0));
+
+	index.Assign({ 1, 2 });
+	index.Clear();
+	EXPECT_EQ(0, index.GetCount());
+	EXPECT_EQ(0, index.GetTotal());
+	EXPECT_EQ(-1, index.FindIndex(0));
+}
+
+TEST(CScreenLineIndex, Lookup)
+{
+	CScreenLineIndex index;
+	// second and fifth view line are collapsed
+	index.Assign({ 1, 0, 3, 1, 0, 2 });
+	ASSERT_EQ(6, index.GetCount());
+	EXPECT_EQ(7, index.GetTotal());
+
+	EXPECT_EQ(0, index.GetStart(0));
+	EXPECT_EQ(1, index.GetStart(1));
+	EXPECT_EQ(1, index.GetStart(2));
+	EXPECT_EQ(4, index.GetStart(3));
+	EXPECT_EQ(5, index.GetStart(4));
+	EXPECT_EQ(5, index.GetStart(5));
+	EXPECT_EQ(7, index.GetStart(6));
+
+	const int expected[] = { 0, 2, 2, 2, 3, 5, 5 };
+	for (int screenLine = 0; screenLine < 7; ++screenLine)
+		EXPECT_EQ(expected[screenLine], index.FindIndex(screenLine));
+	EXPECT_EQ(-1, index.FindIndex(7));
+	EXPECT_EQ(-1, index.FindIndex(-1));
+}
+
+TEST(CScreenLineIndex, Shift)
+{
+	CScreenLineIndex index;
+	index.Assign({ 1, 2, 3, 4, 5 });
+	// insert two lines before the third one, then remove the (new) first and second line
+	ASSERT_TRUE(index.Shift({ { 2, 2 }, { 1, -1 }, { 0, -1 } }, -1));
+	ASSERT_EQ(5, index.GetCount());
+	const int expected[] = { -1, -1, 3, 4, 5 };
+	for (int i = 0; i < 5; ++i)
+		EXPECT_EQ(expected[i], index.GetLineCount(i));
+
+	index.SetLineCount(0, 1);
+	index.SetLineCount(1, 2);
+	EXPECT_EQ(15, index.GetTotal());
+	EXPECT_EQ(3, index.GetStart(2));
+	EXPECT_EQ(2, index.FindIndex(3));
+
+	// out of range, nothing changes
+	EXPECT_FALSE(index.Shift({ { 1, 1 }, { 5, -2 } }, 1));
+	EXPECT_FALSE(index.Shift({ { 6, 1 } }, 1));
+	EXPECT_EQ(5, index.GetCount());
+	EXPECT_EQ(15, index.GetTotal());
+}
+
+TEST(CScreenLineIndex, SetLineCount)
+{
+	CScreenLineIndex index;
+	index.Assign(std::vector<int>(1000, 1));
+	EXPECT_EQ(1000, index.GetTotal());
+	EXPECT_EQ(500, index.FindIndex(500));
+
+	index.SetLineCount(10, 5);
+	index.SetLineCount(20, 0);
+	EXPECT_EQ(5, index.GetLineCount(10));
+	EXPECT_EQ(1003, index.GetTotal());
+	EXPECT_EQ(10, index.GetStart(10));
+	EXPECT_EQ(15, index.GetStart(11));
+	EXPECT_EQ(24, index.GetStart(20));
+	EXPECT_EQ(24, index.GetStart(21));
+	EXPECT_EQ(10, index.FindIndex(14));
+	EXPECT_EQ(11, index.FindIndex(15));
+	EXPECT_EQ(21, index.FindIndex(24));
+	EXPECT_EQ(999, index.FindIndex(1002));
+
+	// compare against a plain scan
+	for (int i = 0; i < 1000; i += 7)
+		index.SetLineCount(i, i % 4);
+	int start = 0;
+	for (int i = 0; i < index.GetCount(); ++i)
+	{
+		EXPECT_EQ(start, index.GetStart(i));
+		for (int sub = 0; sub < index.GetLineCount(i); ++sub)
+			EXPECT_EQ(i, index.FindIndex(start + sub));
+		start += index.GetLineCount(i);
+	}
+	EXPECT_EQ(start, index.GetTotal());
+}
@@ -1,6 +1,6 @@
 ﻿// TortoiseGit - a Windows shell extension for easy version control
 
-// Copyright (C) 2015-2023, 2025 - TortoiseGit
+// Copyright (C) 2015-2023, 2025-2026 - TortoiseGit
 // Copyright (C) 2003-2008 - TortoiseSVN
 
 // This program is free software; you can redistribute it and/or
@@ -786,92 +786,92 @@ TEST(CTGitPath, ParserFromLog_DiffIndex_Raw_M_C_z)
 	EXPECT_STREQ(L"README.md", testList [i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"appveyor.yml", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"build.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/apr-util", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/hunspell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/json", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/libgit2", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/spell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"release-renamed.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"release.txt", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"signedness.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/Debug-Hints.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/gpl.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"test/UnitTests/TGitPathTest.cpp", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"", testList[i].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 }
 
@@ -889,92 +889,92 @@ TEST(CTGitPath, ParserFromLog_DiffIndex_Raw_M_C_Numstat_z)
 	EXPECT_STREQ(L"README.md", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"3", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"45", testList[i].m_StatDel);
+	EXPECT_EQ(3, testList[i].m_StatAdd);
+	EXPECT_EQ(45, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"appveyor.yml", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"79", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(79, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"build.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"77", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(77, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/apr-util", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/hunspell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/json", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/libgit2", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/spell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"release-renamed.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"release.txt", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"signedness.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1176", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1176, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/Debug-Hints.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"109", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(109, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/gpl.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"340", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(340, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"test/UnitTests/TGitPathTest.cpp", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"162", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"2", testList[i].m_StatDel);
+	EXPECT_EQ(162, testList[i].m_StatAdd);
+	EXPECT_EQ(2, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 }
 
@@ -992,62 +992,62 @@ TEST(CTGitPath, ParserFromLog_DiffIndex_Raw_Cached_M_C_Numstat_z)
 	EXPECT_STREQ(L"README.md", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"6", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"30", testList[i].m_StatDel);
+	EXPECT_EQ(6, testList[i].m_StatAdd);
+	EXPECT_EQ(30, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"appveyor.yml", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"79", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(79, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/hunspell", testList[i].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/json", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"release-renamed.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"release.txt", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"signedness.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1176", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1176, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/Debug-Hints.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"109", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(109, testList[i].m_StatDel);
 	++i;
 	EXPECT_STREQ(L"src/gpl.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"340", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(340, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"zzz-added-only-in-index-missing-on-fs.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 }
 
@@ -1065,99 +1065,99 @@ TEST(CTGitPath, ParserFromLog_DiffIndex_Raw_Cached_M_C_Numstat_z_AND_DiffIndex_R
 	EXPECT_STREQ(L"README.md", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"3", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"45", testList[i].m_StatDel);
+	EXPECT_EQ(3, testList[i].m_StatAdd);
+	EXPECT_EQ(45, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"appveyor.yml", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"79", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(79, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/hunspell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/json", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"release-renamed.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"release.txt", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"signedness.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1176", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1176, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/Debug-Hints.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"109", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(109, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/gpl.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"340", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(340, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"zzz-added-only-in-index-missing-on-fs.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"build.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"77", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(77, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/apr-util", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/libgit2", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/spell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"test/UnitTests/TGitPathTest.cpp", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"162", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"2", testList[i].m_StatDel);
+	EXPECT_EQ(162, testList[i].m_StatAdd);
+	EXPECT_EQ(2, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 }
 
@@ -1175,57 +1175,57 @@ TEST(CTGitPath, ParserFromLog_DiffFiles_raw_C_M_numstat_z)
 	EXPECT_STREQ(L"README.md", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"19", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(19, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"build.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"77", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(77, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/apr-util", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/libgit2", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/spell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"release-renamed.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString()); // no rename detected here
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"test/UnitTests/TGitPathTest.cpp", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"162", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"2", testList[i].m_StatDel);
+	EXPECT_EQ(162, testList[i].m_StatAdd);
+	EXPECT_EQ(2, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"zzz-added-only-in-index-missing-on-fs.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 }
 
@@ -1243,92 +1243,92 @@ TEST(CTGitPath, ParserFromLog_Diff_r_raw_C_M_numstat_z_HEAD)
 	EXPECT_STREQ(L"README.md", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"3", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"45", testList[i].m_StatDel);
+	EXPECT_EQ(3, testList[i].m_StatAdd);
+	EXPECT_EQ(45, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"appveyor.yml", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"79", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(79, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"build.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"77", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(77, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/apr-util", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/hunspell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/json", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/libgit2", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"ext/spell", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(1, testList[i].m_StatDel);
 	EXPECT_TRUE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"release-renamed.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"release.txt", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[i].m_Action);
-	EXPECT_STREQ(L"1", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"signedness.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[i].m_Action);
-	EXPECT_STREQ(L"1176", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[i].m_StatDel);
+	EXPECT_EQ(1176, testList[i].m_StatAdd);
+	EXPECT_EQ(0, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/Debug-Hints.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"109", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(109, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"src/gpl.txt", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[i].m_Action);
-	EXPECT_STREQ(L"0", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"340", testList[i].m_StatDel);
+	EXPECT_EQ(0, testList[i].m_StatAdd);
+	EXPECT_EQ(340, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 	++i;
 	EXPECT_STREQ(L"test/UnitTests/TGitPathTest.cpp", testList[i].GetGitPathString());
 	EXPECT_STREQ(L"", testList[i].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[i].m_Action);
-	EXPECT_STREQ(L"162", testList[i].m_StatAdd);
-	EXPECT_STREQ(L"2", testList[i].m_StatDel);
+	EXPECT_EQ(162, testList[i].m_StatAdd);
+	EXPECT_EQ(2, testList[i].m_StatDel);
 	EXPECT_FALSE(testList[i].IsDirectory());
 }
 
@@ -1360,14 +1360,14 @@ TEST(CTGitPath, ParserFromLog_DiffIndex_Raw_Cached_M_C_Numstat_z_UTF8)
 	ASSERT_EQ(2, testList.GetCount());
 	EXPECT_STREQ(L"büil\u570B\u7ACB1d\u043A.txt", testList[0].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[0].m_Action);
-	EXPECT_STREQ(L"0", testList[0].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[0].m_StatDel);
+	EXPECT_EQ(0, testList[0].m_StatAdd);
+	EXPECT_EQ(0, testList[0].m_StatDel);
 	EXPECT_FALSE(testList[0].IsDirectory());
 	EXPECT_STREQ(L"build.txt", testList[0].GetGitOldPathString());
 	EXPECT_STREQ(L"Ümlautfile.txt", testList[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[1].m_Action);
-	EXPECT_STREQ(L"1", testList[1].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[1].m_StatDel);
+	EXPECT_EQ(1, testList[1].m_StatAdd);
+	EXPECT_EQ(0, testList[1].m_StatDel);
 	EXPECT_FALSE(testList[1].IsDirectory());
 }
 
@@ -1383,50 +1383,50 @@ TEST(CTGitPath, ParserFromLog_DiffTree)
 	EXPECT_STREQ(L"src/Git/Git.cpp", testList[0].GetGitPathString());
 	EXPECT_STREQ(L"", testList[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[0].m_Action);
-	EXPECT_STREQ(L"1", testList[0].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[0].m_StatDel);
+	EXPECT_EQ(1, testList[0].m_StatAdd);
+	EXPECT_EQ(1, testList[0].m_StatDel);
 	EXPECT_FALSE(testList[0].IsDirectory());
 	EXPECT_STREQ(L"src/Git/Git.h", testList[1].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[1].m_Action);
-	EXPECT_STREQ(L"3", testList[1].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[1].m_StatDel);
+	EXPECT_EQ(3, testList[1].m_StatAdd);
+	EXPECT_EQ(0, testList[1].m_StatDel);
 	EXPECT_FALSE(testList[1].IsDirectory());
 	EXPECT_STREQ(L"src/Git/Git.vcxproj", testList[2].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[2].m_Action);
-	EXPECT_STREQ(L"0", testList[2].m_StatAdd);
-	EXPECT_STREQ(L"2", testList[2].m_StatDel);
+	EXPECT_EQ(0, testList[2].m_StatAdd);
+	EXPECT_EQ(2, testList[2].m_StatDel);
 	EXPECT_FALSE(testList[2].IsDirectory());
 	EXPECT_STREQ(L"src/Git/Git.vcxproj.filters", testList[3].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[3].m_Action);
-	EXPECT_STREQ(L"0", testList[3].m_StatAdd);
-	EXPECT_STREQ(L"6", testList[3].m_StatDel);
+	EXPECT_EQ(0, testList[3].m_StatAdd);
+	EXPECT_EQ(6, testList[3].m_StatDel);
 	EXPECT_FALSE(testList[3].IsDirectory());
 	EXPECT_STREQ(L"src/Git/GitConfig.cpp", testList[4].GetGitPathString());
 	EXPECT_STREQ(L"", testList[4].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[4].m_Action);
-	EXPECT_STREQ(L"0", testList[4].m_StatAdd);
-	EXPECT_STREQ(L"29", testList[4].m_StatDel);
+	EXPECT_EQ(0, testList[4].m_StatAdd);
+	EXPECT_EQ(29, testList[4].m_StatDel);
 	EXPECT_FALSE(testList[4].IsDirectory());
 	EXPECT_STREQ(L"src/Git/GitForWindows.h", testList[5].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[5].m_Action);
 	EXPECT_STREQ(L"src/Git/GitConfig.h", testList[5].GetGitOldPathString());
-	EXPECT_STREQ(L"1", testList[5].m_StatAdd);
-	EXPECT_STREQ(L"11", testList[5].m_StatDel);
+	EXPECT_EQ(1, testList[5].m_StatAdd);
+	EXPECT_EQ(11, testList[5].m_StatDel);
 	EXPECT_FALSE(testList[5].IsDirectory());
 	EXPECT_STREQ(L"src/Git/GitIndex.cpp", testList[6].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[6].m_Action);
-	EXPECT_STREQ(L"0", testList[6].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[6].m_StatDel);
+	EXPECT_EQ(0, testList[6].m_StatAdd);
+	EXPECT_EQ(1, testList[6].m_StatDel);
 	EXPECT_FALSE(testList[6].IsDirectory());
 	EXPECT_STREQ(L"src/TortoiseProc/Settings/SetMainPage.cpp", testList[7].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[7].m_Action);
-	EXPECT_STREQ(L"1", testList[7].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[7].m_StatDel);
+	EXPECT_EQ(1, testList[7].m_StatAdd);
+	EXPECT_EQ(1, testList[7].m_StatDel);
 	EXPECT_FALSE(testList[7].IsDirectory());
 	EXPECT_STREQ(L"src/TortoiseProc/TortoiseProc.cpp", testList[8].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[8].m_Action);
-	EXPECT_STREQ(L"0", testList[8].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[8].m_StatDel);
+	EXPECT_EQ(0, testList[8].m_StatAdd);
+	EXPECT_EQ(1, testList[8].m_StatDel);
 	EXPECT_FALSE(testList[8].IsDirectory());
 }
 
@@ -1442,54 +1442,54 @@ TEST(CTGitPath, ParserFromLog_DiffTree_Submodule)
 	EXPECT_STREQ(L".gitmodules", testList[0].GetGitPathString());
 	EXPECT_STREQ(L"", testList[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[0].m_Action);
-	EXPECT_STREQ(L"3", testList[0].m_StatAdd);
-	EXPECT_STREQ(L"6", testList[0].m_StatDel);
+	EXPECT_EQ(3, testList[0].m_StatAdd);
+	EXPECT_EQ(6, testList[0].m_StatDel);
 	EXPECT_FALSE(testList[0].IsDirectory());
 	EXPECT_STREQ(L"appveyor.yml", testList[1].GetGitPathString());
 	EXPECT_STREQ(L"", testList[1].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[1].m_Action);
-	EXPECT_STREQ(L"1", testList[1].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[1].m_StatDel);
+	EXPECT_EQ(1, testList[1].m_StatAdd);
+	EXPECT_EQ(1, testList[1].m_StatDel);
 	EXPECT_FALSE(testList[1].IsDirectory());
 	EXPECT_STREQ(L"ext/build/googletest.vcxproj", testList[2].GetGitPathString());
 	EXPECT_STREQ(L"ext/build/gtest.vcxproj", testList[2].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[2].m_Action); // TODO: CTGitPath::LOGACTIONS_MODIFIED?, LOGACTIONS_MODIFIED has highter precedence in CTGitPath::GetActionName
-	EXPECT_STREQ(L"4", testList[2].m_StatAdd);
-	EXPECT_STREQ(L"4", testList[2].m_StatDel);
+	EXPECT_EQ(4, testList[2].m_StatAdd);
+	EXPECT_EQ(4, testList[2].m_StatDel);
 	EXPECT_FALSE(testList[2].IsDirectory());
 	EXPECT_STREQ(L"ext/build/googletest.vcxproj.filters", testList[3].GetGitPathString());
 	EXPECT_STREQ(L"ext/build/gtest.vcxproj.filters", testList[3].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_REPLACED, testList[3].m_Action); // TODO: CTGitPath::LOGACTIONS_MODIFIED?, LOGACTIONS_MODIFIED has highter precedence in CTGitPath::GetActionName
-	EXPECT_STREQ(L"3", testList[3].m_StatAdd);
-	EXPECT_STREQ(L"3", testList[3].m_StatDel);
+	EXPECT_EQ(3, testList[3].m_StatAdd);
+	EXPECT_EQ(3, testList[3].m_StatDel);
 	EXPECT_FALSE(testList[3].IsDirectory());
 	EXPECT_STREQ(L"ext/gmock", testList[4].GetGitPathString());
 	EXPECT_STREQ(L"", testList[4].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[4].m_Action);
-	EXPECT_STREQ(L"0", testList[4].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[4].m_StatDel);
+	EXPECT_EQ(0, testList[4].m_StatAdd);
+	EXPECT_EQ(1, testList[4].m_StatDel);
 	EXPECT_TRUE(testList[4].IsDirectory());
 	EXPECT_STREQ(L"ext/googletest", testList[5].GetGitPathString());
 	EXPECT_STREQ(L"", testList[5].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_ADDED, testList[5].m_Action);
-	EXPECT_STREQ(L"1", testList[5].m_StatAdd);
-	EXPECT_STREQ(L"0", testList[5].m_StatDel);
+	EXPECT_EQ(1, testList[5].m_StatAdd);
+	EXPECT_EQ(0, testList[5].m_StatDel);
 	EXPECT_TRUE(testList[5].IsDirectory());
 	EXPECT_STREQ(L"ext/gtest", testList[6].GetGitPathString());
 	EXPECT_STREQ(L"", testList[6].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_DELETED, testList[6].m_Action);
-	EXPECT_STREQ(L"0", testList[6].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[6].m_StatDel);
+	EXPECT_EQ(0, testList[6].m_StatAdd);
+	EXPECT_EQ(1, testList[6].m_StatDel);
 	EXPECT_TRUE(testList[6].IsDirectory());
 	EXPECT_STREQ(L"src/TortoiseGit.sln", testList[7].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[7].m_Action);
-	EXPECT_STREQ(L"1", testList[7].m_StatAdd);
-	EXPECT_STREQ(L"1", testList[7].m_StatDel);
+	EXPECT_EQ(1, testList[7].m_StatAdd);
+	EXPECT_EQ(1, testList[7].m_StatDel);
 	EXPECT_FALSE(testList[7].IsDirectory());
 	EXPECT_STREQ(L"test/UnitTests/UnitTests.vcxproj", testList[8].GetGitPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[8].m_Action);
-	EXPECT_STREQ(L"2", testList[8].m_StatAdd);
-	EXPECT_STREQ(L"2", testList[8].m_StatDel);
+	EXPECT_EQ(2, testList[8].m_StatAdd);
+	EXPECT_EQ(2, testList[8].m_StatDel);
 	EXPECT_FALSE(testList[8].IsDirectory());
 }
 
@@ -1505,14 +1505,14 @@ TEST(CTGitPath, ParserFromLog_DiffTree_BinaryFiles)
 	EXPECT_STREQ(L"ext/putty/pageant.exe", testList[0].GetGitPathString());
 	EXPECT_STREQ(L"", testList[0].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[0].m_Action);
-	EXPECT_STREQ(L"-", testList[0].m_StatAdd);
-	EXPECT_STREQ(L"-", testList[0].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, testList[0].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, testList[0].m_StatDel);
 	EXPECT_FALSE(testList[0].IsDirectory());
 	EXPECT_STREQ(L"ext/putty/puttygen.exe", testList[1].GetGitPathString());
 	EXPECT_STREQ(L"", testList[1].GetGitOldPathString());
 	EXPECT_EQ(CTGitPath::LOGACTIONS_MODIFIED, testList[1].m_Action);
-	EXPECT_STREQ(L"-", testList[1].m_StatAdd);
-	EXPECT_STREQ(L"-", testList[1].m_StatDel);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, testList[1].m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_BINARY, testList[1].m_StatDel);
 	EXPECT_FALSE(testList[1].IsDirectory());
 }
 
@@ -1581,6 +1581,57 @@ TEST(CTGitPath, ParserFromLog_Invalid)
 	}
 }
 
+TEST(CTGitPath, ParserFromLsFile_Unmerged)
+{
+	constexpr char git_ls_file_s_z_output[] = { "H 100644 1f9f46da1ee155aa765d6e379d9d19853358cb07 0	a.txt\0M 100644 1f9f46da1ee155aa765d6e379d9d19853358cb07 1	b\xC3\xBCt.txt\0M 100644 3aa011e7d3609ab9af90c4b10f616312d2be422f 2	b\xC3\xBCt.txt\0M 100644 56d252d69d535834b9fbfa6f6a633ecd505ea2e6 3	b\xC3\xBCt.txt\0H 160000 56d252d69d535834b9fbfa6f6a633ecd505ea2e6 0	sub\0" };
+	CGitByteArray byteArray;
+	byteArray.append(git_ls_file_s_z_output, sizeof(git_ls_file_s_z_output));
+	CTGitPathList testList;
+	EXPECT_EQ(0, testList.ParserFromLsFile(byteArray));
+	ASSERT_EQ(3, testList.GetCount());
+	EXPECT_STREQ(L"a.txt", testList[0].GetGitPathString());
+	EXPECT_EQ(0U, testList[0].m_Action);
+	EXPECT_STREQ(L"b\u00FCt.txt", testList[1].GetGitPathString());
+	EXPECT_EQ(static_cast<unsigned int>(CTGitPath::LOGACTIONS_UNMERGED), testList[1].m_Action);
+	EXPECT_STREQ(L"sub", testList[2].GetGitPathString());
+	EXPECT_TRUE(testList[2].IsDirectory());
+}
+
+// Parser benchmark, run with --gtest_also_run_disabled_tests
+TEST(CTGitPath, DISABLED_ParserFromLog_Throughput)
+{
+	// "git diff-index --raw --numstat -z" after moving 200k files into another directory
+	constexpr int fileCount = 200000;
+	std::string output;
+	for (int i = 0; i < fileCount; ++i)
+	{
+		const std::string number = std::to_string(i);
+		output += ":100644 100644 1f9f46da1ee155aa765d6e379d9d19853358cb07 3aa011e7d3609ab9af90c4b10f616312d2be422f R095";
+		output += '\0' + ("src/old/directory/file" + number + ".cpp") + '\0' + ("src/new/directory/file" + number + ".cpp") + '\0';
+	}
+	for (int i = 0; i < fileCount; ++i)
+	{
+		const std::string number = std::to_string(i);
+		output += std::to_string(i % 7) + '\t' + std::to_string(i % 3) + '\t';
+		output += '\0' + ("src/old/directory/file" + number + ".cpp") + '\0' + ("src/new/directory/file" + number + ".cpp") + '\0';
+	}
+	CGitByteArray byteArray;
+	byteArray.append(output.data(), output.size());
+
+	CTGitPathList testList;
+	LARGE_INTEGER start, end, frequency;
+	QueryPerformanceFrequency(&frequency);
+	QueryPerformanceCounter(&start);
+	EXPECT_EQ(0, testList.ParserFromLog(byteArray));
+	QueryPerformanceCounter(&end);
+
+	ASSERT_EQ(fileCount, testList.GetCount());
+	EXPECT_STREQ(L"src/old/directory/file0.cpp", testList[0].GetGitOldPathString());
+	EXPECT_EQ(2, testList[fileCount - 1].m_StatAdd);
+	const double seconds = static_cast<double>(end.QuadPart - start.QuadPart) / frequency.QuadPart;
+	printf("parsed %d renames (%.1f MiB) in %.3f s\n", fileCount, static_cast<double>(byteArray.size()) / (1024 * 1024), seconds);
+}
+
 static void setFlagOnFileInIndex(CAutoIndex& gitindex, const CString& filename, bool assumevalid, bool skipworktree)
 {
 	size_t idx = SIZE_T_MAX;
@@ -2246,6 +2297,65 @@ TEST(CTGitPath, AreAllPathsDirectories)
 	EXPECT_FALSE(list.AreAllPathsDirectories());
 }
 
+TEST(CTGitPath, ListCopy)
+{
+	CTGitPathList list;
+	list.AddPath(CTGitPath(L"a"));
+	list.AddPath(CTGitPath(L"b"));
+
+	// entries are written through const_cast and read from other threads, so copies must not share them
+	CTGitPathList copy(list);
+	EXPECT_NE(&list[0], &copy[0]);
+	const_cast<CTGitPath&>(copy[0]).m_Checked = true;
+	EXPECT_FALSE(list[0].m_Checked);
+
+	copy.AddPath(CTGitPath(L"c"));
+	EXPECT_EQ(2, list.GetCount());
+	ASSERT_EQ(3, copy.GetCount());
+	EXPECT_STREQ(L"c", copy[2].GetGitPathString());
+
+	CTGitPathList copy2 = list;
+	copy2.RemoveItem(CTGitPath(L"a"));
+	ASSERT_EQ(2, list.GetCount());
+	EXPECT_STREQ(L"a", list[0].GetGitPathString());
+	ASSERT_EQ(1, copy2.GetCount());
+	EXPECT_STREQ(L"b", copy2[0].GetGitPathString());
+
+	copy.Clear();
+	EXPECT_EQ(0, copy.GetCount());
+	EXPECT_EQ(2, list.GetCount());
+}
+
+TEST(CTGitPath, Stat)
+{
+	EXPECT_EQ(CTGitPath::STAT_BINARY, CTGitPath::ParseStat("-", 1));
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, CTGitPath::ParseStat("", 0));
+	EXPECT_EQ(0, CTGitPath::ParseStat("0", 1));
+	EXPECT_EQ(1234, CTGitPath::ParseStat("1234\t", 4));
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, CTGitPath::ParseStat("1x", 2));
+
+	EXPECT_STREQ(L"", CTGitPath::FormatStat(CTGitPath::STAT_UNKNOWN));
+	EXPECT_STREQ(L"-", CTGitPath::FormatStat(CTGitPath::STAT_BINARY));
+	EXPECT_STREQ(L"0", CTGitPath::FormatStat(0));
+	EXPECT_STREQ(L"1234", CTGitPath::FormatStat(1234));
+
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, CTGitPath().m_StatAdd);
+	EXPECT_EQ(CTGitPath::STAT_UNKNOWN, CTGitPath().m_StatDel);
+}
+
+TEST(CTGitPath, InternPaths)
+{
+	CTGitPath path1, path2;
+	path1.SetFromGit(CString(L"some/dir/file.txt"));
+	path2.SetFromGit(CString(L"some/dir/file.txt"));
+	EXPECT_NE(static_cast<LPCWSTR>(path1.GetGitPathString()), static_cast<LPCWSTR>(path2.GetGitPathString()));
+	path1.InternPaths();
+	path2.InternPaths();
+	EXPECT_EQ(static_cast<LPCWSTR>(path1.GetGitPathString()), static_cast<LPCWSTR>(path2.GetGitPathString()));
+	EXPECT_STREQ(L"some/dir/file.txt", path2.GetGitPathString());
+	EXPECT_STREQ(L"some\\dir\\file.txt", path2.GetWinPathString());
+}
+
 TEST(CTGitPath, IsAnyAncestorOf)
 {
 	CTGitPathList list;
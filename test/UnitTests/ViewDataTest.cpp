@@ -0,0 +1,117 @@
+// TortoiseGit - a Windows shell extension for easy version control
+
+// Copyright (C) 2026 - TortoiseGit
+
+// This program is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public License
+// as published by the Free Software Foundation; either version 2
+// of the License, or (at your option) any later version.
+
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software Foundation,
+// 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+//
+
+#include "stdafx.h"
+#include "ViewData.h"
+
+TEST(CViewData, AddInsertRemove)
+{
+	CViewData data;
+	EXPECT_EQ(0, data.GetCount());
+	EXPECT_EQ(0, data.GetLineNumber(0));
+	EXPECT_FALSE(data.IsMoved(0));
+
+	data.AddData(L"first", DiffState::Normal, 0, EOL::CRLF, HideState::Shown, -1);
+	data.AddData(L"third", DiffState::Added, 2, EOL::LF, HideState::Hidden, 5);
+	data.InsertData(1, L"second", DiffState::Removed, 1, EOL::NoEnding, HideState::Marker, -1);
+	data.AddEmpty();
+	ASSERT_EQ(4, data.GetCount());
+
+	EXPECT_STREQ(L"first", data.GetLine(0));
+	EXPECT_STREQ(L"second", data.GetLine(1));
+	EXPECT_STREQ(L"third", data.GetLine(2));
+	EXPECT_STREQ(L"", data.GetLine(3));
+	EXPECT_EQ(DiffState::Removed, data.GetState(1));
+	EXPECT_EQ(DiffState::Empty, data.GetState(3));
+	EXPECT_EQ(EOL::CRLF, data.GetLineEnding(0));
+	EXPECT_EQ(EOL::NoEnding, data.GetLineEnding(1));
+	EXPECT_EQ(EOL::LF, data.GetLineEnding(2));
+	EXPECT_EQ(HideState::Marker, data.GetHideState(1));
+	EXPECT_EQ(HideState::Hidden, data.GetHideState(2));
+	EXPECT_EQ(2, data.GetLineNumber(2));
+	EXPECT_EQ(-1, data.GetLineNumber(3));
+	EXPECT_TRUE(data.IsMoved(2));
+	EXPECT_EQ(5, data.GetMovedIndex(2));
+	EXPECT_FALSE(data.IsMoved(0));
+	EXPECT_EQ(2, data.FindLineNumber(2));
+	EXPECT_EQ(-1, data.FindLineNumber(3));
+
+	data.RemoveData(1);
+	ASSERT_EQ(3, data.GetCount());
+	EXPECT_STREQ(L"third", data.GetLine(1));
+	EXPECT_EQ(DiffState::Added, data.GetState(1));
+	EXPECT_EQ(5, data.GetMovedIndex(1));
+
+	data.Clear();
+	EXPECT_EQ(0, data.GetCount());
+}
+
+TEST(CViewData, GetSetData)
+{
+	CViewData data;
+	data.AddData(L"line", DiffState::Normal, 0, EOL::CRLF, HideState::Shown, -1);
+	data.SetMovedIndex(0, 3, false);
+	data.SetMarked(0, true);
+
+	viewdata line = data.GetData(0);
+	EXPECT_STREQ(L"line", line.sLine);
+	EXPECT_EQ(DiffState::Normal, line.state);
+	EXPECT_EQ(0, line.linenumber);
+	EXPECT_EQ(3, line.movedIndex);
+	EXPECT_FALSE(line.movedFrom);
+	EXPECT_EQ(EOL::CRLF, line.ending);
+	EXPECT_EQ(HideState::Shown, line.hidestate);
+	EXPECT_TRUE(line.marked);
+	EXPECT_TRUE(data.HasMarkedBlocks());
+
+	line.sLine = L"edited";
+	line.state = DiffState::Edited;
+	line.ending = EOL::PS;
+	line.hidestate = HideState::Marker;
+	line.marked = false;
+	line.movedFrom = true;
+	data.SetData(0, line);
+	EXPECT_FALSE(data.HasMarkedBlocks());
+	EXPECT_STREQ(L"edited", data.GetLine(0));
+	EXPECT_EQ(DiffState::Edited, data.GetState(0));
+	EXPECT_EQ(EOL::PS, data.GetLineEnding(0));
+	EXPECT_EQ(HideState::Marker, data.GetHideState(0));
+	EXPECT_TRUE(data.IsMovedFrom(0));
+	EXPECT_FALSE(data.GetMarked(0));
+}
+
+TEST(CViewData, MemoryUsage)
+{
+	constexpr int lines = 1000000;
+	const CString text = L"shared line text";
+
+	CViewData data;
+	data.Reserve(lines);
+	for (int i = 0; i < lines; ++i)
+		data.AddData(text, DiffState::Normal, i, EOL::CRLF, HideState::Shown, -1);
+	ASSERT_EQ(lines, data.GetCount());
+
+	// one viewdata object per line was the storage layout used before
+	const size_t perLineObjects = sizeof(viewdata) * lines;
+	const size_t columnar = data.GetMemoryUsage();
+	EXPECT_LE(columnar, sizeof(CString) * lines + 3 * sizeof(int) * lines);
+	EXPECT_LT(columnar, perLineObjects);
+	// all lines must still share the same text buffer
+	EXPECT_EQ(static_cast<LPCWSTR>(text), static_cast<LPCWSTR>(data.GetLine(lines - 1)));
+}